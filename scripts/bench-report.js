@@ -0,0 +1,199 @@
+#!/usr/bin/env node
+
+/**
+ * Benchmark Report Script
+ * Collects the latest Criterion (Rust) and UI (ui/bench/run.js) benchmark results into
+ * bench/results/<version>.json and compares them with the previous release.
+ *
+ * Usage:
+ *   mise run bench                          # Run both suites, then this script
+ *   node scripts/bench-report.js            # Collect results for the current version
+ *   node scripts/bench-report.js 0.2.0      # Compare against bench/results/0.2.0.json
+ */
+
+const fs = require('fs');
+const path = require('path');
+const { execSync } = require('child_process');
+
+// ANSI color codes
+const colors = {
+  reset: '\x1b[0m',
+  bright: '\x1b[1m',
+  red: '\x1b[31m',
+  green: '\x1b[32m',
+  yellow: '\x1b[33m',
+  cyan: '\x1b[36m',
+};
+
+// File paths (relative to project root)
+const PROJECT_ROOT = path.resolve(__dirname, '..');
+const CARGO_TOML = path.join(PROJECT_ROOT, 'src-tauri', 'Cargo.toml');
+const CRITERION_DIR = path.join(PROJECT_ROOT, 'src-tauri', 'target', 'criterion');
+const UI_RESULTS = path.join(PROJECT_ROOT, 'ui', 'bench-results.json');
+const RESULTS_DIR = path.join(PROJECT_ROOT, 'bench', 'results');
+
+// Changes smaller than this are reported as unchanged
+const NOISE_PERCENT = 5;
+
+function getVersion() {
+  const content = fs.readFileSync(CARGO_TOML, 'utf8');
+  const match = content.match(/^version\s*=\s*"([^"]+)"/m);
+  return match ? match[1] : 'unknown';
+}
+
+function getCommit() {
+  try {
+    return execSync('git rev-parse --short HEAD', { cwd: PROJECT_ROOT }).toString().trim();
+  } catch {
+    return null;
+  }
+}
+
+/**
+ * Find every Criterion benchmark (directories with new/benchmark.json)
+ */
+function findCriterionBenchmarks(dir, found = []) {
+  if (!fs.existsSync(dir)) return found;
+  for (const entry of fs.readdirSync(dir, { withFileTypes: true })) {
+    if (!entry.isDirectory() || entry.name === 'report') continue;
+    const full = path.join(dir, entry.name);
+    if (entry.name === 'new' && fs.existsSync(path.join(full, 'benchmark.json'))) {
+      found.push(full);
+    } else {
+      findCriterionBenchmarks(full, found);
+    }
+  }
+  return found;
+}
+
+/**
+ * Rust results: mean/median time per benchmark, in nanoseconds
+ */
+function readCriterionResults() {
+  const results = {};
+  for (const dir of findCriterionBenchmarks(CRITERION_DIR)) {
+    const benchmark = JSON.parse(fs.readFileSync(path.join(dir, 'benchmark.json'), 'utf8'));
+    const estimates = JSON.parse(fs.readFileSync(path.join(dir, 'estimates.json'), 'utf8'));
+    const throughput = benchmark.throughput && benchmark.throughput.Bytes;
+    results[benchmark.full_id] = {
+      meanNs: estimates.mean.point_estimate,
+      medianNs: estimates.median.point_estimate,
+      ...(throughput ? { bytes: throughput } : {}),
+    };
+  }
+  return results;
+}
+
+/**
+ * UI results (ui/bench-results.json): mean/median time per benchmark, in nanoseconds
+ */
+function readUiResults() {
+  const results = {};
+  if (!fs.existsSync(UI_RESULTS)) return results;
+  const json = JSON.parse(fs.readFileSync(UI_RESULTS, 'utf8'));
+  for (const file of json.files || []) {
+    for (const group of file.groups || []) {
+      for (const benchmark of group.benchmarks || []) {
+        results[`${group.fullName} > ${benchmark.name}`] = {
+          meanNs: benchmark.mean * 1e6,
+          medianNs: benchmark.median * 1e6,
+          rme: benchmark.rme,
+          samples: benchmark.sampleCount,
+        };
+      }
+    }
+  }
+  return results;
+}
+
+function formatTime(ns) {
+  if (ns >= 1e9) return `${(ns / 1e9).toFixed(2)} s`;
+  if (ns >= 1e6) return `${(ns / 1e6).toFixed(2)} ms`;
+  if (ns >= 1e3) return `${(ns / 1e3).toFixed(2)} µs`;
+  return `${ns.toFixed(0)} ns`;
+}
+
+/**
+ * Most recent results file other than this version's (by semver)
+ */
+function findPreviousResults(version) {
+  if (!fs.existsSync(RESULTS_DIR)) return null;
+  const semver = (v) => v.split('.').map((n) => parseInt(n, 10) || 0);
+  const older = fs
+    .readdirSync(RESULTS_DIR)
+    .filter((name) => name.endsWith('.json'))
+    .map((name) => name.slice(0, -'.json'.length))
+    .filter((v) => v !== version)
+    .sort((a, b) => {
+      const [x, y] = [semver(a), semver(b)];
+      for (let i = 0; i < 3; i++) if (x[i] !== y[i]) return x[i] - y[i];
+      return 0;
+    });
+  return older.length > 0 ? older[older.length - 1] : null;
+}
+
+/**
+ * Print each benchmark's mean, and its change from the baseline if any
+ */
+function displayResults(title, current, baseline) {
+  const ids = Object.keys(current).sort();
+  if (ids.length === 0) return;
+  console.log(`\n${colors.bright}${title}${colors.reset}`);
+  const width = Math.max(...ids.map((id) => id.length));
+  for (const id of ids) {
+    const mean = current[id].meanNs;
+    let change = '';
+    const before = baseline && baseline[id];
+    if (before) {
+      const percent = ((mean - before.meanNs) / before.meanNs) * 100;
+      const color = percent > NOISE_PERCENT ? colors.red : percent < -NOISE_PERCENT ? colors.green : colors.reset;
+      change = `${color}${percent >= 0 ? '+' : ''}${percent.toFixed(1)}%${colors.reset}`;
+    }
+    console.log(`  ${id.padEnd(width)}  ${formatTime(mean).padStart(10)}  ${change}`);
+  }
+}
+
+/**
+ * Main function
+ */
+function main() {
+  const args = process.argv.slice(2);
+  const version = getVersion();
+
+  const results = {
+    version,
+    commit: getCommit(),
+    date: new Date().toISOString(),
+    rust: readCriterionResults(),
+    ui: readUiResults(),
+  };
+  if (Object.keys(results.rust).length === 0 && Object.keys(results.ui).length === 0) {
+    console.error(`${colors.red}Error: No benchmark results found${colors.reset}`);
+    console.error('Run `cargo bench` in src-tauri and `npm run bench` in ui first.');
+    process.exit(1);
+  }
+
+  fs.mkdirSync(RESULTS_DIR, { recursive: true });
+  const outFile = path.join(RESULTS_DIR, `${version}.json`);
+  fs.writeFileSync(outFile, JSON.stringify(results, null, 2) + '\n', 'utf8');
+
+  const baselineVersion = args[0] || findPreviousResults(version);
+  let baseline = null;
+  if (baselineVersion) {
+    const baselineFile = path.join(RESULTS_DIR, `${baselineVersion}.json`);
+    if (fs.existsSync(baselineFile)) {
+      baseline = JSON.parse(fs.readFileSync(baselineFile, 'utf8'));
+    } else {
+      console.error(`${colors.yellow}Warning: No results for ${baselineVersion}${colors.reset}`);
+    }
+  }
+
+  if (baseline) {
+    console.log(`\n${colors.bright}Compared with ${colors.cyan}${baseline.version}${colors.reset}`);
+  }
+  displayResults('Backend (Criterion)', results.rust, baseline && baseline.rust);
+  displayResults('UI', results.ui, baseline && baseline.ui);
+  console.log(`\n${colors.green}✓ Results written to ${path.relative(PROJECT_ROOT, outFile)}${colors.reset}\n`);
+}
+
+main();
@@ -0,0 +1,36 @@
+#!/usr/bin/env node
+
+/**
+ * Date Fixture Check
+ * Checks spec/fixtures/js-dates.json against the JS engine's Date.parse,
+ * which the frontend parser uses. The Rust backend's parse_js_date is
+ * checked against the same fixtures by `cargo test`, so both sides read
+ * log timestamps the same way.
+ *
+ * Usage:
+ *   node scripts/check-js-dates.js
+ *   TZ=Asia/Kolkata node scripts/check-js-dates.js   # Local-time cases in another zone
+ */
+
+const fs = require('fs');
+const path = require('path');
+
+const FIXTURES = path.resolve(__dirname, '..', 'spec', 'fixtures', 'js-dates.json');
+
+const { cases } = JSON.parse(fs.readFileSync(FIXTURES, 'utf8'));
+
+// Expected values without Z are local time, as Date.parse reads them
+const failures = cases.filter(({ input, expected }) => {
+  const actual = Date.parse(input);
+  const wanted = expected === null ? NaN : Date.parse(expected);
+  return !Object.is(actual, wanted);
+});
+
+for (const { input, expected } of failures) {
+  const actual = Date.parse(input);
+  console.error(
+    `${JSON.stringify(input)}: expected ${expected}, Date.parse gave ${isNaN(actual) ? null : new Date(actual).toISOString()}`,
+  );
+}
+console.log(`${cases.length - failures.length}/${cases.length} date fixtures match Date.parse`);
+process.exit(failures.length > 0 ? 1 : 0);
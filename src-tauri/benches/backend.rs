@@ -0,0 +1,114 @@
+//! Backend benchmarks over synthetic logs
+//!
+//!   cargo bench --bench backend
+//!   MOCHA_BENCH_SIZES=10MB,100MB,1GB MOCHA_BENCH_FORMATS=salesbox-core,json-structured cargo bench --bench backend
+//!
+//! - parse_log_file: the parser over a 2 MB tail of each format (what an
+//!   initial read hands it)
+//! - read_file, parse_file, search_file_for_line: the commands over whole
+//!   files of each size. parse_file is measured reopening a file (served
+//!   from the parse cache, redirected to target/bench-data/home);
+//!   search_file_for_line looks for a line in the middle of the file.
+//!
+//! Generated files are kept in target/bench-data. Results are in
+//! target/criterion; `node scripts/bench-report.js` collects them for a
+//! release.
+
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use std::env;
+use std::hint::black_box;
+use std::path::PathBuf;
+use std::thread;
+use std::time::Duration;
+
+use app_lib::bench::{parse_file, parse_log_file, read_file, search_line};
+
+mod synthetic;
+
+// Bytes of each format the parser benchmark parses (MAX_READ_SIZE in commands.rs)
+const TAIL_BYTES: u64 = 2 * 1024 * 1024;
+
+fn data_dir() -> PathBuf {
+    env::var_os("CARGO_TARGET_DIR")
+        .map(PathBuf::from)
+        .unwrap_or_else(|| PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("target"))
+        .join("bench-data")
+}
+
+/// Formats to run (MOCHA_BENCH_FORMATS, comma-separated; default all)
+fn formats() -> Vec<&'static str> {
+    match env::var("MOCHA_BENCH_FORMATS") {
+        Ok(list) => synthetic::FORMATS
+            .iter()
+            .copied()
+            .filter(|f| list.split(',').any(|name| name.trim() == *f))
+            .collect(),
+        Err(_) => synthetic::FORMATS.to_vec(),
+    }
+}
+
+/// File sizes to run (MOCHA_BENCH_SIZES, e.g. "10MB,100MB,1GB"; default 10MB)
+fn sizes() -> Vec<u64> {
+    env::var("MOCHA_BENCH_SIZES")
+        .unwrap_or_else(|_| "10MB".to_string())
+        .split(',')
+        .map(|s| synthetic::parse_size(s).unwrap_or_else(|| panic!("Invalid MOCHA_BENCH_SIZES entry: {s}")))
+        .collect()
+}
+
+fn bench_parser(c: &mut Criterion) {
+    let mut group = c.benchmark_group("parse_log_file");
+    for format in formats() {
+        let content = synthetic::generate(format, TAIL_BYTES);
+        let path = format!("/bench/{format}.log");
+        group.throughput(Throughput::Bytes(content.len() as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(format), &content, |b, content| {
+            b.iter(|| parse_log_file(black_box(content), "bench.log", Some(&path)))
+        });
+    }
+    group.finish();
+}
+
+fn bench_commands(c: &mut Criterion) {
+    let dir = data_dir();
+    // Keep the parse cache out of ~/.mocha
+    env::set_var("HOME", dir.join("home"));
+
+    let mut files = Vec::new();
+    for size in sizes() {
+        for format in formats() {
+            let path = synthetic::log_file(&dir, format, size).expect("Cannot write benchmark log");
+            let probe = synthetic::middle_line(&path).expect("Cannot read benchmark log");
+            let id = BenchmarkId::new(format, synthetic::size_label(size));
+            files.push((id, size, path.to_string_lossy().into_owned(), probe));
+        }
+    }
+
+    let mut group = c.benchmark_group("read_file");
+    group.sample_size(20);
+    for (id, _, path, _) in &files {
+        group.bench_function(id.clone(), |b| b.iter(|| read_file(black_box(path.clone()), 0)));
+    }
+    group.finish();
+
+    let mut group = c.benchmark_group("parse_file");
+    group.sample_size(20);
+    for (id, _, path, _) in &files {
+        // First read fills the parse cache (written in the background)
+        parse_file(path.clone(), 0);
+        thread::sleep(Duration::from_millis(200));
+        group.bench_function(id.clone(), |b| b.iter(|| parse_file(black_box(path.clone()), 0)));
+    }
+    group.finish();
+
+    let mut group = c.benchmark_group("search_file_for_line");
+    group.sample_size(10);
+    for (id, size, path, probe) in &files {
+        group.throughput(Throughput::Bytes(*size));
+        group.bench_function(id.clone(), |b| b.iter(|| search_line(black_box(path), black_box(probe), 3)));
+    }
+    group.finish();
+}
+
+criterion_group!(benches, bench_parser, bench_commands);
+criterion_main!(benches);
@@ -0,0 +1,210 @@
+//! Synthetic logs for the benchmarks
+//!
+//! One line template per parser pattern, filled from a seeded PRNG so every
+//! run (and every machine) benchmarks the same bytes. Keep in sync with
+//! ui/bench/synthetic.ts: both generators produce identical files.
+
+use chrono::DateTime;
+use std::fs::{self, File};
+use std::io::{self, BufWriter, Read, Seek, SeekFrom, Write};
+use std::path::{Path, PathBuf};
+
+// Bump when the templates change, so cached files are regenerated
+const GENERATOR_VERSION: u32 = 1;
+const SEED: u32 = 0x6d6f6368; // "moch"
+const BASE_MS: i64 = 1_767_225_600_000; // 2026-01-01T00:00:00Z
+
+/// Formats, by parser pattern name
+pub const FORMATS: &[&str] = &[
+    "salesbox-core",
+    "salesbox-app",
+    "iwf-spring",
+    "logback-with-source",
+    "logback-internal",
+    "maven",
+    "logback",
+    "bracketed",
+    "python-logging",
+    "logback-with-thread",
+    "simple",
+    "logback-time-only",
+    "level-only",
+    "genie-rust",
+    "json-structured",
+    "iso-timestamp",
+];
+
+const THREADS: &[&str] = &[
+    "main",
+    "http-nio-3004-exec-5",
+    "scheduled-executor-thread-2",
+    "default-nioEventLoopGroup-1-5",
+];
+
+const STACK_TRACE: &[&str] = &[
+    "\tat com.example.core.LeadService.process(LeadService.java:211)",
+    "\tat com.example.core.Worker.run(Worker.java:57)",
+    "\tat java.base/java.lang.Thread.run(Thread.java:1583)",
+];
+
+/// mulberry32
+struct Rng(u32);
+
+impl Rng {
+    fn next(&mut self) -> u32 {
+        self.0 = self.0.wrapping_add(0x6d2b79f5);
+        let mut t = self.0;
+        t = (t ^ (t >> 15)).wrapping_mul(t | 1);
+        t ^= t.wrapping_add((t ^ (t >> 7)).wrapping_mul(t | 61));
+        t ^ (t >> 14)
+    }
+}
+
+fn level(r: u32) -> &'static str {
+    match r % 100 {
+        0..=1 => "ERROR",
+        2..=7 => "WARN",
+        8..=29 => "DEBUG",
+        _ => "INFO",
+    }
+}
+
+fn message(i: u64, kind: u32, r: u32) -> String {
+    match kind % 6 {
+        0 => format!("Processing request id={} user=u{}", i, r % 1000),
+        1 => format!("api call (no params) to https://api.example.com/users/{}?line={}", r % 5000, i),
+        2 => format!("Completed batch {} in {}ms", i, r % 900),
+        3 => format!("Cache miss for key session:{:08x} line {}", r, i),
+        4 => format!("GET response: api call /leads {{id: {}}} response: {{status: ok, line: {}}}", r % 100, i),
+        _ => format!("Sending message {} to queue events-{}", i, r % 8),
+    }
+}
+
+/// Line `i` of a format, followed by its continuation lines (a stack trace
+/// after errors, except for JSON logs)
+fn entry(format: &str, i: u64, rng: &mut Rng) -> String {
+    let (r_level, r_thread, r_kind, r_value) = (rng.next(), rng.next(), rng.next(), rng.next());
+    let level = level(r_level);
+    let thread = THREADS[(r_thread % THREADS.len() as u32) as usize];
+    let msg = message(i, r_kind, r_value);
+
+    let ms = BASE_MS + i as i64 * 7 + (r_value % 5) as i64;
+    let iso = DateTime::from_timestamp_millis(ms)
+        .expect("timestamps are in range")
+        .format("%Y-%m-%dT%H:%M:%S%.3fZ")
+        .to_string();
+    let (date, time, frac) = (&iso[0..10], &iso[11..19], &iso[20..23]);
+
+    let line = match format {
+        "salesbox-core" => format!(
+            "{iso} {date} {time}.{frac} [{thread}] {level} c.s.c.c.bizlogic.MCPController [MCPController.java:466] [default] - {msg}"
+        ),
+        "salesbox-app" => format!("{date} {time},{frac} {i} [{thread}] {level} com.r2.util.SQSUtil - {msg}"),
+        "iwf-spring" => format!("[{thread}] {level} i.i.w.u.StateWaitForLeads [StateWaitForLeads.java:133] [default] - {msg}"),
+        "logback-with-source" => format!(
+            "{date} {time}.{frac} [{thread}] {level} c.s.p.LeadService [LeadService.java:88] [default] - {msg}"
+        ),
+        "logback-internal" => format!("{time},{frac} |-{level} in ch.qos.logback.core.joran.action.AppenderAction - {msg}"),
+        "maven" => format!("[{}] {msg}", if level == "WARN" { "WARNING" } else { level }),
+        "logback" => format!("{date} {time},{frac} {level} [c.r.u.d.RedashApiUtil:37] {msg}"),
+        "bracketed" => format!("{date} {time}.{frac} [{level}] {msg}"),
+        "python-logging" => format!("{date} {time},{frac} - db.py - {level} - {msg}"),
+        "logback-with-thread" => format!(
+            "{date} {time}.{frac} [{thread}] {level:<5} c.s.c.s.ActivityProcessingScheduler - {msg}"
+        ),
+        "simple" => format!("{date} {time}.{frac} {level} {msg}"),
+        "logback-time-only" => format!("{time}.{frac} [{thread}] {level} c.s.platform.util.CryptKeyUtil - {msg}"),
+        "level-only" => format!("{level} {msg}"),
+        "genie-rust" => format!("[{date}][{time}][app_lib::core::setup][{level}] {msg}"),
+        "json-structured" => {
+            let level = level.to_lowercase();
+            return format!(r#"{{"label":"core","level":"{level}","message":"{msg}","timestamp":"{iso}"}}"#) + "\n";
+        }
+        _ => format!("{iso} {msg}"),
+    };
+
+    let mut out = line + "\n";
+    if level == "ERROR" {
+        out.push_str(&format!("java.lang.IllegalStateException: request {} failed\n", i));
+        for frame in STACK_TRACE {
+            out.push_str(frame);
+            out.push('\n');
+        }
+    }
+    out
+}
+
+/// Write at least `bytes` of a format (whole entries)
+pub fn write_log(format: &str, bytes: u64, out: &mut impl Write) -> io::Result<()> {
+    let mut rng = Rng(SEED);
+    let mut written = 0u64;
+    let mut i = 0u64;
+    while written < bytes {
+        let entry = entry(format, i, &mut rng);
+        out.write_all(entry.as_bytes())?;
+        written += entry.len() as u64;
+        i += 1;
+    }
+    Ok(())
+}
+
+/// At least `bytes` of a format, in memory
+pub fn generate(format: &str, bytes: u64) -> String {
+    let mut out = Vec::with_capacity(bytes as usize + 1024);
+    write_log(format, bytes, &mut out).expect("writing to memory");
+    String::from_utf8(out).expect("templates are UTF-8")
+}
+
+/// Path of a generated log file, written on first use
+pub fn log_file(dir: &Path, format: &str, bytes: u64) -> io::Result<PathBuf> {
+    let path = dir.join(format!("v{GENERATOR_VERSION}-{format}-{}.log", size_label(bytes)));
+    if path.exists() {
+        return Ok(path);
+    }
+    fs::create_dir_all(dir)?;
+    let tmp = path.with_extension("tmp");
+    let mut out = BufWriter::with_capacity(1 << 20, File::create(&tmp)?);
+    write_log(format, bytes, &mut out)?;
+    out.into_inner().map_err(|e| e.into_error())?.sync_all()?;
+    fs::rename(&tmp, &path)?;
+    Ok(path)
+}
+
+/// First log line (not a continuation) starting after the middle of a file;
+/// what a "jump to source" search looks for
+pub fn middle_line(path: &Path) -> io::Result<String> {
+    let mut file = File::open(path)?;
+    let size = file.metadata()?.len();
+    file.seek(SeekFrom::Start(size / 2))?;
+    let mut buf = vec![0u8; 64 * 1024];
+    let n = file.read(&mut buf)?;
+    let text = String::from_utf8_lossy(&buf[..n]);
+    text.split('\n')
+        .skip(1) // Partial line
+        .find(|line| !line.is_empty() && !line.starts_with('\t') && !line.starts_with("java."))
+        .map(str::to_string)
+        .ok_or_else(|| io::Error::new(io::ErrorKind::InvalidData, "no log line near the middle"))
+}
+
+/// Parse "10MB", "1GB", "512KB" (binary units)
+pub fn parse_size(size: &str) -> Option<u64> {
+    let size = size.trim().to_uppercase();
+    let (digits, unit) = size.split_at(size.find(|c: char| !c.is_ascii_digit()).unwrap_or(size.len()));
+    let n: u64 = digits.parse().ok()?;
+    match unit {
+        "" | "B" => Some(n),
+        "KB" => Some(n << 10),
+        "MB" => Some(n << 20),
+        "GB" => Some(n << 30),
+        _ => None,
+    }
+}
+
+pub fn size_label(bytes: u64) -> String {
+    match bytes {
+        b if b >= 1 << 30 && b % (1 << 30) == 0 => format!("{}GB", b >> 30),
+        b if b >= 1 << 20 && b % (1 << 20) == 0 => format!("{}MB", b >> 20),
+        b if b >= 1 << 10 && b % (1 << 10) == 0 => format!("{}KB", b >> 10),
+        b => format!("{b}B"),
+    }
+}
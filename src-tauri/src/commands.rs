@@ -1,12 +1,21 @@
 use serde::{Deserialize, Serialize};
-use std::fs::{self, File, OpenOptions};
+use std::fs::{self, OpenOptions};
 use std::io::{Read, Seek, SeekFrom, Write};
 use std::path::PathBuf;
+use std::time::Instant;
 use chrono::Utc;
+use rayon::prelude::*;
+
+use crate::compressed::{is_compressed, LogFile};
+use crate::index::read_tail;
+use crate::parse_cache::{self, CachedTail};
+use crate::parser::{parse_log_file, pattern_stats, LogEntry, PatternStats};
+use crate::tail;
 
 // Read at most 2MB from end of file - enough for ~10K+ lines
 // Frontend only displays last 2000 lines anyway
 const MAX_READ_SIZE: u64 = 2 * 1024 * 1024;
+const MAX_LINES: u64 = 2000;
 const MAX_RECENT: usize = 20;
 
 /// Response for readFile command
@@ -27,6 +36,9 @@ pub struct FileResult {
     pub mtime: Option<i64>,
     #[serde(skip_serializing_if = "Option::is_none")]
     pub truncated: Option<bool>,
+    // Content continues from a rotated/rewritten file (tail_file only)
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub rotated: Option<bool>,
     #[serde(skip_serializing_if = "Option::is_none")]
     pub error: Option<String>,
 }
@@ -60,42 +72,28 @@ fn get_filename(path: &str) -> String {
         .to_string()
 }
 
-/// Read file with optional offset for differential/polling reads
-#[tauri::command]
-pub fn read_file(path: String, offset: u64) -> FileResult {
+/// Bytes read by read_file / tail_file, before any string conversion
+struct FileRead {
+    content: Vec<u8>,
+    content_start: usize, // Skipped prefix (partial first line of tail reads)
+    size: u64,
+    mtime: Option<i64>,
+    truncated: bool,
+}
+
+/// Read file with optional offset for differential/polling reads.
+/// Large files are read from the tail (at most MAX_READ_SIZE) on the initial read.
+fn read_file_content(path: &str, offset: u64) -> Result<FileRead, &'static str> {
     if path.is_empty() {
-        return FileResult {
-            success: false,
-            content: None,
-            path: None,
-            name: None,
-            size: None,
-            prev_size: None,
-            mtime: None,
-            truncated: None,
-            error: Some("No path provided".to_string()),
-        };
+        return Err("No path provided");
     }
 
-    // Get file metadata
-    let metadata = match fs::metadata(&path) {
-        Ok(m) => m,
-        Err(_) => {
-            return FileResult {
-                success: false,
-                content: None,
-                path: None,
-                name: None,
-                size: None,
-                prev_size: None,
-                mtime: None,
-                truncated: None,
-                error: Some("Cannot open file".to_string()),
-            };
-        }
-    };
+    // Get file metadata (compressed files are read decompressed, so their
+    // size and offsets are those of the decompressed content)
+    let metadata = fs::metadata(path).map_err(|_| "Cannot open file")?;
+    let mut file = LogFile::open(path).map_err(|_| "Cannot open file")?;
 
-    let current_size = metadata.len();
+    let current_size = file.len().map_err(|_| "Cannot open file")?;
     let mtime = metadata.modified()
         .ok()
         .and_then(|t| t.duration_since(std::time::UNIX_EPOCH).ok())
@@ -103,17 +101,13 @@ pub fn read_file(path: String, offset: u64) -> FileResult {
 
     // If file size unchanged since last read, return empty (no new content)
     if offset > 0 && current_size == offset {
-        return FileResult {
-            success: true,
-            content: Some(String::new()),
-            path: Some(path.clone()),
-            name: Some(get_filename(&path)),
-            size: Some(current_size),
-            prev_size: Some(offset),
+        return Ok(FileRead {
+            content: Vec::new(),
+            content_start: 0,
+            size: current_size,
             mtime,
-            truncated: Some(false),
-            error: None,
-        };
+            truncated: false,
+        });
     }
 
     // If file shrunk since last read, it was truncated/replaced - read from start
@@ -137,79 +131,275 @@ pub fn read_file(path: String, offset: u64) -> FileResult {
         is_tail_read = true;
     }
 
-    // Open and read file
-    let mut file = match File::open(&path) {
-        Ok(f) => f,
-        Err(_) => {
-            return FileResult {
-                success: false,
-                content: None,
-                path: None,
-                name: None,
-                size: None,
-                prev_size: None,
-                mtime: None,
-                truncated: None,
-                error: Some("Cannot open file".to_string()),
-            };
-        }
-    };
-
     // Seek to read position
-    if actual_read_start > 0 {
-        if file.seek(SeekFrom::Start(actual_read_start)).is_err() {
-            return FileResult {
-                success: false,
-                content: None,
-                path: None,
-                name: None,
-                size: None,
-                prev_size: None,
-                mtime: None,
-                truncated: None,
-                error: Some("Cannot seek in file".to_string()),
-            };
-        }
+    if actual_read_start > 0 && file.seek(SeekFrom::Start(actual_read_start)).is_err() {
+        return Err("Cannot seek in file");
     }
 
-    // Read content
-    let mut content = vec![0u8; read_size as usize];
-    if file.read_exact(&mut content).is_err() {
-        // Try reading what we can
-        let mut file = File::open(&path).unwrap();
-        file.seek(SeekFrom::Start(actual_read_start)).unwrap();
+    // Read content (the file may have changed size since the metadata call)
+    let mut content = Vec::with_capacity(read_size as usize);
+    if (&mut file).take(read_size).read_to_end(&mut content).is_err() {
         content.clear();
-        file.read_to_end(&mut content).ok();
     }
 
     // For tail reads, skip partial first line (we may have started mid-line)
-    let content_str = if is_tail_read {
-        let s = String::from_utf8_lossy(&content);
-        // Find first newline and skip everything before it
-        if let Some(pos) = s.find('\n') {
-            s[pos + 1..].to_string()
-        } else {
-            s.to_string()
-        }
+    let content_start = if is_tail_read {
+        memchr::memchr(b'\n', &content).map_or(0, |pos| pos + 1)
     } else {
-        String::from_utf8_lossy(&content).to_string()
+        0
     };
 
+    Ok(FileRead {
+        content,
+        content_start,
+        size: current_size,
+        mtime,
+        truncated: is_truncated || is_tail_read,
+    })
+}
+
+/// Convert read bytes to a String without copying when they are valid UTF-8
+fn content_to_string(mut content: Vec<u8>, start: usize) -> String {
+    content.drain(..start);
+    match String::from_utf8(content) {
+        Ok(s) => s,
+        Err(e) => String::from_utf8_lossy(e.as_bytes()).into_owned(),
+    }
+}
+
+fn file_result_error(error: &str) -> FileResult {
     FileResult {
+        success: false,
+        content: None,
+        path: None,
+        name: None,
+        size: None,
+        prev_size: None,
+        mtime: None,
+        truncated: None,
+        rotated: None,
+        error: Some(error.to_string()),
+    }
+}
+
+/// Read file with optional offset for differential/polling reads
+#[tauri::command]
+pub fn read_file(path: String, offset: u64) -> FileResult {
+    match read_file_content(&path, offset) {
+        Ok(read) => FileResult {
+            success: true,
+            content: Some(content_to_string(read.content, read.content_start)),
+            path: Some(path.clone()),
+            name: Some(get_filename(&path)),
+            size: Some(read.size),
+            prev_size: Some(offset),
+            mtime: read.mtime,
+            truncated: Some(read.truncated),
+            rotated: None,
+            error: None,
+        },
+        Err(error) => file_result_error(error),
+    }
+}
+
+/// Differential read for tailing (watcher flushes and polls): like read_file,
+/// but follows the file across rotation and truncation instead of
+/// re-reading it as truncated (see tail.rs)
+pub fn tail_file(path: String, offset: u64) -> FileResult {
+    // Initial reads take the tail; compressed (rotated) files don't change
+    if offset == 0 || path.is_empty() || is_compressed(&path) {
+        let result = read_file(path, offset);
+        if let (true, Some(path), Some(size)) = (result.success, &result.path, result.size) {
+            tail::track(path, size);
+        }
+        return result;
+    }
+
+    match tail::read_appended(&path, offset) {
+        Ok(read) => FileResult {
+            success: true,
+            content: Some(content_to_string(read.content, 0)),
+            path: Some(path.clone()),
+            name: Some(get_filename(&path)),
+            size: Some(read.size),
+            prev_size: Some(offset),
+            mtime: read.mtime,
+            truncated: Some(false),
+            rotated: Some(read.rotated),
+            error: None,
+        },
+        Err(_) => file_result_error("Cannot open file"),
+    }
+}
+
+/// Response for parseFile command (readFile metadata + parsed entries)
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct ParseFileResult {
+    pub success: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub logs: Option<Vec<LogEntry>>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub total_lines: Option<usize>,
+    // File line number of the first parsed line (initial reads only)
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub start_line: Option<u64>,
+    // Total lines in the file (initial reads only)
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub file_lines: Option<u64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub path: Option<String>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub name: Option<String>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub size: Option<u64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub prev_size: Option<u64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub mtime: Option<i64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub truncated: Option<bool>,
+    // Differential reads: content continues from a rotated/rewritten file
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub rotated: Option<bool>,
+    // Time spent reading and parsing (the rest of a round trip is IPC)
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub backend_ms: Option<f64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub error: Option<String>,
+}
+
+/// Read file (same offset semantics as read_file) and parse it into log entries.
+/// Initial reads (offset 0) take the tail through the line-offset index, so the
+/// result also says which file line the entries start at.
+/// Runs off the main thread so large tails don't block the UI.
+#[tauri::command(async)]
+pub fn parse_file(path: String, offset: u64) -> ParseFileResult {
+    let start = Instant::now();
+    let mut result = if offset == 0 && !path.is_empty() {
+        parse_file_tail(path)
+    } else {
+        parse_file_from(path, offset)
+    };
+    result.backend_ms = Some(start.elapsed().as_secs_f64() * 1000.0);
+    result
+}
+
+/// Differential read: parse what was appended past `offset`
+fn parse_file_from(path: String, offset: u64) -> ParseFileResult {
+    let result = tail_file(path, offset);
+    if !result.success {
+        return parse_file_error(result.error);
+    }
+
+    let name = result.name.unwrap_or_default();
+    let parsed = parse_log_file(
+        result.content.as_deref().unwrap_or(""),
+        &name,
+        result.path.as_deref(),
+    );
+
+    ParseFileResult {
         success: true,
-        content: Some(content_str),
-        path: Some(path.clone()),
-        name: Some(get_filename(&path)),
-        size: Some(current_size),
-        prev_size: Some(offset),
+        logs: Some(parsed.logs),
+        total_lines: Some(parsed.total_lines),
+        start_line: None,
+        file_lines: None,
+        path: result.path,
+        name: Some(name),
+        size: result.size,
+        prev_size: result.prev_size,
+        mtime: result.mtime,
+        truncated: result.truncated,
+        rotated: result.rotated,
+        backend_ms: None,
+        error: None,
+    }
+}
+
+/// Initial read: parse the last lines of the file (same window as the old
+/// MAX_READ_SIZE tail read). Served from the parse cache when the file is
+/// unchanged or only grew since it was last opened.
+fn parse_file_tail(path: String) -> ParseFileResult {
+    let metadata = fs::metadata(&path).ok();
+    let mtime = metadata.as_ref()
+        .and_then(|m| m.modified().ok())
+        .and_then(|t| t.duration_since(std::time::UNIX_EPOCH).ok())
+        .map(|d| d.as_millis() as i64);
+    let name = get_filename(&path);
+
+    let cached = metadata.as_ref().and_then(|m| parse_cache::load(&path, &name, m, MAX_LINES, MAX_READ_SIZE));
+    let tail = match cached {
+        Some(tail) => tail,
+        None => {
+            let (content, start_line, file_lines, size) = match read_tail(&path, MAX_LINES, MAX_READ_SIZE) {
+                Ok(tail) => tail,
+                Err(_) => return parse_file_error(Some("Cannot open file".to_string())),
+            };
+            let parsed = parse_log_file(&String::from_utf8_lossy(&content), &name, Some(&path));
+            let tail = CachedTail {
+                logs: parsed.logs,
+                start_line,
+                file_lines,
+                total_lines: parsed.total_lines,
+                size,
+            };
+            if let Some(m) = &metadata {
+                parse_cache::store(&path, m, &tail);
+            }
+            tail
+        }
+    };
+
+    tail::track(&path, tail.size);
+
+    ParseFileResult {
+        success: true,
+        logs: Some(tail.logs),
+        total_lines: Some(tail.total_lines),
+        start_line: Some(tail.start_line),
+        file_lines: Some(tail.file_lines),
+        path: Some(path),
+        name: Some(name),
+        size: Some(tail.size),
+        prev_size: Some(0),
         mtime,
-        truncated: Some(is_truncated || is_tail_read),
+        truncated: Some(tail.start_line > 0),
+        rotated: None,
+        backend_ms: None,
         error: None,
     }
 }
 
-/// Get list of recently opened files
+fn parse_file_error(error: Option<String>) -> ParseFileResult {
+    ParseFileResult {
+        success: false,
+        logs: None,
+        total_lines: None,
+        start_line: None,
+        file_lines: None,
+        path: None,
+        name: None,
+        size: None,
+        prev_size: None,
+        mtime: None,
+        truncated: None,
+        rotated: None,
+        backend_ms: None,
+        error,
+    }
+}
+
+/// Per-pattern hit/miss counters of the log parser (shows which formats cost the most)
 #[tauri::command]
+pub fn get_parser_stats() -> Vec<PatternStats> {
+    pattern_stats()
+}
+
+/// Get list of recently opened files.
+/// Runs off the main thread; files are stat'ed in parallel (slow or
+/// unreachable mounts don't hold up the others).
+#[tauri::command(async)]
 pub fn get_recent_files() -> Vec<RecentFile> {
     let path = match get_recent_file_path() {
         Some(p) => p,
@@ -231,7 +421,7 @@ pub fn get_recent_files() -> Vec<RecentFile> {
     };
 
     // Refresh mtime, size, and exists from filesystem for each file
-    files.into_iter().map(|mut f| {
+    files.into_par_iter().map(|mut f| {
         if let Ok(metadata) = fs::metadata(&f.path) {
             f.exists = true;
             f.size = Some(metadata.len());
@@ -405,81 +595,3 @@ pub fn export_file(path: String, content: String) -> bool {
 
     fs::write(&path, content.as_bytes()).is_ok()
 }
-
-/// Result for search_file_for_line command
-#[derive(Serialize)]
-#[serde(rename_all = "camelCase")]
-pub struct SearchLineResult {
-    pub success: bool,
-    #[serde(skip_serializing_if = "Option::is_none")]
-    pub content: Option<String>,
-    #[serde(skip_serializing_if = "Option::is_none")]
-    pub line_number: Option<usize>,
-    #[serde(skip_serializing_if = "Option::is_none")]
-    pub total_lines: Option<usize>,
-    #[serde(skip_serializing_if = "Option::is_none")]
-    pub error: Option<String>,
-}
-
-/// Search for a specific line in a file and return surrounding context
-/// Used for "jump to source" when the log is outside the truncated view
-#[tauri::command]
-pub fn search_file_for_line(path: String, search_line: String, context_lines: usize) -> SearchLineResult {
-    if path.is_empty() || search_line.is_empty() {
-        return SearchLineResult {
-            success: false,
-            content: None,
-            line_number: None,
-            total_lines: None,
-            error: Some("Invalid parameters".to_string()),
-        };
-    }
-
-    // Read the entire file
-    let content = match fs::read_to_string(&path) {
-        Ok(c) => c,
-        Err(_) => {
-            return SearchLineResult {
-                success: false,
-                content: None,
-                line_number: None,
-                total_lines: None,
-                error: Some("Cannot read file".to_string()),
-            };
-        }
-    };
-
-    let lines: Vec<&str> = content.lines().collect();
-    let total_lines = lines.len();
-
-    // Search for the exact line
-    let found_index = lines.iter().position(|&line| line == search_line);
-
-    match found_index {
-        Some(idx) => {
-            // Calculate context window
-            let start = if idx > context_lines { idx - context_lines } else { 0 };
-            let end = std::cmp::min(idx + context_lines + 1, total_lines);
-
-            // Extract lines with context
-            let context_content: String = lines[start..end].join("\n");
-
-            SearchLineResult {
-                success: true,
-                content: Some(context_content),
-                line_number: Some(idx + 1), // 1-indexed
-                total_lines: Some(total_lines),
-                error: None,
-            }
-        }
-        None => {
-            SearchLineResult {
-                success: false,
-                content: None,
-                line_number: None,
-                total_lines: Some(total_lines),
-                error: Some("Line not found in file".to_string()),
-            }
-        }
-    }
-}
@@ -0,0 +1,509 @@
+//! Transparent decompression of rotated logs (.gz / .zst)
+//!
+//! A compressed file is read as its decompressed content: sizes, offsets
+//! and line numbers all refer to the decompressed bytes. The first open
+//! decodes the file once, streaming, and records a seek point about every
+//! SEEK_SPAN bytes of output - gzip deflate block boundaries (bit position
+//! plus the 32 KiB window, as in zlib's zran example) and zstd frame starts.
+//! Later reads (tails, pages, context around a search hit) restart the
+//! decoder at the nearest seek point instead of the start of the file.
+//! Nothing is written to disk.
+//!
+//! A single-frame .zst file has only the one seek point at its start;
+//! multi-frame files (e.g. written by `pzstd` or `zstd --seekable`) get one
+//! per frame.
+
+use memmap2::Mmap;
+use miniz_oxide::inflate::core::inflate_flags::TINFL_FLAG_STOP_ON_BLOCK_BOUNDARY;
+use miniz_oxide::inflate::core::{decompress, BlockBoundaryState, DecompressorOxide, TINFL_LZ_DICT_SIZE};
+use miniz_oxide::inflate::TINFLStatus;
+use std::collections::HashMap;
+use std::fs::{File, Metadata};
+use std::io::{self, Read, Seek, SeekFrom};
+use std::path::Path;
+use std::sync::{Arc, Mutex, OnceLock};
+use std::time::SystemTime;
+use zstd::stream::raw::{Decoder as ZstdRaw, InBuffer, Operation, OutBuffer};
+
+// Decoded bytes between seek points (a gzip seek point holds a 32 KiB window)
+const SEEK_SPAN: u64 = 4 * 1024 * 1024;
+// Decoded bytes per zstd read
+const ZSTD_CHUNK_SIZE: usize = 256 * 1024;
+
+const GZIP_MAGIC: [u8; 2] = [0x1f, 0x8b];
+const ZSTD_MAGIC: [u8; 4] = [0x28, 0xb5, 0x2f, 0xfd];
+
+#[derive(Clone, Copy, PartialEq)]
+enum Codec {
+    Gzip,
+    Zstd,
+}
+
+/// Codec of a file named like a rotated compressed log, checked by its magic bytes
+fn detect(path: &str, file: &mut File) -> io::Result<Option<Codec>> {
+    let extension = Path::new(path)
+        .extension()
+        .and_then(|e| e.to_str())
+        .map(|e| e.to_ascii_lowercase());
+    let codec = match extension.as_deref() {
+        Some("gz") => Codec::Gzip,
+        Some("zst") | Some("zstd") => Codec::Zstd,
+        _ => return Ok(None),
+    };
+
+    let mut magic = [0u8; 4];
+    let n = file.read(&mut magic)?;
+    file.rewind()?;
+    let matches = match codec {
+        Codec::Gzip => n >= 2 && magic[..2] == GZIP_MAGIC,
+        Codec::Zstd => n >= 4 && magic == ZSTD_MAGIC,
+    };
+    Ok(matches.then_some(codec))
+}
+
+/// Is `path` a compressed log (read decompressed by LogFile)?
+pub fn is_compressed(path: &str) -> bool {
+    File::open(path)
+        .and_then(|mut file| detect(path, &mut file))
+        .map_or(false, |codec| codec.is_some())
+}
+
+// ============================================================================
+// Decoders
+// ============================================================================
+
+/// Where decoding can restart
+#[derive(Clone)]
+struct SeekPoint {
+    input: usize, // Compressed offset
+    output: u64,  // Decompressed offset
+    // Inside a gzip member (None: at a gzip member or zstd frame start)
+    inflate: Option<InflateResume>,
+}
+
+#[derive(Clone)]
+struct InflateResume {
+    boundary: BlockBoundaryState,
+    window: Box<[u8]>,
+    window_pos: usize,
+}
+
+fn invalid(message: &str) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidData, message.to_string())
+}
+
+/// Length of the gzip member header at the start of `data` (RFC 1952)
+fn gzip_header_len(data: &[u8]) -> io::Result<usize> {
+    const FHCRC: u8 = 0x02;
+    const FEXTRA: u8 = 0x04;
+    const FNAME: u8 = 0x08;
+    const FCOMMENT: u8 = 0x10;
+
+    if data.len() < 10 || data[..2] != GZIP_MAGIC || data[2] != 8 {
+        return Err(invalid("Not a gzip member"));
+    }
+    let flags = data[3];
+    let mut len = 10;
+    if flags & FEXTRA != 0 {
+        let extra = data.get(len..len + 2).ok_or_else(|| invalid("Truncated gzip header"))?;
+        len += 2 + u16::from_le_bytes([extra[0], extra[1]]) as usize;
+    }
+    for field in [FNAME, FCOMMENT] {
+        if flags & field != 0 {
+            let rest = data.get(len..).ok_or_else(|| invalid("Truncated gzip header"))?;
+            len += memchr::memchr(0, rest).ok_or_else(|| invalid("Truncated gzip header"))? + 1;
+        }
+    }
+    if flags & FHCRC != 0 {
+        len += 2;
+    }
+    if len > data.len() {
+        return Err(invalid("Truncated gzip header"));
+    }
+    Ok(len)
+}
+
+/// Multi-member gzip decoder over the whole compressed file
+struct GzipDecoder {
+    inflate: Box<DecompressorOxide>,
+    window: Box<[u8]>, // Wrapping output buffer (the 32 KiB back-reference window)
+    window_pos: usize,
+    input: usize,
+    in_member: bool,
+    at_boundary: bool, // Stopped at a deflate block boundary
+}
+
+impl GzipDecoder {
+    fn at(point: &SeekPoint) -> Self {
+        match &point.inflate {
+            Some(resume) => GzipDecoder {
+                inflate: Box::new(DecompressorOxide::from_block_boundary_state(&resume.boundary)),
+                window: resume.window.clone(),
+                window_pos: resume.window_pos,
+                input: point.input,
+                in_member: true,
+                at_boundary: true,
+            },
+            None => GzipDecoder {
+                inflate: Box::default(),
+                window: vec![0u8; TINFL_LZ_DICT_SIZE].into_boxed_slice(),
+                window_pos: 0,
+                input: point.input,
+                in_member: false,
+                at_boundary: false,
+            },
+        }
+    }
+
+    /// Decode the next piece into `out` (left empty at the end of the file)
+    fn next_chunk(&mut self, data: &[u8], out: &mut Vec<u8>) -> io::Result<()> {
+        out.clear();
+        self.at_boundary = false;
+        loop {
+            if !self.in_member {
+                if self.input >= data.len() {
+                    return Ok(());
+                }
+                match gzip_header_len(&data[self.input..]) {
+                    Ok(len) => self.input += len,
+                    // Padding or garbage after the last member ends the file (like gzip -d)
+                    Err(_) if self.input > 0 => {
+                        self.input = data.len();
+                        return Ok(());
+                    }
+                    Err(e) => return Err(e),
+                }
+                self.inflate.init();
+                self.in_member = true;
+            }
+
+            let (status, consumed, produced) = decompress(
+                &mut self.inflate,
+                &data[self.input..],
+                &mut self.window,
+                self.window_pos,
+                TINFL_FLAG_STOP_ON_BLOCK_BOUNDARY,
+            );
+            out.extend_from_slice(&self.window[self.window_pos..self.window_pos + produced]);
+            self.input += consumed;
+            self.window_pos = (self.window_pos + produced) & (TINFL_LZ_DICT_SIZE - 1);
+
+            match status {
+                TINFLStatus::Done => {
+                    self.input += 8; // CRC32 and ISIZE trailer
+                    self.in_member = false;
+                }
+                TINFLStatus::BlockBoundary if !out.is_empty() => {
+                    self.at_boundary = true;
+                    return Ok(());
+                }
+                TINFLStatus::BlockBoundary => {}
+                TINFLStatus::HasMoreOutput => return Ok(()),
+                TINFLStatus::NeedsMoreInput | TINFLStatus::FailedCannotMakeProgress => {
+                    return Err(io::Error::new(io::ErrorKind::UnexpectedEof, "Truncated gzip file"));
+                }
+                _ => return Err(invalid("Corrupt gzip data")),
+            }
+            if !out.is_empty() {
+                return Ok(());
+            }
+        }
+    }
+
+    fn seek_point(&self, output: u64) -> Option<SeekPoint> {
+        if !self.in_member {
+            return Some(SeekPoint { input: self.input, output, inflate: None });
+        }
+        if !self.at_boundary {
+            return None;
+        }
+        Some(SeekPoint {
+            input: self.input,
+            output,
+            inflate: Some(InflateResume {
+                boundary: self.inflate.block_boundary_state()?,
+                window: self.window.clone(),
+                window_pos: self.window_pos,
+            }),
+        })
+    }
+}
+
+/// Zstd decoder over the whole compressed file (frames are decoded in turn)
+struct ZstdDecoder {
+    raw: ZstdRaw<'static>,
+    input: usize,
+    in_frame: bool,
+}
+
+impl ZstdDecoder {
+    fn at(point: &SeekPoint) -> io::Result<Self> {
+        let mut raw = ZstdRaw::new()?;
+        // Accept files written with --long (windows up to 2 GiB)
+        raw.set_parameter(zstd::zstd_safe::DParameter::WindowLogMax(31))?;
+        Ok(ZstdDecoder { raw, input: point.input, in_frame: false })
+    }
+
+    fn next_chunk(&mut self, data: &[u8], out: &mut Vec<u8>) -> io::Result<()> {
+        out.clear();
+        out.reserve(ZSTD_CHUNK_SIZE);
+        while self.input < data.len() || self.in_frame {
+            let mut input = InBuffer::around(&data[self.input..]);
+            let mut output = OutBuffer::around(&mut *out);
+            let hint = self.raw.run(&mut input, &mut output)?;
+            let progress = input.pos() > 0 || output.pos() > 0;
+            self.input += input.pos();
+            self.in_frame = hint != 0;
+
+            if !out.is_empty() {
+                return Ok(()); // At a frame end this is also a seek point
+            }
+            if !progress {
+                return Err(io::Error::new(io::ErrorKind::UnexpectedEof, "Truncated zstd file"));
+            }
+        }
+        Ok(())
+    }
+
+    fn seek_point(&self, output: u64) -> Option<SeekPoint> {
+        (!self.in_frame).then_some(SeekPoint { input: self.input, output, inflate: None })
+    }
+}
+
+enum Decoder {
+    Gzip(GzipDecoder),
+    Zstd(ZstdDecoder),
+}
+
+impl Decoder {
+    fn at(codec: Codec, point: &SeekPoint) -> io::Result<Self> {
+        Ok(match codec {
+            Codec::Gzip => Decoder::Gzip(GzipDecoder::at(point)),
+            Codec::Zstd => Decoder::Zstd(ZstdDecoder::at(point)?),
+        })
+    }
+
+    fn next_chunk(&mut self, data: &[u8], out: &mut Vec<u8>) -> io::Result<()> {
+        match self {
+            Decoder::Gzip(d) => d.next_chunk(data, out),
+            Decoder::Zstd(d) => d.next_chunk(data, out),
+        }
+    }
+
+    fn seek_point(&self, output: u64) -> Option<SeekPoint> {
+        match self {
+            Decoder::Gzip(d) => d.seek_point(output),
+            Decoder::Zstd(d) => d.seek_point(output),
+        }
+    }
+}
+
+// ============================================================================
+// Seek tables
+// ============================================================================
+
+/// Seek points and decoded size of one compressed file version
+struct SeekTable {
+    codec: Codec,
+    points: Vec<SeekPoint>, // By output offset; the first is the file start
+    size: u64,              // Decompressed size
+    source_len: u64,
+    source_mtime: Option<SystemTime>,
+}
+
+impl SeekTable {
+    fn matches(&self, metadata: &Metadata) -> bool {
+        self.source_len == metadata.len() && self.source_mtime == metadata.modified().ok()
+    }
+
+    /// Last seek point at or before decompressed offset `pos`
+    fn point_before(&self, pos: u64) -> &SeekPoint {
+        let i = self.points.partition_point(|p| p.output <= pos);
+        &self.points[i.saturating_sub(1)]
+    }
+}
+
+/// Seek tables of opened compressed files (keyed by path as given by the frontend)
+fn tables() -> &'static Mutex<HashMap<String, Arc<SeekTable>>> {
+    static TABLES: OnceLock<Mutex<HashMap<String, Arc<SeekTable>>>> = OnceLock::new();
+    TABLES.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+/// Drop the seek table of `path` (the file was closed)
+pub fn forget(path: &str) {
+    tables().lock().unwrap().remove(path);
+}
+
+/// Decode the whole file once, taking seek points and passing each decoded
+/// piece to `on_decoded`
+fn scan(
+    codec: Codec,
+    data: &[u8],
+    metadata: &Metadata,
+    mut on_decoded: impl FnMut(&[u8]),
+) -> io::Result<SeekTable> {
+    let start = SeekPoint { input: 0, output: 0, inflate: None };
+    let mut decoder = Decoder::at(codec, &start)?;
+    let mut points = vec![start];
+    let mut chunk = Vec::new();
+    let mut size = 0u64;
+
+    loop {
+        decoder.next_chunk(data, &mut chunk)?;
+        if chunk.is_empty() {
+            break;
+        }
+        on_decoded(&chunk);
+        size += chunk.len() as u64;
+        if size - points[points.len() - 1].output >= SEEK_SPAN {
+            points.extend(decoder.seek_point(size));
+        }
+    }
+
+    Ok(SeekTable {
+        codec,
+        points,
+        size,
+        source_len: metadata.len(),
+        source_mtime: metadata.modified().ok(),
+    })
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+/// Decompressed view of a compressed file, readable and seekable like a File
+pub struct CompressedFile {
+    map: Mmap,
+    table: Arc<SeekTable>,
+    pos: u64,
+    decoder: Option<Decoder>,
+    chunk: Vec<u8>,   // Last decoded piece
+    chunk_start: u64, // Its decompressed offset (the decoder is at its end)
+}
+
+impl CompressedFile {
+    fn chunk_end(&self) -> u64 {
+        self.chunk_start + self.chunk.len() as u64
+    }
+}
+
+impl Read for CompressedFile {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        if buf.is_empty() || self.pos >= self.table.size {
+            return Ok(0);
+        }
+        loop {
+            if self.pos >= self.chunk_start && self.pos < self.chunk_end() {
+                let from = (self.pos - self.chunk_start) as usize;
+                let n = buf.len().min(self.chunk.len() - from);
+                buf[..n].copy_from_slice(&self.chunk[from..from + n]);
+                self.pos += n as u64;
+                return Ok(n);
+            }
+
+            // Restart at a seek point when going back, or when one is closer
+            // than decoding forward from here
+            let point = self.table.point_before(self.pos);
+            if self.decoder.is_none() || self.pos < self.chunk_start || point.output > self.chunk_end() {
+                self.decoder = Some(Decoder::at(self.table.codec, point)?);
+                self.chunk.clear();
+                self.chunk_start = point.output;
+            }
+
+            self.chunk_start = self.chunk_end();
+            if let Some(decoder) = &mut self.decoder {
+                decoder.next_chunk(&self.map, &mut self.chunk)?;
+            }
+            if self.chunk.is_empty() {
+                return Ok(0); // The file ended early (changed since it was scanned)
+            }
+        }
+    }
+}
+
+impl Seek for CompressedFile {
+    fn seek(&mut self, pos: SeekFrom) -> io::Result<u64> {
+        let target = match pos {
+            SeekFrom::Start(offset) => Some(offset),
+            SeekFrom::End(delta) => self.table.size.checked_add_signed(delta),
+            SeekFrom::Current(delta) => self.pos.checked_add_signed(delta),
+        };
+        self.pos = target.ok_or_else(|| {
+            io::Error::new(io::ErrorKind::InvalidInput, "Seek before the start of the file")
+        })?;
+        Ok(self.pos)
+    }
+}
+
+/// A log file opened for reading: plain, or decompressed on the fly
+pub enum LogFile {
+    Plain(File),
+    Compressed(CompressedFile),
+}
+
+impl LogFile {
+    pub fn open(path: &str) -> io::Result<LogFile> {
+        Self::open_scanning(path, |_| {})
+    }
+
+    /// Open `path`; if it is compressed and was not opened before (or changed
+    /// since), it is decoded once here and each decoded piece is passed to
+    /// `on_decoded` (used to build the line index in the same pass)
+    pub fn open_scanning(path: &str, on_decoded: impl FnMut(&[u8])) -> io::Result<LogFile> {
+        let mut file = File::open(path)?;
+        let Some(codec) = detect(path, &mut file)? else {
+            return Ok(LogFile::Plain(file));
+        };
+        let metadata = file.metadata()?;
+        // Safety: read-only mapping of a rotated (no longer written) file;
+        // a change is detected through its size/mtime and rescanned
+        let map = unsafe { Mmap::map(&file) }?;
+
+        let cached = tables().lock().unwrap().get(path).cloned();
+        let table = match cached {
+            Some(table) if table.matches(&metadata) => table,
+            _ => {
+                let table = Arc::new(scan(codec, &map, &metadata, on_decoded)?);
+                tables().lock().unwrap().insert(path.to_string(), table.clone());
+                table
+            }
+        };
+
+        Ok(LogFile::Compressed(CompressedFile {
+            map,
+            table,
+            pos: 0,
+            decoder: None,
+            chunk: Vec::new(),
+            chunk_start: 0,
+        }))
+    }
+
+    /// Size in bytes (decompressed size for compressed files)
+    pub fn len(&self) -> io::Result<u64> {
+        match self {
+            LogFile::Plain(file) => Ok(file.metadata()?.len()),
+            LogFile::Compressed(file) => Ok(file.table.size),
+        }
+    }
+}
+
+impl Read for LogFile {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        match self {
+            LogFile::Plain(file) => file.read(buf),
+            LogFile::Compressed(file) => file.read(buf),
+        }
+    }
+}
+
+impl Seek for LogFile {
+    fn seek(&mut self, pos: SeekFrom) -> io::Result<u64> {
+        match self {
+            LogFile::Plain(file) => file.seek(pos),
+            LogFile::Compressed(file) => file.seek(pos),
+        }
+    }
+}
@@ -0,0 +1,48 @@
+//! Diagnostics trace export
+//!
+//! The frontend's timing spans (ui/src/diagnostics.ts) are written to the
+//! app log through tauri_plugin_log, one Chrome trace event per line under
+//! the `mocha::trace` target, next to the backend's own log lines. Strip
+//! the line prefixes and wrap the events in `[...]` to load them in
+//! chrome://tracing or Perfetto.
+
+use serde::Serialize;
+use serde_json::Value;
+use tauri::{AppHandle, Manager};
+
+const TRACE_TARGET: &str = "mocha::trace";
+
+/// Result for export_trace command
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct ExportTraceResult {
+    pub success: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub events: Option<usize>,
+    // Directory of the log file the trace was written to
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub log_dir: Option<String>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub error: Option<String>,
+}
+
+/// Write trace events to the app log
+#[tauri::command]
+pub fn export_trace(app: AppHandle, events: Vec<Value>) -> ExportTraceResult {
+    log::info!(target: TRACE_TARGET, "trace begin ({} events)", events.len());
+    for event in &events {
+        log::info!(target: TRACE_TARGET, "{}", event);
+    }
+    log::info!(target: TRACE_TARGET, "trace end");
+
+    ExportTraceResult {
+        success: true,
+        events: Some(events.len()),
+        log_dir: app
+            .path()
+            .app_log_dir()
+            .ok()
+            .map(|dir| dir.to_string_lossy().into_owned()),
+        error: None,
+    }
+}
@@ -0,0 +1,620 @@
+//! Line-offset index for seekable access to large files
+//!
+//! Stores the byte offset of every CHECKPOINT_STRIDE-th line, so any line can
+//! be reached by seeking to the nearest checkpoint and scanning at most
+//! CHECKPOINT_STRIDE lines. The index is built once per file and extended
+//! incrementally as the file grows. It is rebuilt if the file shrinks or is
+//! no longer the one indexed (another inode, or different first bytes), and
+//! dropped when the file is closed (see watcher.rs). Compressed
+//! files are indexed over their decompressed content (see compressed.rs).
+//! Newlines are found with memchr (see lines.rs), so scans run at close to
+//! memory bandwidth; the first scan of a large file is split across the
+//! load pool (pool.rs).
+//!
+//! Each checkpoint also keeps the time of the first dated line after it, a
+//! sparse time index that `read_time_range` binary-searches to load the
+//! lines of a time range without parsing the file.
+
+use memmap2::Mmap;
+use rayon::prelude::*;
+use serde::{Deserialize, Serialize};
+use std::collections::HashMap;
+use std::fs::File;
+use std::io::{self, Read, Seek, SeekFrom};
+use std::sync::{Arc, Mutex, OnceLock};
+
+use crate::compressed::{is_compressed, LogFile};
+use crate::lines;
+use crate::parse_cache::{fnv1a, inode};
+use crate::parser::{line_epoch, parse_log_file, LogEntry};
+use crate::pool;
+
+// Lines between stored offsets (~8 bytes of index per 1024 lines)
+const CHECKPOINT_STRIDE: u64 = 1024;
+const SCAN_CHUNK_SIZE: usize = 1024 * 1024;
+// Unindexed bytes from which a plain file is indexed on the load pool
+const PARALLEL_INDEX_MIN_BYTES: u64 = 32 * 1024 * 1024;
+const MIN_PARALLEL_CHUNK_SIZE: usize = 4 * 1024 * 1024;
+// Lines after a checkpoint searched for the timestamp of the time index
+const TIME_SAMPLE_LINES: usize = 8;
+// Bytes read to sample a checkpoint from the file (longer lines go undated)
+const TIME_SAMPLE_BYTES: u64 = 64 * 1024;
+// Bytes at the start of a file that identify it (same as tail.rs)
+const HEAD_BYTES: u64 = 1024;
+// Same cap as the parser - larger pages would be cut by parse_log_file
+const MAX_PAGE_LINES: u64 = 2000;
+
+/// Sparse line-offset index of one file
+#[derive(Serialize, Deserialize, Clone)]
+#[serde(rename_all = "camelCase")]
+pub struct LineIndex {
+    checkpoints: Vec<u64>, // Byte offset of line k * CHECKPOINT_STRIDE
+    times: Vec<Option<i64>>, // Epoch (ms) of the first dated line at checkpoint k
+    newlines: u64,         // Newlines in [0, indexed_size)
+    indexed_size: u64,     // Bytes scanned so far
+    identity: (u64, u64),  // Inode and fingerprint of the first bytes (see file_identity)
+    #[serde(default)]
+    unsampled: Vec<usize>, // Checkpoints whose sample lines run past the indexed bytes
+}
+
+impl LineIndex {
+    fn new() -> Self {
+        LineIndex {
+            checkpoints: vec![0],
+            times: Vec::new(),
+            newlines: 0,
+            indexed_size: 0,
+            identity: (0, 0),
+            unsampled: Vec::new(),
+        }
+    }
+
+    /// Whether `file` is the file indexed so far
+    pub fn is_of(&self, file: &mut LogFile) -> io::Result<bool> {
+        if self.indexed_size == 0 {
+            return Ok(true);
+        }
+        if file.len()? < self.indexed_size {
+            return Ok(false);
+        }
+        Ok(file_identity(file, self.indexed_size)? == self.identity)
+    }
+
+    /// Number of lines (same as `content.split("\n").length`)
+    pub fn total_lines(&self) -> u64 {
+        self.newlines + 1
+    }
+
+    /// File size covered by the index
+    pub fn size(&self) -> u64 {
+        self.indexed_size
+    }
+
+    /// Extend the index to the current file size (rebuilds if the file
+    /// shrank or another file is now at the path)
+    pub fn update(&mut self, file: &mut LogFile) -> io::Result<()> {
+        if !self.is_of(file)? {
+            *self = LineIndex::new();
+        }
+        let size = file.len()?;
+        if size > self.indexed_size {
+            // The fingerprint covers HEAD_BYTES once the file is that large
+            let identified = self.indexed_size >= HEAD_BYTES;
+            self.extend_to(file, size)?;
+            if !identified {
+                self.identity = file_identity(file, self.indexed_size)?;
+            }
+        }
+        self.sample_times(file)
+    }
+
+    /// Index the bytes between the indexed size and `size`
+    fn extend_to(&mut self, file: &mut LogFile, size: u64) -> io::Result<()> {
+        // Large plain files are scanned in parallel over a mapping
+        if let LogFile::Plain(plain) = &*file {
+            if size - self.indexed_size >= PARALLEL_INDEX_MIN_BYTES && pool::load_threads() > 1 {
+                // Safety: the mapping is read-only (see map_file in search.rs)
+                let map = unsafe { Mmap::map(plain) }?;
+                let end = (size as usize).min(map.len());
+                self.extend_parallel(map.get(self.indexed_size as usize..end).unwrap_or(&[]));
+                return Ok(());
+            }
+        }
+
+        file.seek(SeekFrom::Start(self.indexed_size))?;
+        let mut reader = file.take(size - self.indexed_size);
+        let mut buf = vec![0u8; SCAN_CHUNK_SIZE];
+
+        loop {
+            let n = reader.read(&mut buf)?;
+            if n == 0 {
+                break;
+            }
+            self.extend(&buf[..n]);
+        }
+        Ok(())
+    }
+
+    /// Sample the checkpoints whose lines ran past the scanned chunk from the
+    /// file. Those still short (the last lines of the file) are sampled again
+    /// on the next update, once the file has grown.
+    fn sample_times(&mut self, file: &mut LogFile) -> io::Result<()> {
+        for k in std::mem::take(&mut self.unsampled) {
+            let start = self.checkpoints[k];
+            let end = (start + TIME_SAMPLE_BYTES).min(self.indexed_size);
+            let mut lines = Vec::with_capacity((end - start) as usize);
+            file.seek(SeekFrom::Start(start))?;
+            file.take(end - start).read_to_end(&mut lines)?;
+            self.times[k] = match sample_time(&lines) {
+                Ok(time) => time,
+                Err(()) if end < self.indexed_size => None, // Lines too long to sample
+                Err(()) => {
+                    self.unsampled.push(k);
+                    None
+                }
+            };
+        }
+        Ok(())
+    }
+
+    /// Index `chunk`, the bytes that follow the indexed part
+    fn extend(&mut self, chunk: &[u8]) {
+        self.newlines = scan_checkpoints(
+            chunk,
+            self.indexed_size,
+            self.newlines,
+            &mut self.checkpoints,
+            &mut self.times,
+            &mut self.unsampled,
+        );
+        self.indexed_size += chunk.len() as u64;
+    }
+
+    /// Index `data`, the bytes that follow the indexed part, on the load
+    /// pool: newlines are counted per chunk, then each chunk collects its
+    /// checkpoints knowing the line it starts at, and the chunks' checkpoints
+    /// are appended in file order
+    fn extend_parallel(&mut self, data: &[u8]) {
+        let chunk_size = (data.len() / (pool::load_threads() * 4)).max(MIN_PARALLEL_CHUNK_SIZE);
+        let chunks = lines::line_chunks(data, chunk_size);
+        let (pos, newlines) = (self.indexed_size, self.newlines);
+
+        type Found = (Vec<u64>, Vec<Option<i64>>, Vec<usize>);
+        let (found, total): (Vec<Found>, u64) = pool::load_pool().install(|| {
+            let counts: Vec<u64> = chunks
+                .par_iter()
+                .map(|&(start, end)| lines::count_newlines(&data[start..end]) as u64)
+                .collect();
+            let first_newlines: Vec<u64> = counts
+                .iter()
+                .scan(newlines, |seen, &n| {
+                    let first = *seen;
+                    *seen += n;
+                    Some(first)
+                })
+                .collect();
+
+            let found = chunks
+                .par_iter()
+                .zip(first_newlines.par_iter())
+                .map(|(&(start, end), &seen)| {
+                    let (mut checkpoints, mut times, mut unsampled) = (Vec::new(), Vec::new(), Vec::new());
+                    let chunk = &data[start..end];
+                    scan_checkpoints(chunk, pos + start as u64, seen, &mut checkpoints, &mut times, &mut unsampled);
+                    (checkpoints, times, unsampled)
+                })
+                .collect();
+            (found, counts.iter().sum())
+        });
+
+        for (checkpoints, times, unsampled) in found {
+            let first = self.times.len();
+            self.checkpoints.extend(checkpoints);
+            self.times.extend(times);
+            self.unsampled.extend(unsampled.iter().map(|k| first + k));
+        }
+        self.newlines += total;
+        self.indexed_size += data.len() as u64;
+    }
+
+    /// Byte offset where `line` starts (clamped to the last line)
+    pub fn line_offset(&self, file: &mut LogFile, line: u64) -> io::Result<u64> {
+        let line = line.min(self.newlines);
+        let checkpoint = (line / CHECKPOINT_STRIDE) as usize;
+        let start = self.checkpoints[checkpoint];
+        let mut remaining = line % CHECKPOINT_STRIDE;
+        if remaining == 0 {
+            return Ok(start);
+        }
+
+        // Scan forward from the checkpoint
+        file.seek(SeekFrom::Start(start))?;
+        let mut reader = file.take(self.indexed_size - start);
+        let mut buf = vec![0u8; SCAN_CHUNK_SIZE];
+        let mut pos = start;
+        loop {
+            let n = reader.read(&mut buf)?;
+            if n == 0 {
+                return Ok(self.indexed_size);
+            }
+            match lines::nth_newline(&buf[..n], remaining as usize - 1) {
+                Ok(i) => return Ok(pos + i as u64 + 1),
+                Err(count) => remaining -= count as u64,
+            }
+            pos += n as u64;
+        }
+    }
+
+    /// Line containing byte `offset` (clamped to the indexed size)
+    pub fn line_at_offset(&self, file: &mut LogFile, offset: u64) -> io::Result<u64> {
+        let offset = offset.min(self.indexed_size);
+        let checkpoint = self.checkpoints.partition_point(|&o| o <= offset) - 1;
+        let start = self.checkpoints[checkpoint];
+
+        file.seek(SeekFrom::Start(start))?;
+        let mut reader = file.take(offset - start);
+        let mut buf = vec![0u8; SCAN_CHUNK_SIZE];
+        let mut line = checkpoint as u64 * CHECKPOINT_STRIDE;
+        loop {
+            let n = reader.read(&mut buf)?;
+            if n == 0 {
+                return Ok(line);
+            }
+            line += lines::count_newlines(&buf[..n]) as u64;
+        }
+    }
+
+    /// Read lines [start, end) as raw bytes (without the final newline)
+    pub fn read_range(&self, file: &mut LogFile, start: u64, end: u64) -> io::Result<Vec<u8>> {
+        if start >= end {
+            return Ok(Vec::new());
+        }
+        let start_offset = self.line_offset(file, start)?;
+        let end_offset = if end >= self.total_lines() {
+            self.indexed_size
+        } else {
+            // Stop before the newline that ends line end-1
+            self.line_offset(file, end)?.saturating_sub(1)
+        };
+
+        let mut content = Vec::with_capacity(end_offset.saturating_sub(start_offset) as usize);
+        file.seek(SeekFrom::Start(start_offset))?;
+        file.take(end_offset.saturating_sub(start_offset)).read_to_end(&mut content)?;
+        Ok(content)
+    }
+
+    /// Lines [start, end) timestamped in [from, to] (epoch millis), or None
+    /// if no checkpoint found a dated line. Timestamps are assumed to grow
+    /// through the file.
+    pub fn time_range(&self, file: &mut LogFile, from: i64, to: i64) -> io::Result<Option<(u64, u64)>> {
+        let times: Vec<(u64, i64)> = self
+            .times
+            .iter()
+            .enumerate()
+            .filter_map(|(k, t)| t.map(|t| (k as u64 * CHECKPOINT_STRIDE, t)))
+            .collect();
+        if times.is_empty() {
+            return Ok(None);
+        }
+        let start = self.first_line_where(file, &times, |t| t >= from)?;
+        let end = self.first_line_where(file, &times, |t| t > to)?;
+        Ok(Some((start, end.max(start))))
+    }
+
+    /// First line whose timestamp passes `pred` (false before some time,
+    /// true after): binary search over the checkpoint times, then the lines
+    /// between the two checkpoints around it are parsed
+    fn first_line_where(
+        &self,
+        file: &mut LogFile,
+        times: &[(u64, i64)],
+        pred: impl Fn(i64) -> bool,
+    ) -> io::Result<u64> {
+        let after = times.partition_point(|&(_, t)| !pred(t));
+        let begin = if after == 0 { 0 } else { times[after - 1].0 };
+        let end = times.get(after).map_or(self.total_lines(), |&(line, _)| line);
+
+        let content = self.read_range(file, begin, end)?;
+        let text = String::from_utf8_lossy(&content);
+        let found = lines::with_lines(text.as_bytes(), |spans| {
+            spans
+                .iter()
+                .position(|span| line_epoch(span.of(&text)).is_some_and(&pred))
+        });
+        Ok(found.map_or(end, |i| begin + i as u64))
+    }
+}
+
+/// Inode of `file` and fingerprint of its first `len` bytes (up to
+/// HEAD_BYTES). Compressed files are not checked here: their seek table is
+/// rebuilt when they change, and the index with it (see with_index).
+fn file_identity(file: &mut LogFile, len: u64) -> io::Result<(u64, u64)> {
+    let LogFile::Plain(plain) = file else {
+        return Ok((0, 0));
+    };
+    let mut buf = vec![0u8; len.min(HEAD_BYTES) as usize];
+    plain.seek(SeekFrom::Start(0))?;
+    plain.read_exact(&mut buf)?;
+    Ok((inode(&plain.metadata()?), fnv1a(&buf)))
+}
+
+/// Epoch of the first dated line in `lines` (within TIME_SAMPLE_LINES
+/// whole lines; stack traces and other undated lines are skipped). Err if
+/// `lines` ends before that many undated lines.
+fn sample_time(lines: &[u8]) -> Result<Option<i64>, ()> {
+    let mut start = 0;
+    let mut seen = 0;
+    for end in memchr::memchr_iter(b'\n', lines).take(TIME_SAMPLE_LINES) {
+        if let Some(epoch) = line_epoch(&String::from_utf8_lossy(&lines[start..end])) {
+            return Ok(Some(epoch));
+        }
+        start = end + 1;
+        seen += 1;
+    }
+    if seen < TIME_SAMPLE_LINES {
+        Err(())
+    } else {
+        Ok(None)
+    }
+}
+
+/// Push the time sampled at a checkpoint; a sample cut short by the end of
+/// the chunk is left to LineIndex::sample_times
+fn push_time(lines: &[u8], times: &mut Vec<Option<i64>>, unsampled: &mut Vec<usize>) {
+    let time = sample_time(lines).unwrap_or_else(|()| {
+        unsampled.push(times.len());
+        None
+    });
+    times.push(time);
+}
+
+/// Record the checkpoints in `chunk`, which starts at byte `pos` after
+/// `newlines` newlines, with the time at each (`unsampled` gets the
+/// positions in `times` of those to sample from the file). Returns the
+/// newline count at the end of the chunk.
+fn scan_checkpoints(
+    chunk: &[u8],
+    pos: u64,
+    mut newlines: u64,
+    checkpoints: &mut Vec<u64>,
+    times: &mut Vec<Option<i64>>,
+    unsampled: &mut Vec<usize>,
+) -> u64 {
+    // Line 0 is checkpointed before any byte is read
+    if pos == 0 {
+        push_time(chunk, times, unsampled);
+    }
+    let mut from = 0;
+    loop {
+        // Newlines until the next checkpoint are only counted
+        let until_checkpoint = (CHECKPOINT_STRIDE - newlines % CHECKPOINT_STRIDE) as usize;
+        match lines::nth_newline(&chunk[from..], until_checkpoint - 1) {
+            Ok(i) => {
+                newlines += until_checkpoint as u64;
+                from += i + 1;
+                checkpoints.push(pos + from as u64);
+                push_time(&chunk[from..], times, unsampled);
+            }
+            Err(count) => return newlines + count as u64,
+        }
+    }
+}
+
+/// Indexes of all files accessed by line (keyed by path as given by the frontend)
+fn indexes() -> &'static Mutex<HashMap<String, Arc<Mutex<LineIndex>>>> {
+    static INDEXES: OnceLock<Mutex<HashMap<String, Arc<Mutex<LineIndex>>>>> = OnceLock::new();
+    INDEXES.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+/// Copy of a file's index as last updated (None if it was never indexed)
+pub fn index_snapshot(path: &str) -> Option<LineIndex> {
+    let index = indexes().lock().unwrap().get(path).cloned()?;
+    let snapshot = index.lock().unwrap().clone();
+    Some(snapshot)
+}
+
+/// Whether a file has an index (lookups that would build one can scan instead)
+pub fn has_index(path: &str) -> bool {
+    indexes().lock().unwrap().contains_key(path)
+}
+
+/// Start a file's index from one built earlier (see parse_cache.rs), unless
+/// it already has one. An index of another file than the one now at the
+/// path is dropped (compressed files are checked by their seek table).
+pub fn seed_index(path: &str, index: LineIndex) {
+    if !is_compressed(path) {
+        let same = File::open(path).and_then(|file| index.is_of(&mut LogFile::Plain(file)));
+        if !matches!(same, Ok(true)) {
+            return;
+        }
+    }
+    indexes()
+        .lock()
+        .unwrap()
+        .entry(path.to_string())
+        .or_insert_with(|| Arc::new(Mutex::new(index)));
+}
+
+/// Forget a file's index (closed, or another file is now at the path)
+pub fn reset_index(path: &str) {
+    indexes().lock().unwrap().remove(path);
+}
+
+/// Open `path`, bring its index up to date and run `f` with it
+pub fn with_index<R>(
+    path: &str,
+    f: impl FnOnce(&LineIndex, &mut LogFile) -> io::Result<R>,
+) -> io::Result<R> {
+    let index = indexes()
+        .lock()
+        .unwrap()
+        .entry(path.to_string())
+        .or_insert_with(|| Arc::new(Mutex::new(LineIndex::new())))
+        .clone();
+
+    let mut index = index.lock().unwrap();
+    // A compressed file decoded on open is indexed in the same pass
+    let mut reindexed = false;
+    let mut file = LogFile::open_scanning(path, |chunk| {
+        if !reindexed {
+            *index = LineIndex::new();
+            reindexed = true;
+        }
+        index.extend(chunk);
+    })?;
+    index.update(&mut file)?;
+    f(&index, &mut file)
+}
+
+/// Lines at the end of a file: the last `max_lines` lines, but no more than
+/// `max_bytes` (a partial first line is skipped, like the old tail read).
+/// Returns (content, start_line, total_lines, size).
+pub fn read_tail(path: &str, max_lines: u64, max_bytes: u64) -> io::Result<(Vec<u8>, u64, u64, u64)> {
+    with_index(path, |index, file| {
+        let total = index.total_lines();
+        let mut start = total.saturating_sub(max_lines);
+
+        if index.size() > max_bytes {
+            let byte_start_line = index.line_at_offset(file, index.size() - max_bytes)? + 1;
+            start = start.max(byte_start_line.min(total - 1));
+        }
+
+        let content = index.read_range(file, start, total)?;
+        Ok((content, start, total, index.size()))
+    })
+}
+
+/// Response for parseLines command
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct ParseLinesResult {
+    pub success: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub logs: Option<Vec<LogEntry>>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub start_line: Option<u64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub line_count: Option<u64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub total_lines: Option<u64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub error: Option<String>,
+}
+
+/// Response for readTimeRange command
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct TimeRangeResult {
+    pub success: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub logs: Option<Vec<LogEntry>>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub start_line: Option<u64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub line_count: Option<u64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub total_lines: Option<u64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub truncated: Option<bool>, // The range has more than 2000 lines (the first ones are returned)
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub error: Option<String>,
+}
+
+fn file_name(path: &str) -> String {
+    std::path::Path::new(path)
+        .file_name()
+        .and_then(|n| n.to_str())
+        .unwrap_or(path)
+        .to_string()
+}
+
+/// Read `count` lines starting at line `start` (clamped to the file).
+/// Returns (content, start_line, line_count, total_lines).
+fn read_page(path: &str, start: u64, count: u64) -> io::Result<(String, u64, u64, u64)> {
+    with_index(path, |index, file| {
+        let total = index.total_lines();
+        let start = start.min(total);
+        let end = start.saturating_add(count).min(total);
+        let content = index.read_range(file, start, end)?;
+        Ok((String::from_utf8_lossy(&content).into_owned(), start, end - start, total))
+    })
+}
+
+/// Read and parse lines [start, start + count) of a file (at most 2000 lines).
+/// Used to page through older parts of large files.
+#[tauri::command(async)]
+pub fn parse_lines(path: String, start: u64, count: u64) -> ParseLinesResult {
+    let count = count.min(MAX_PAGE_LINES);
+    match read_page(&path, start, count) {
+        Ok((content, start_line, line_count, total_lines)) => {
+            let parsed = parse_log_file(&content, &file_name(&path), Some(&path));
+            ParseLinesResult {
+                success: true,
+                logs: Some(parsed.logs),
+                start_line: Some(start_line),
+                line_count: Some(line_count),
+                total_lines: Some(total_lines),
+                error: None,
+            }
+        }
+        Err(e) => ParseLinesResult {
+            success: false,
+            logs: None,
+            start_line: None,
+            line_count: None,
+            total_lines: None,
+            error: Some(format!("Cannot read lines: {}", e)),
+        },
+    }
+}
+
+fn time_range_error(error: String) -> TimeRangeResult {
+    TimeRangeResult {
+        success: false,
+        logs: None,
+        start_line: None,
+        line_count: None,
+        total_lines: None,
+        truncated: None,
+        error: Some(error),
+    }
+}
+
+/// Read and parse the lines of a file timestamped in [from, to] (epoch
+/// millis; at most 2000 lines from the start of the range). The range is
+/// found with the time index kept alongside the line index.
+#[tauri::command(async)]
+pub fn read_time_range(path: String, from: i64, to: i64) -> TimeRangeResult {
+    let page = with_index(&path, |index, file| {
+        let total = index.total_lines();
+        let (start, end) = match index.time_range(file, from, to)? {
+            Some(range) => range,
+            None => return Ok(None),
+        };
+        let end_page = end.min(start + MAX_PAGE_LINES);
+        let content = index.read_range(file, start, end_page)?;
+        let content = String::from_utf8_lossy(&content).into_owned();
+        Ok(Some((content, start, end_page - start, total, end > end_page)))
+    });
+
+    match page {
+        Ok(Some((content, start_line, line_count, total_lines, truncated))) => {
+            let logs = if line_count > 0 {
+                parse_log_file(&content, &file_name(&path), Some(&path)).logs
+            } else {
+                Vec::new()
+            };
+            TimeRangeResult {
+                success: true,
+                logs: Some(logs),
+                start_line: Some(start_line),
+                line_count: Some(line_count),
+                total_lines: Some(total_lines),
+                truncated: Some(truncated),
+                error: None,
+            }
+        }
+        Ok(None) => time_range_error("No dated timestamps in file".to_string()),
+        Err(e) => time_range_error(format!("Cannot read lines: {}", e)),
+    }
+}
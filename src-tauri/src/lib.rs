@@ -1,6 +1,32 @@
 mod commands;
+mod compressed;
+mod diagnostics;
+mod index;
+mod lines;
+mod logbooks;
+mod parse_cache;
+mod parser;
+mod pool;
+mod search;
+mod sources;
+mod tail;
+mod watcher;
 
-use commands::{read_file, get_recent_files, add_recent_file, remove_recent_file, clear_recent_files, export_file, search_file_for_line};
+use commands::{read_file, get_recent_files, add_recent_file, remove_recent_file, clear_recent_files, export_file, parse_file, get_parser_stats};
+use diagnostics::export_trace;
+use index::{parse_lines, read_time_range};
+use logbooks::{load_logbooks, load_logbook_entries, write_logbooks};
+use pool::set_load_threads;
+use search::{search_file_for_line, search_file, cancel_search};
+use watcher::{watch_files, unwatch_files, watch_source, unwatch_source, WatcherState};
+
+/// Backend entry points used by the benchmarks (benches/backend.rs)
+#[doc(hidden)]
+pub mod bench {
+    pub use crate::commands::{parse_file, read_file};
+    pub use crate::parser::parse_log_file;
+    pub use crate::search::search_line;
+}
 
 #[cfg_attr(mobile, tauri::mobile_entry_point)]
 pub fn run() {
@@ -9,14 +35,30 @@ pub fn run() {
             .level(log::LevelFilter::Info)
             .build())
         .plugin(tauri_plugin_dialog::init())
+        .manage(WatcherState::default())
         .invoke_handler(tauri::generate_handler![
             read_file,
+            parse_file,
+            get_parser_stats,
+            parse_lines,
+            read_time_range,
+            set_load_threads,
             get_recent_files,
             add_recent_file,
             remove_recent_file,
             clear_recent_files,
             export_file,
-            search_file_for_line
+            export_trace,
+            load_logbooks,
+            load_logbook_entries,
+            write_logbooks,
+            search_file_for_line,
+            search_file,
+            cancel_search,
+            watch_files,
+            unwatch_files,
+            watch_source,
+            unwatch_source
         ])
         .run(tauri::generate_context!())
         .expect("error while running tauri application");
@@ -0,0 +1,117 @@
+//! Line splitting over byte buffers
+//!
+//! Newlines are found with memchr's vectorized search, and lines are kept
+//! as (offset, len) spans into the buffer they were split from instead of
+//! owned strings. Each thread reuses one span arena, so splitting a read
+//! buffer allocates nothing once the arena has grown to its line count.
+
+use std::cell::RefCell;
+use std::ops::Range;
+
+// Arenas grown past this many spans are shrunk back after use
+const MAX_KEPT_SPANS: usize = 64 * 1024;
+
+/// A line as a slice of the buffer it was split from (without the newline)
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct LineSpan {
+    pub offset: usize,
+    pub len: usize,
+}
+
+impl LineSpan {
+    pub fn range(&self) -> Range<usize> {
+        self.offset..self.offset + self.len
+    }
+
+    /// The line in `text`, the string the span was split from (spans end at
+    /// newlines, so they are always on char boundaries)
+    pub fn of<'a>(&self, text: &'a str) -> &'a str {
+        &text[self.range()]
+    }
+}
+
+/// Newlines in `buf`
+pub fn count_newlines(buf: &[u8]) -> usize {
+    memchr::memchr_iter(b'\n', buf).count()
+}
+
+/// Position of the `n`-th newline in `buf` (0 = the first), or the number
+/// of newlines in `buf` when it has no more than `n`
+pub fn nth_newline(buf: &[u8], n: usize) -> Result<usize, usize> {
+    let mut count = 0;
+    for pos in memchr::memchr_iter(b'\n', buf) {
+        if count == n {
+            return Ok(pos);
+        }
+        count += 1;
+    }
+    Err(count)
+}
+
+/// Position of the `n`-th newline from the end of `buf` (0 = the last)
+pub fn nth_newline_back(buf: &[u8], n: usize) -> Option<usize> {
+    memchr::memrchr_iter(b'\n', buf).nth(n)
+}
+
+/// Split data into chunks of about `size` bytes that end after a newline
+pub fn line_chunks(data: &[u8], size: usize) -> Vec<(usize, usize)> {
+    let mut chunks = Vec::new();
+    let mut start = 0;
+    while start < data.len() {
+        let mut end = (start + size).min(data.len());
+        if end < data.len() {
+            end = match memchr::memchr(b'\n', &data[end..]) {
+                Some(p) => end + p + 1,
+                None => data.len(),
+            };
+        }
+        chunks.push((start, end));
+        start = end;
+    }
+    chunks
+}
+
+/// Reusable storage for the spans of split lines
+#[derive(Default)]
+pub struct LineArena {
+    spans: Vec<LineSpan>,
+}
+
+impl LineArena {
+    /// Split `buf` like `split('\n')`: n newlines give n + 1 lines (the
+    /// last one empty when `buf` ends with a newline)
+    pub fn split(&mut self, buf: &[u8]) -> &[LineSpan] {
+        self.spans.clear();
+        let mut start = 0;
+        for newline in memchr::memchr_iter(b'\n', buf) {
+            self.spans.push(LineSpan { offset: start, len: newline - start });
+            start = newline + 1;
+        }
+        self.spans.push(LineSpan { offset: start, len: buf.len() - start });
+        &self.spans
+    }
+
+    fn trim(&mut self) {
+        if self.spans.capacity() > MAX_KEPT_SPANS {
+            self.spans.clear();
+            self.spans.shrink_to(MAX_KEPT_SPANS);
+        }
+    }
+}
+
+thread_local! {
+    static ARENA: RefCell<LineArena> = RefCell::new(LineArena::default());
+}
+
+/// Run `f` over the lines of `buf`, split in this thread's arena
+pub fn with_lines<R>(buf: &[u8], f: impl FnOnce(&[LineSpan]) -> R) -> R {
+    ARENA.with(|arena| match arena.try_borrow_mut() {
+        Ok(mut arena) => {
+            let result = f(arena.split(buf));
+            arena.trim();
+            result
+        }
+        // Called from inside `f`: use a one-off arena
+        Err(_) => f(LineArena::default().split(buf)),
+    })
+}
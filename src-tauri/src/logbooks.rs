@@ -0,0 +1,411 @@
+//! On-disk logbook store under ~/.mocha/logbooks
+//!
+//! `index.json` holds the logbooks' metadata (name, patterns, hash lists) in
+//! display order. Each logbook's entries live in `<id>.jsonl`, an append-only
+//! journal of entry operations (add, remove, reorder, replace), so a change
+//! writes only the entries it touches. Opening a logbook replays its journal;
+//! journals that are mostly dead records are compacted to a single replace.
+//!
+//! Entries are stored as the frontend's JSON (they are opaque here, apart
+//! from their `hash`).
+
+use serde::{Deserialize, Serialize};
+use serde_json::Value;
+use std::collections::{HashMap, HashSet};
+use std::fs::{self, File, OpenOptions};
+use std::io::{self, BufRead, BufReader, Read, Seek, SeekFrom, Write};
+use std::path::{Path, PathBuf};
+use std::sync::{Mutex, OnceLock};
+
+// Compact a journal once it holds this many records...
+const COMPACT_MIN_RECORDS: usize = 64;
+// ...or has written more than this many entries per live one
+const COMPACT_WRITTEN_RATIO: usize = 2;
+
+/// Logbook metadata (everything but the entries)
+#[derive(Serialize, Deserialize, Clone)]
+#[serde(rename_all = "camelCase")]
+pub struct LogbookMeta {
+    pub id: String,
+    pub name: String,
+    pub created_at: i64,
+    #[serde(default)]
+    pub patterns: Vec<Value>,
+    #[serde(default)]
+    pub manually_added_hashes: Vec<String>,
+    #[serde(default)]
+    pub minimized_hashes: Vec<String>,
+}
+
+/// Logbook as listed at startup: metadata and the hashes of its entries,
+/// in order (the entries themselves are loaded on demand)
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct LogbookSummary {
+    #[serde(flatten)]
+    pub meta: LogbookMeta,
+    pub hashes: Vec<String>,
+}
+
+/// One write from the frontend
+#[derive(Deserialize)]
+#[serde(tag = "op", rename_all = "camelCase")]
+pub enum LogbookOp {
+    /// Create or update a logbook's metadata
+    PutMeta { meta: LogbookMeta },
+    /// Delete a logbook and its entries
+    Delete { id: String },
+    /// Append entries
+    Add { id: String, entries: Vec<Value> },
+    /// Remove entries by hash
+    Remove { id: String, hashes: Vec<String> },
+    /// Reorder entries (hashes in their new order)
+    Order { id: String, hashes: Vec<String> },
+    /// Replace all entries
+    Replace { id: String, entries: Vec<Value> },
+}
+
+/// A journal record
+#[derive(Serialize, Deserialize)]
+#[serde(tag = "op", rename_all = "camelCase")]
+enum Record<E> {
+    Add { entries: Vec<E> },
+    Remove { hashes: Vec<String> },
+    Order { hashes: Vec<String> },
+    Replace { entries: Vec<E> },
+}
+
+/// Just the hash of an entry (the rest is skipped when only listing)
+#[derive(Deserialize)]
+struct HashOnly {
+    hash: Option<String>,
+}
+
+trait Hashed {
+    fn hash(&self) -> Option<&str>;
+}
+
+impl Hashed for Value {
+    fn hash(&self) -> Option<&str> {
+        self.get("hash").and_then(|h| h.as_str())
+    }
+}
+
+impl Hashed for HashOnly {
+    fn hash(&self) -> Option<&str> {
+        self.hash.as_deref()
+    }
+}
+
+/// Response for loadLogbooks command
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct LoadLogbooksResult {
+    pub success: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub logbooks: Option<Vec<LogbookSummary>>,
+    // False until the first write (nothing was ever stored on disk)
+    pub initialized: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub error: Option<String>,
+}
+
+/// Response for loadLogbookEntries command
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct LogbookEntriesResult {
+    pub success: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub entries: Option<Vec<Value>>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub error: Option<String>,
+}
+
+/// Response for writeLogbooks command
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct WriteLogbooksResult {
+    pub success: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub error: Option<String>,
+}
+
+/// Serializes access to the store's files (commands run on worker threads)
+fn store_lock() -> &'static Mutex<()> {
+    static LOCK: OnceLock<Mutex<()>> = OnceLock::new();
+    LOCK.get_or_init(|| Mutex::new(()))
+}
+
+/// Get the path to ~/.mocha/logbooks
+fn store_dir() -> io::Result<PathBuf> {
+    dirs::home_dir()
+        .map(|home| home.join(".mocha").join("logbooks"))
+        .ok_or_else(|| io::Error::new(io::ErrorKind::NotFound, "No home directory"))
+}
+
+fn index_path(dir: &Path) -> PathBuf {
+    dir.join("index.json")
+}
+
+/// Journal of a logbook (ids are generated by the frontend - keep only
+/// filename-safe characters)
+fn journal_path(dir: &Path, id: &str) -> PathBuf {
+    let name: String = id
+        .chars()
+        .map(|c| if c.is_ascii_alphanumeric() || c == '-' || c == '_' { c } else { '_' })
+        .collect();
+    dir.join(format!("{}.jsonl", name))
+}
+
+fn read_index(dir: &Path) -> io::Result<Option<Vec<LogbookMeta>>> {
+    let path = index_path(dir);
+    if !path.exists() {
+        return Ok(None);
+    }
+    let content = fs::read_to_string(&path)?;
+    serde_json::from_str(&content)
+        .map(Some)
+        .map_err(|e| io::Error::new(io::ErrorKind::InvalidData, e))
+}
+
+/// Write a file via a temporary file and rename, so a crash never leaves
+/// it half written
+fn write_atomic(path: &Path, content: &[u8]) -> io::Result<()> {
+    let tmp = path.with_extension("tmp");
+    {
+        let mut file = File::create(&tmp)?;
+        file.write_all(content)?;
+        file.sync_all()?;
+    }
+    fs::rename(&tmp, path)
+}
+
+fn write_index(dir: &Path, metas: &[LogbookMeta]) -> io::Result<()> {
+    let json = serde_json::to_vec_pretty(metas)
+        .map_err(|e| io::Error::new(io::ErrorKind::InvalidData, e))?;
+    write_atomic(&index_path(dir), &json)
+}
+
+/// Live entries of a journal after replaying it
+struct Replayed<E> {
+    entries: Vec<E>,
+    records: usize,
+    written: usize, // Entries written by all records
+}
+
+/// Replay a journal. A torn last line (crash mid-append) is ignored.
+fn replay<E: Hashed + for<'de> Deserialize<'de>>(path: &Path) -> io::Result<Replayed<E>> {
+    let mut replayed = Replayed { entries: Vec::new(), records: 0, written: 0 };
+    let file = match File::open(path) {
+        Ok(f) => f,
+        Err(e) if e.kind() == io::ErrorKind::NotFound => return Ok(replayed),
+        Err(e) => return Err(e),
+    };
+
+    let mut seen: HashSet<String> = HashSet::new();
+    for line in BufReader::new(file).lines() {
+        let line = line?;
+        if line.trim().is_empty() {
+            continue;
+        }
+        let record: Record<E> = match serde_json::from_str(&line) {
+            Ok(r) => r,
+            Err(e) => {
+                log::warn!("Skipping bad logbook journal record in {}: {}", path.display(), e);
+                continue;
+            }
+        };
+        replayed.records += 1;
+        match record {
+            Record::Add { entries } => {
+                replayed.written += entries.len();
+                for entry in entries {
+                    // An entry is in a logbook at most once
+                    let Some(hash) = entry.hash() else { continue };
+                    if seen.insert(hash.to_string()) {
+                        replayed.entries.push(entry);
+                    }
+                }
+            }
+            Record::Remove { hashes } => {
+                let removed: HashSet<&str> = hashes.iter().map(String::as_str).collect();
+                replayed.entries.retain(|e| !e.hash().is_some_and(|h| removed.contains(h)));
+                for hash in &hashes {
+                    seen.remove(hash);
+                }
+            }
+            Record::Order { hashes } => {
+                let rank: HashMap<&str, usize> =
+                    hashes.iter().enumerate().map(|(i, h)| (h.as_str(), i)).collect();
+                // Entries missing from the order keep their place at the end
+                replayed.entries.sort_by_key(|e| e.hash().and_then(|h| rank.get(h)).copied().unwrap_or(usize::MAX));
+            }
+            Record::Replace { entries } => {
+                replayed.written = entries.len();
+                replayed.entries.clear();
+                seen.clear();
+                for entry in entries {
+                    let Some(hash) = entry.hash() else { continue };
+                    if seen.insert(hash.to_string()) {
+                        replayed.entries.push(entry);
+                    }
+                }
+            }
+        }
+    }
+    Ok(replayed)
+}
+
+fn append_record(path: &Path, record: &Record<Value>) -> io::Result<()> {
+    let mut line = serde_json::to_vec(record).map_err(|e| io::Error::new(io::ErrorKind::InvalidData, e))?;
+    line.push(b'\n');
+    let mut file = OpenOptions::new().create(true).read(true).append(true).open(path)?;
+
+    // A torn last line (crash mid-append) would swallow this record
+    let len = file.metadata()?.len();
+    if len > 0 {
+        let mut last = [0u8; 1];
+        file.seek(SeekFrom::Start(len - 1))?;
+        file.read_exact(&mut last)?;
+        if last[0] != b'\n' {
+            line.insert(0, b'\n');
+        }
+    }
+    file.write_all(&line)
+}
+
+/// Rewrite a journal as a single replace record
+fn compact(path: &Path, entries: &[Value]) -> io::Result<()> {
+    let record: Record<&Value> = Record::Replace { entries: entries.iter().collect() };
+    let mut line = serde_json::to_vec(&record).map_err(|e| io::Error::new(io::ErrorKind::InvalidData, e))?;
+    line.push(b'\n');
+    write_atomic(path, &line)
+}
+
+fn load_all() -> io::Result<(Vec<LogbookSummary>, bool)> {
+    let dir = store_dir()?;
+    let _guard = store_lock().lock().unwrap();
+    let Some(metas) = read_index(&dir)? else {
+        return Ok((Vec::new(), false));
+    };
+
+    let mut logbooks = Vec::with_capacity(metas.len());
+    for meta in metas {
+        let replayed: Replayed<HashOnly> = replay(&journal_path(&dir, &meta.id))?;
+        let hashes = replayed.entries.into_iter().filter_map(|e| e.hash).collect();
+        logbooks.push(LogbookSummary { meta, hashes });
+    }
+    Ok((logbooks, true))
+}
+
+fn load_entries(id: &str) -> io::Result<Vec<Value>> {
+    let dir = store_dir()?;
+    let _guard = store_lock().lock().unwrap();
+    let path = journal_path(&dir, id);
+    let replayed: Replayed<Value> = replay(&path)?;
+
+    let dead = replayed.records > 1
+        && (replayed.records >= COMPACT_MIN_RECORDS
+            || replayed.written > replayed.entries.len() * COMPACT_WRITTEN_RATIO);
+    if dead {
+        if let Err(e) = compact(&path, &replayed.entries) {
+            log::warn!("Cannot compact logbook journal {}: {}", path.display(), e);
+        }
+    }
+    Ok(replayed.entries)
+}
+
+fn apply(ops: Vec<LogbookOp>) -> io::Result<()> {
+    let dir = store_dir()?;
+    let _guard = store_lock().lock().unwrap();
+    fs::create_dir_all(&dir)?;
+
+    let mut metas = read_index(&dir)?.unwrap_or_default();
+    let mut index_changed = !index_path(&dir).exists();
+
+    for op in ops {
+        match op {
+            LogbookOp::PutMeta { meta } => {
+                match metas.iter_mut().find(|m| m.id == meta.id) {
+                    Some(existing) => *existing = meta,
+                    None => metas.push(meta),
+                }
+                index_changed = true;
+            }
+            LogbookOp::Delete { id } => {
+                metas.retain(|m| m.id != id);
+                index_changed = true;
+                match fs::remove_file(journal_path(&dir, &id)) {
+                    Err(e) if e.kind() != io::ErrorKind::NotFound => return Err(e),
+                    _ => {}
+                }
+            }
+            LogbookOp::Add { id, entries } => {
+                append_record(&journal_path(&dir, &id), &Record::Add { entries })?;
+            }
+            LogbookOp::Remove { id, hashes } => {
+                append_record(&journal_path(&dir, &id), &Record::Remove { hashes })?;
+            }
+            LogbookOp::Order { id, hashes } => {
+                append_record(&journal_path(&dir, &id), &Record::Order { hashes })?;
+            }
+            LogbookOp::Replace { id, entries } => {
+                // Replaces everything before it - start the journal over
+                compact(&journal_path(&dir, &id), &entries)?;
+            }
+        }
+    }
+
+    if index_changed {
+        write_index(&dir, &metas)?;
+    }
+    Ok(())
+}
+
+/// List stored logbooks (metadata and entry hashes, not the entries)
+#[tauri::command(async)]
+pub fn load_logbooks() -> LoadLogbooksResult {
+    match load_all() {
+        Ok((logbooks, initialized)) => LoadLogbooksResult {
+            success: true,
+            logbooks: Some(logbooks),
+            initialized,
+            error: None,
+        },
+        Err(e) => LoadLogbooksResult {
+            success: false,
+            logbooks: None,
+            initialized: false,
+            error: Some(format!("Cannot load logbooks: {}", e)),
+        },
+    }
+}
+
+/// Load the entries of one logbook, in order
+#[tauri::command(async)]
+pub fn load_logbook_entries(id: String) -> LogbookEntriesResult {
+    match load_entries(&id) {
+        Ok(entries) => LogbookEntriesResult {
+            success: true,
+            entries: Some(entries),
+            error: None,
+        },
+        Err(e) => LogbookEntriesResult {
+            success: false,
+            entries: None,
+            error: Some(format!("Cannot load logbook: {}", e)),
+        },
+    }
+}
+
+/// Apply a batch of logbook writes, in order
+#[tauri::command(async)]
+pub fn write_logbooks(ops: Vec<LogbookOp>) -> WriteLogbooksResult {
+    match apply(ops) {
+        Ok(()) => WriteLogbooksResult { success: true, error: None },
+        Err(e) => WriteLogbooksResult {
+            success: false,
+            error: Some(format!("Cannot save logbooks: {}", e)),
+        },
+    }
+}
@@ -0,0 +1,278 @@
+//! Persisted parse cache under ~/.mocha/cache
+//!
+//! Reopening a large file skips reading and parsing its tail again: the
+//! entries parsed on the initial read are stored with the file's identity
+//! (inode, size, mtime) and its line-offset index. A file that only grew
+//! since is served from the cache plus a parse of the appended bytes, as
+//! long as that still fits the initial-read window (otherwise its tail is
+//! read again, from the restored index); one that changed otherwise is read
+//! as usual. Compressed files (see
+//! compressed.rs) are only served when unchanged, without decoding them.
+//!
+//! The cache directory is capped at MAX_CACHE_BYTES; the least recently
+//! used files are removed first (a hit touches its file's mtime).
+
+use serde::{Deserialize, Serialize};
+use std::fs::{self, File, Metadata};
+use std::io::{self, Read, Seek, SeekFrom, Write};
+use std::path::PathBuf;
+use std::thread;
+use std::time::SystemTime;
+
+use crate::compressed::is_compressed;
+use crate::index::{index_snapshot, seed_index, with_index, LineIndex};
+use crate::parser::{parse_log_file, recalculate_timestamps, LogEntry};
+
+// Bump when the cached format or parser output changes
+const CACHE_VERSION: u32 = 5;
+const MAX_CACHE_BYTES: u64 = 256 * 1024 * 1024;
+// Bytes before the cached offset that must be unchanged for a grown file
+// to be served from the cache
+const FINGERPRINT_BYTES: u64 = 4096;
+// Larger appends are read as a fresh tail instead
+const MAX_CACHED_APPEND: u64 = 2 * 1024 * 1024;
+
+/// Initial read of a file, as stored
+#[derive(Serialize, Deserialize)]
+#[serde(rename_all = "camelCase")]
+struct CachedParse {
+    version: u32,
+    path: String,
+    inode: u64,
+    size: u64, // Read offset: bytes covered by `logs`
+    mtime: Option<i64>,
+    compressed: bool, // `size` is then the decompressed size
+    file_len: u64,    // Size on disk when stored
+    fingerprint: u64, // Of the FINGERPRINT_BYTES before `size`
+    start_line: u64,
+    file_lines: u64,
+    total_lines: usize,
+    index: LineIndex,
+    logs: Vec<LogEntry>,
+}
+
+/// Cached initial read, brought up to the file's current size
+pub struct CachedTail {
+    pub logs: Vec<LogEntry>,
+    pub start_line: u64,
+    pub file_lines: u64,
+    pub total_lines: usize,
+    pub size: u64,
+}
+
+/// Get the path to ~/.mocha/cache
+fn cache_dir() -> Option<PathBuf> {
+    dirs::home_dir().map(|home| home.join(".mocha").join("cache"))
+}
+
+/// Cache file of a log file (FNV-1a of its path)
+fn cache_path(path: &str) -> Option<PathBuf> {
+    cache_dir().map(|dir| dir.join(format!("{:016x}.json", fnv1a(path.as_bytes()))))
+}
+
+pub fn fnv1a(bytes: &[u8]) -> u64 {
+    let mut hash: u64 = 0xcbf29ce484222325;
+    for &b in bytes {
+        hash ^= b as u64;
+        hash = hash.wrapping_mul(0x100000001b3);
+    }
+    hash
+}
+
+#[cfg(unix)]
+pub fn inode(metadata: &Metadata) -> u64 {
+    use std::os::unix::fs::MetadataExt;
+    metadata.ino()
+}
+
+#[cfg(not(unix))]
+pub fn inode(_metadata: &Metadata) -> u64 {
+    0
+}
+
+fn mtime_millis(metadata: &Metadata) -> Option<i64> {
+    metadata
+        .modified()
+        .ok()
+        .and_then(|t| t.duration_since(std::time::UNIX_EPOCH).ok())
+        .map(|d| d.as_millis() as i64)
+}
+
+/// Fingerprint of the bytes just before `offset`
+fn fingerprint(file: &mut File, offset: u64) -> io::Result<u64> {
+    let start = offset.saturating_sub(FINGERPRINT_BYTES);
+    let mut buf = vec![0u8; (offset - start) as usize];
+    file.seek(SeekFrom::Start(start))?;
+    file.read_exact(&mut buf)?;
+    Ok(fnv1a(&buf))
+}
+
+fn read_cached(path: &str) -> Option<CachedParse> {
+    let content = fs::read(cache_path(path)?).ok()?;
+    let cached: CachedParse = serde_json::from_slice(&content).ok()?;
+    (cached.version == CACHE_VERSION && cached.path == path).then_some(cached)
+}
+
+/// Mark a cache file as just used (for LRU eviction)
+fn touch(path: &str) {
+    if let Some(cache_file) = cache_path(path) {
+        if let Ok(file) = File::options().append(true).open(cache_file) {
+            let _ = file.set_modified(SystemTime::now());
+        }
+    }
+}
+
+/// Initial read of `path` from the cache, if the file is the one cached or
+/// only grew since and the cached lines plus the appended ones still fit the
+/// initial-read window (`max_lines`, `max_bytes`; see read_tail). The file's
+/// line index is restored either way, so a fresh tail read skips indexing.
+pub fn load(path: &str, name: &str, metadata: &Metadata, max_lines: u64, max_bytes: u64) -> Option<CachedTail> {
+    let cached = read_cached(path)?;
+    let size = metadata.len();
+    if cached.inode != inode(metadata) || (!cached.compressed && size < cached.size) {
+        return None;
+    }
+
+    let cached_len = if cached.compressed { cached.file_len } else { cached.size };
+    if size == cached_len && mtime_millis(metadata) == cached.mtime {
+        seed_index(path, cached.index);
+        touch(path);
+        return Some(CachedTail {
+            logs: cached.logs,
+            start_line: cached.start_line,
+            file_lines: cached.file_lines,
+            total_lines: cached.total_lines,
+            size: cached.size,
+        });
+    }
+    if cached.compressed {
+        return None; // Changed - decoded again by the caller
+    }
+
+    // Grown: the cached part must be unchanged
+    if size - cached.size > MAX_CACHED_APPEND {
+        return None;
+    }
+    let mut file = File::open(path).ok()?;
+    if fingerprint(&mut file, cached.size).ok()? != cached.fingerprint {
+        return None;
+    }
+
+    // Past the window once the appended lines are added: read a fresh tail
+    // instead of letting the cached read grow on every reopen
+    seed_index(path, cached.index);
+    let (file_lines, window_start) = with_index(path, |index, file| {
+        Ok((index.total_lines(), index.line_offset(file, cached.start_line)?))
+    })
+    .ok()?;
+    if file_lines - cached.start_line > max_lines || size - window_start > max_bytes {
+        return None;
+    }
+
+    let mut appended = Vec::with_capacity((size - cached.size) as usize);
+    file.seek(SeekFrom::Start(cached.size)).ok()?;
+    file.take(size - cached.size).read_to_end(&mut appended).ok()?;
+
+    let parsed = parse_log_file(&String::from_utf8_lossy(&appended), name, Some(path));
+    if parsed.truncated {
+        return None; // Appended more lines than one read holds
+    }
+
+    let mut logs = cached.logs;
+    logs.extend(parsed.logs);
+    recalculate_timestamps(&mut logs);
+    let tail = CachedTail {
+        logs,
+        start_line: cached.start_line,
+        file_lines,
+        total_lines: cached.total_lines + parsed.total_lines,
+        size,
+    };
+    store(path, metadata, &tail);
+    Some(tail)
+}
+
+/// Cache the initial read of `path` (written in the background)
+pub fn store(path: &str, metadata: &Metadata, tail: &CachedTail) {
+    let Some(index) = index_snapshot(path) else { return };
+    // The index must cover exactly what was parsed
+    if index.size() != tail.size {
+        return;
+    }
+
+    let compressed = is_compressed(path);
+    let path = path.to_string();
+    let inode = inode(metadata);
+    let mtime = mtime_millis(metadata);
+    let file_len = metadata.len();
+    let (logs, start_line, file_lines, total_lines, size) =
+        (tail.logs.clone(), tail.start_line, tail.file_lines, tail.total_lines, tail.size);
+
+    thread::spawn(move || {
+        // Only plain files are extended from the cache, which needs the fingerprint
+        let fingerprint = if compressed {
+            0
+        } else {
+            let Ok(mut file) = File::open(&path) else { return };
+            let Ok(fingerprint) = fingerprint(&mut file, size) else { return };
+            fingerprint
+        };
+        let cached = CachedParse {
+            version: CACHE_VERSION,
+            path: path.clone(),
+            inode,
+            size,
+            mtime,
+            compressed,
+            file_len,
+            fingerprint,
+            start_line,
+            file_lines,
+            total_lines,
+            index,
+            logs,
+        };
+        if let Err(e) = write_cached(&cached) {
+            log::warn!("Cannot write parse cache for {}: {}", path, e);
+        }
+    });
+}
+
+fn write_cached(cached: &CachedParse) -> io::Result<()> {
+    let (Some(dir), Some(cache_file)) = (cache_dir(), cache_path(&cached.path)) else {
+        return Ok(());
+    };
+    fs::create_dir_all(&dir)?;
+    let json = serde_json::to_vec(cached).map_err(|e| io::Error::new(io::ErrorKind::InvalidData, e))?;
+
+    let tmp = cache_file.with_extension("tmp");
+    File::create(&tmp)?.write_all(&json)?;
+    fs::rename(&tmp, &cache_file)?;
+    evict(&dir)
+}
+
+/// Remove least recently used cache files until the cache fits its cap
+fn evict(dir: &PathBuf) -> io::Result<()> {
+    let mut files: Vec<(SystemTime, u64, PathBuf)> = fs::read_dir(dir)?
+        .filter_map(|entry| entry.ok())
+        .filter(|entry| entry.path().extension().is_some_and(|ext| ext == "json"))
+        .filter_map(|entry| {
+            let metadata = entry.metadata().ok()?;
+            Some((metadata.modified().ok()?, metadata.len(), entry.path()))
+        })
+        .collect();
+
+    let mut total: u64 = files.iter().map(|(_, len, _)| len).sum();
+    if total <= MAX_CACHE_BYTES {
+        return Ok(());
+    }
+    files.sort_by_key(|(modified, _, _)| *modified);
+    for (_, len, path) in files {
+        if total <= MAX_CACHE_BYTES {
+            break;
+        }
+        fs::remove_file(&path)?;
+        total -= len;
+    }
+    Ok(())
+}
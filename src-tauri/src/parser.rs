@@ -0,0 +1,1298 @@
+//! Log parsing engine
+//!
+//! Rust port of ui/src/parser.ts. Parses raw log content into structured
+//! LogEntry records off the UI thread. Behaviour (patterns, continuation
+//! merging, hashing, timestamp recalculation) must stay in sync with the
+//! TypeScript parser, which is still used in browser mode.
+
+use chrono::{Local, NaiveDate, NaiveDateTime, NaiveTime, TimeZone, Utc};
+use rayon::prelude::*;
+use regex::Regex;
+use serde::{Deserialize, Serialize};
+use std::borrow::Cow;
+use std::collections::{HashMap, HashSet};
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::{Mutex, OnceLock};
+
+use crate::lines::{self, LineSpan};
+use crate::pool;
+
+// Frontend only displays last 2000 lines per read
+const MAX_LINES: usize = 2000;
+// Lines used to detect a file's dominant format
+const AFFINITY_SAMPLE_LINES: usize = 100;
+// Entries from which a read is parsed on the load pool
+const PARALLEL_PARSE_MIN_LINES: usize = 500;
+
+/// Compile a JavaScript regex literal with matching semantics:
+/// `\d` is ASCII-only and `.` does not match `\r` (like JS without the `s` flag)
+pub(crate) fn js_regex(source: &str, ignore_case: bool) -> Regex {
+    let flags = if ignore_case { "(?iR)" } else { "(?R)" };
+    Regex::new(&format!("{}{}", flags, source.replace(r"\d", "[0-9]"))).unwrap()
+}
+
+/// Lazily compiled static regex, written like the JS literal it mirrors
+macro_rules! regex {
+    ($re:literal) => {{
+        static RE: std::sync::OnceLock<regex::Regex> = std::sync::OnceLock::new();
+        RE.get_or_init(|| crate::parser::js_regex($re, false))
+    }};
+    ($re:literal, i) => {{
+        static RE: std::sync::OnceLock<regex::Regex> = std::sync::OnceLock::new();
+        RE.get_or_init(|| crate::parser::js_regex($re, true))
+    }};
+}
+
+// ============================================================================
+// Types (mirror ui/src/types.ts)
+// ============================================================================
+
+/// Information about an API call extracted from a log line
+/// (Deserialize: entries are read back from the parse cache)
+#[derive(Serialize, Deserialize, Clone, Debug, Default)]
+#[serde(rename_all = "camelCase")]
+pub struct ApiCallInfo {
+    pub direction: Cow<'static, str>,
+    pub phase: Cow<'static, str>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub method: Option<String>,
+    pub endpoint: String,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub status: Option<u64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub timing: Option<String>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub request_body: Option<String>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub response_body: Option<String>,
+}
+
+/// Parsed information extracted from a log line
+#[derive(Serialize, Deserialize, Clone, Debug, Default)]
+#[serde(rename_all = "camelCase")]
+pub struct ParsedLogLine {
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub timestamp: Option<String>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub level: Option<String>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub logger: Option<String>,
+    pub content: String,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub api_call: Option<ApiCallInfo>,
+}
+
+/// A single log entry with original and parsed data
+#[derive(Serialize, Deserialize, Clone, Debug, Default)]
+#[serde(rename_all = "camelCase")]
+pub struct LogEntry {
+    pub name: String,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub file_path: Option<String>,
+    pub data: String,
+    pub is_err: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub hash: Option<String>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub timestamp: Option<i64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub sort_index: Option<i64>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub parsed: Option<ParsedLogLine>,
+}
+
+/// Result from parsing an entire log file
+#[derive(Serialize, Clone, Debug, Default)]
+#[serde(rename_all = "camelCase")]
+pub struct ParsedLogFileResult {
+    pub logs: Vec<LogEntry>,
+    pub total_lines: usize,
+    pub truncated: bool,
+}
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+/// Length in UTF-16 code units (what JS `string.length` reports)
+fn js_len(s: &str) -> usize {
+    s.encode_utf16().count()
+}
+
+/// Normalize log level (e.g., WARNING -> WARN)
+fn normalize_level(level: &str) -> String {
+    let upper = level.to_uppercase();
+    if upper == "WARNING" {
+        return "WARN".to_string();
+    }
+    upper
+}
+
+/// Check if a line is ASCII art (high ratio of special characters)
+fn is_ascii_art(line: &str) -> bool {
+    let special = line
+        .chars()
+        .filter(|c| "|_/\\+-=<>^~[]{}()#*@!".contains(*c))
+        .count();
+    if special == 0 {
+        return false;
+    }
+    special as f64 / js_len(line) as f64 > 0.3
+}
+
+/// Check if a line is just a timestamp marker (metadata line, not actual log content)
+fn is_timestamp_only_line(line: &str) -> bool {
+    regex!(r"^\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}[.,]\d{3}\s*$").is_match(line.trim())
+}
+
+/// Check if a line is a continuation of the previous line
+pub fn is_continuation_line(line: &str) -> bool {
+    if line.is_empty() {
+        return false;
+    }
+    // Don't treat timestamp-only lines as continuations - they should be skipped entirely
+    if is_timestamp_only_line(line) {
+        return false;
+    }
+    // Lines starting with a date are standalone log lines
+    let trimmed = line.trim();
+    if regex!(r"^\d{4}-\d{2}-\d{2}").is_match(trimmed) {
+        return false;
+    }
+    // Lines starting with { are likely JSON structured logs
+    if trimmed.starts_with('{') {
+        return false;
+    }
+    // Indented lines
+    if line.starts_with(' ') || line.starts_with('\t') {
+        return true;
+    }
+    // ASCII art lines
+    if is_ascii_art(line) {
+        return true;
+    }
+    // Short lines without timestamp prefix
+    if js_len(line) < 20 && !line.starts_with('[') {
+        return true;
+    }
+
+    // Java stack trace patterns (often not indented)
+    if regex!(r"^[a-z]+(\.[a-z]+)*\.[A-Z][A-Za-z]*(Exception|Error):").is_match(trimmed) {
+        return true;
+    }
+    if regex!(r"^Caused by:").is_match(trimmed) {
+        return true;
+    }
+    if regex!(r"^at\s+[a-z]").is_match(trimmed) {
+        return true;
+    }
+    if regex!(r"^\.\.\.\s+\d+\s+more").is_match(trimmed) {
+        return true;
+    }
+
+    false
+}
+
+/// Capture group as an owned string ("" if the group didn't participate)
+fn cap(caps: &regex::Captures, i: usize) -> String {
+    caps.get(i).map(|m| m.as_str().to_string()).unwrap_or_default()
+}
+
+// ============================================================================
+// Log Format Patterns (same order as parser.ts)
+// ============================================================================
+
+pub struct LogPattern {
+    pub name: &'static str,
+    pub parse: fn(&str) -> Option<ParsedLogLine>,
+    /// Earlier patterns that can also match lines of this format. When this
+    /// pattern is tried first (format affinity) these must miss before its
+    /// result is used, so affinity never changes which pattern wins.
+    pub shadowed_by: &'static [usize],
+}
+
+fn parse_salesbox_core(line: &str) -> Option<ParsedLogLine> {
+    // Full format with [context]
+    if let Some(m) = regex!(r"^\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}[.,]\d+Z?\s+(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}[.,]\d+)\s+\[([^\]]+)\]\s+(ERROR|WARN|INFO|DEBUG|TRACE)\s+(\S+)\s+\[([^\]]+\.java:\d+)\]\s+\[[^\]]*\]\s+[-–—]\s*(.*)$", i).captures(line) {
+        return Some(ParsedLogLine {
+            timestamp: Some(cap(&m, 1)),
+            level: Some(normalize_level(&m[3])),
+            logger: Some(format!("{}:{}", &m[4], m[5].split(':').nth(1).unwrap_or(""))),
+            content: cap(&m, 6),
+            api_call: None,
+        });
+    }
+
+    // Simpler format without [context]
+    if let Some(m) = regex!(r"^\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}[.,]\d+Z?\s+(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}[.,]\d+)\s+\[([^\]]+)\]\s+(ERROR|WARN|INFO|DEBUG|TRACE)\s+(\S+)\s+\[([^\]]+\.java:\d+)\]\s+[-–—]\s*(.*)$", i).captures(line) {
+        return Some(ParsedLogLine {
+            timestamp: Some(cap(&m, 1)),
+            level: Some(normalize_level(&m[3])),
+            logger: Some(format!("{}:{}", &m[4], m[5].split(':').nth(1).unwrap_or(""))),
+            content: cap(&m, 6),
+            api_call: None,
+        });
+    }
+
+    // Even simpler - dual timestamp with just level and logger
+    if let Some(m) = regex!(r"^\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}[.,]\d+Z?\s+(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}[.,]\d+)\s+\[([^\]]+)\]\s+(ERROR|WARN|INFO|DEBUG|TRACE)\s+(\S+)\s+[-–—]\s*(.*)$", i).captures(line) {
+        return Some(ParsedLogLine {
+            timestamp: Some(cap(&m, 1)),
+            level: Some(normalize_level(&m[3])),
+            logger: Some(cap(&m, 4)),
+            content: cap(&m, 5),
+            api_call: None,
+        });
+    }
+
+    None
+}
+
+fn parse_salesbox_app(line: &str) -> Option<ParsedLogLine> {
+    let m = regex!(r"^(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}[,.]\d+)\s+\d+\s+\[([^\]]+)\]\s+(ERROR|WARN|INFO|DEBUG|TRACE)\s+(\S+)\s+[-–—]\s*(.*)$", i).captures(line)?;
+    Some(ParsedLogLine {
+        timestamp: Some(cap(&m, 1)),
+        level: Some(normalize_level(&m[3])),
+        logger: Some(cap(&m, 4)),
+        content: cap(&m, 5),
+        api_call: None,
+    })
+}
+
+fn parse_iwf_spring(line: &str) -> Option<ParsedLogLine> {
+    let m = regex!(r"^\[([^\]]+)\]\s+(ERROR|WARN|INFO|DEBUG|TRACE)\s+(\S+)\s+\[([^\]]+\.java:\d+)\]\s+\[[^\]]*\]\s+[-–—]\s*(.*)$", i).captures(line)?;
+    Some(ParsedLogLine {
+        timestamp: None,
+        level: Some(normalize_level(&m[2])),
+        logger: Some(format!("{} [{}]", &m[3], &m[4])),
+        content: cap(&m, 5),
+        api_call: None,
+    })
+}
+
+fn parse_logback_with_source(line: &str) -> Option<ParsedLogLine> {
+    let m = regex!(r"^(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}[,.]\d+)\s+\[([^\]]+)\]\s+(ERROR|WARN|INFO|DEBUG|TRACE)\s+(\S+)\s+\[([^\]]+\.java:\d+)\]\s+\[[^\]]*\]\s+[-–—]\s*(.*)$", i).captures(line)?;
+    Some(ParsedLogLine {
+        timestamp: Some(cap(&m, 1)),
+        level: Some(normalize_level(&m[3])),
+        logger: Some(format!("{} [{}]", &m[4], &m[5])),
+        content: cap(&m, 6),
+        api_call: None,
+    })
+}
+
+fn parse_logback_internal(line: &str) -> Option<ParsedLogLine> {
+    let m = regex!(r"^(\d{2}:\d{2}:\d{2}[,.]\d+)\s+\|-(ERROR|WARN|INFO|DEBUG|TRACE)\s+in\s+(\S+)\s+[-–—]\s*(.*)$", i).captures(line)?;
+    Some(ParsedLogLine {
+        timestamp: Some(cap(&m, 1)),
+        level: Some(normalize_level(&m[2])),
+        logger: Some(cap(&m, 3)),
+        content: cap(&m, 4),
+        api_call: None,
+    })
+}
+
+fn parse_maven(line: &str) -> Option<ParsedLogLine> {
+    // [INFO] --- mn:3.5.4:run (default-cli) @ salesboxai-platform ---
+    if let Some(m) = regex!(r"^\[(ERROR|WARN|WARNING|INFO|DEBUG)\]\s+---\s+(\S+)\s+@\s+(\S+)\s+---\s*$", i).captures(line) {
+        return Some(ParsedLogLine {
+            level: Some(normalize_level(&m[1])),
+            logger: Some(cap(&m, 3)),
+            content: format!("--- {} ---", &m[2]),
+            ..Default::default()
+        });
+    }
+
+    // [INFO] /path/to/File.java: warning message
+    if let Some(m) = regex!(r"^\[(ERROR|WARN|WARNING|INFO|DEBUG)\]\s+(\/[^:]+\.java):\s*(.*)$", i).captures(line) {
+        return Some(ParsedLogLine {
+            level: Some(normalize_level(&m[1])),
+            logger: Some(cap(&m, 2)),
+            content: cap(&m, 3),
+            ..Default::default()
+        });
+    }
+
+    // [INFO] message (generic)
+    if let Some(m) = regex!(r"^\[(ERROR|WARN|WARNING|INFO|DEBUG)\]\s+(.*)$", i).captures(line) {
+        return Some(ParsedLogLine {
+            level: Some(normalize_level(&m[1])),
+            content: cap(&m, 2),
+            ..Default::default()
+        });
+    }
+
+    None
+}
+
+fn parse_logback(line: &str) -> Option<ParsedLogLine> {
+    let m = regex!(r"^(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}[,.]\d+)\s+(ERROR|WARN|INFO|DEBUG|TRACE)\s+\[([^\]]+)\]\s*(.*)$", i).captures(line)?;
+    Some(ParsedLogLine {
+        timestamp: Some(cap(&m, 1)),
+        level: Some(normalize_level(&m[2])),
+        logger: Some(cap(&m, 3)),
+        content: cap(&m, 4),
+        api_call: None,
+    })
+}
+
+fn parse_bracketed(line: &str) -> Option<ParsedLogLine> {
+    let m = regex!(r"^(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}(?:[,.]\d+)?)\s*\[(ERROR|WARN|WARNING|INFO|DEBUG|TRACE)\]\s*(.*)$", i).captures(line)?;
+    Some(ParsedLogLine {
+        timestamp: Some(cap(&m, 1)),
+        level: Some(normalize_level(&m[2])),
+        content: cap(&m, 3),
+        ..Default::default()
+    })
+}
+
+fn parse_python_logging(line: &str) -> Option<ParsedLogLine> {
+    let m = regex!(r"^(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}[,.]\d+)\s+-\s+(\S+)\s+-\s+(ERROR|WARN(?:ING)?|INFO|DEBUG)\s+-\s*(.*)$", i).captures(line)?;
+    Some(ParsedLogLine {
+        timestamp: Some(cap(&m, 1)),
+        logger: Some(cap(&m, 2)),
+        level: Some(normalize_level(&m[3])),
+        content: cap(&m, 4),
+        api_call: None,
+    })
+}
+
+fn parse_logback_with_thread(line: &str) -> Option<ParsedLogLine> {
+    // Handle multi-line content: only match the first line for the pattern
+    let mut lines = line.split('\n');
+    let first_line = lines.next().unwrap_or("");
+
+    let m = regex!(r"^(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}[,.]\d+)\s+\[([^\]]+)\]\s+(ERROR|WARN|INFO|DEBUG|TRACE)\s+(\S+)\s+[-–—]\s*(.*)$", i).captures(first_line)?;
+
+    // Remaining lines are part of the content
+    let mut content = cap(&m, 5);
+    for rest in lines {
+        content.push('\n');
+        content.push_str(rest);
+    }
+
+    Some(ParsedLogLine {
+        timestamp: Some(cap(&m, 1)),
+        level: Some(normalize_level(&m[3])),
+        logger: Some(cap(&m, 4)),
+        content,
+        api_call: None,
+    })
+}
+
+fn parse_simple(line: &str) -> Option<ParsedLogLine> {
+    // With level: 2025-12-18 05:32:18.541 INFO message
+    if let Some(m) = regex!(r"^(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}(?:[,.]\d+)?)\s+(ERROR|WARN|WARNING|INFO|DEBUG|TRACE)\s+(.*)$", i).captures(line) {
+        return Some(ParsedLogLine {
+            timestamp: Some(cap(&m, 1)),
+            level: Some(normalize_level(&m[2])),
+            content: cap(&m, 3),
+            ..Default::default()
+        });
+    }
+
+    // Without level: 2025-12-18 05:32:18.541 message
+    if let Some(m) = regex!(r"^(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}(?:[,.]\d+)?)\s+(.*)$").captures(line) {
+        return Some(ParsedLogLine {
+            timestamp: Some(cap(&m, 1)),
+            content: cap(&m, 2),
+            ..Default::default()
+        });
+    }
+
+    None
+}
+
+fn parse_logback_time_only(line: &str) -> Option<ParsedLogLine> {
+    let m = regex!(r"^(\d{2}:\d{2}:\d{2}[,.]\d+)\s+\[([^\]]+)\]\s+(ERROR|WARN|INFO|DEBUG|TRACE)\s+(\S+)\s+[-–—]\s*(.*)$", i).captures(line)?;
+    Some(ParsedLogLine {
+        timestamp: Some(cap(&m, 1)),
+        level: Some(normalize_level(&m[3])),
+        logger: Some(cap(&m, 4)),
+        content: cap(&m, 5),
+        api_call: None,
+    })
+}
+
+fn parse_level_only(line: &str) -> Option<ParsedLogLine> {
+    // [INFO] message
+    if let Some(m) = regex!(r"^\[(ERROR|WARN|WARNING|INFO|DEBUG|TRACE)\]\s*(.*)$", i).captures(line) {
+        return Some(ParsedLogLine {
+            level: Some(normalize_level(&m[1])),
+            content: cap(&m, 2),
+            ..Default::default()
+        });
+    }
+
+    // [service] ERROR message
+    if let Some(m) = regex!(r"^\[([^\]]+)\]\s+(ERROR|WARN|WARNING|INFO|DEBUG|TRACE)\s+(.*)$", i).captures(line) {
+        return Some(ParsedLogLine {
+            level: Some(normalize_level(&m[2])),
+            logger: Some(cap(&m, 1)),
+            content: cap(&m, 3),
+            ..Default::default()
+        });
+    }
+
+    // INFO message
+    if let Some(m) = regex!(r"^(ERROR|WARN|WARNING|INFO|DEBUG|TRACE)\s+(.*)$", i).captures(line) {
+        return Some(ParsedLogLine {
+            level: Some(normalize_level(&m[1])),
+            content: cap(&m, 2),
+            ..Default::default()
+        });
+    }
+
+    None
+}
+
+fn parse_genie_rust(line: &str) -> Option<ParsedLogLine> {
+    let m = regex!(r"^\[(\d{4}-\d{2}-\d{2})\]\[(\d{2}:\d{2}:\d{2})\]\[([^\]]+)\]\[(ERROR|WARN|INFO|DEBUG|TRACE)\]\s*(.*)$", i).captures(line)?;
+    Some(ParsedLogLine {
+        timestamp: Some(format!("{} {}", &m[1], &m[2])),
+        level: Some(normalize_level(&m[4])),
+        logger: Some(cap(&m, 3)),
+        content: cap(&m, 5),
+        api_call: None,
+    })
+}
+
+/// JavaScript truthiness for a JSON value
+fn is_truthy(value: &serde_json::Value) -> bool {
+    match value {
+        serde_json::Value::Null => false,
+        serde_json::Value::Bool(b) => *b,
+        serde_json::Value::Number(n) => n.as_f64().map(|f| f != 0.0).unwrap_or(true),
+        serde_json::Value::String(s) => !s.is_empty(),
+        _ => true,
+    }
+}
+
+/// First truthy field among the aliases (JS `a || b || c`)
+fn first_truthy<'a>(obj: &'a serde_json::Map<String, serde_json::Value>, keys: &[&str]) -> Option<&'a serde_json::Value> {
+    keys.iter().filter_map(|k| obj.get(*k)).find(|v| is_truthy(v))
+}
+
+/// JSON value as display string (strings unquoted)
+fn json_to_string(value: &serde_json::Value) -> String {
+    match value {
+        serde_json::Value::String(s) => s.clone(),
+        other => other.to_string(),
+    }
+}
+
+fn parse_json_structured(line: &str) -> Option<ParsedLogLine> {
+    // Quick check: must start with { and end with }
+    let trimmed = line.trim();
+    if !trimmed.starts_with('{') || !trimmed.ends_with('}') {
+        return None;
+    }
+
+    let value: serde_json::Value = serde_json::from_str(trimmed).ok()?;
+    let obj = value.as_object()?;
+
+    // Must have a message field (required)
+    let message = first_truthy(obj, &["message", "msg"])?.as_str()?;
+
+    // Extract fields with common aliases
+    let level = match first_truthy(obj, &["level", "severity", "levelname"]) {
+        // Non-string levels make the JS version throw (and skip the pattern)
+        Some(v) => Some(normalize_level(v.as_str()?)),
+        None => None,
+    };
+    let logger = first_truthy(obj, &["label", "service", "logger", "component"]).map(json_to_string);
+    let timestamp = first_truthy(obj, &["timestamp", "time", "datetime", "@timestamp"]).map(json_to_string);
+
+    Some(ParsedLogLine {
+        timestamp,
+        level,
+        logger,
+        content: message.to_string(),
+        api_call: None,
+    })
+}
+
+fn parse_iso_timestamp(line: &str) -> Option<ParsedLogLine> {
+    let m = regex!(r"^(\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}[.,]\d+Z?)\s+(.+)$").captures(line)?;
+
+    let content = cap(&m, 2);
+    // Detect if it's an exception/stack trace
+    let is_exception = regex!(r"Exception|Error|^\s*at\s").is_match(&content);
+
+    Some(ParsedLogLine {
+        timestamp: Some(cap(&m, 1)),
+        level: if is_exception { Some("ERROR".to_string()) } else { None },
+        content,
+        ..Default::default()
+    })
+}
+
+pub const PATTERN_COUNT: usize = 16;
+
+pub static PATTERNS: [LogPattern; PATTERN_COUNT] = [
+    LogPattern { name: "salesbox-core", parse: parse_salesbox_core, shadowed_by: &[] },
+    LogPattern { name: "salesbox-app", parse: parse_salesbox_app, shadowed_by: &[] },
+    LogPattern { name: "iwf-spring", parse: parse_iwf_spring, shadowed_by: &[] },
+    LogPattern { name: "logback-with-source", parse: parse_logback_with_source, shadowed_by: &[] },
+    LogPattern { name: "logback-internal", parse: parse_logback_internal, shadowed_by: &[] },
+    // iwf-spring: "[INFO] ERROR x [A.java:1] [] - ..."
+    LogPattern { name: "maven", parse: parse_maven, shadowed_by: &[2] },
+    LogPattern { name: "logback", parse: parse_logback, shadowed_by: &[] },
+    // logback-with-source: thread named like a level, "... [INFO] WARN x [A.java:1] [] - ..."
+    LogPattern { name: "bracketed", parse: parse_bracketed, shadowed_by: &[3] },
+    LogPattern { name: "python-logging", parse: parse_python_logging, shadowed_by: &[] },
+    // bracketed: thread named like a level, "... [INFO] WARN x - ..."
+    LogPattern { name: "logback-with-thread", parse: parse_logback_with_thread, shadowed_by: &[7] },
+    // Catch-all format - should remain near the end (any "date time ..." format above)
+    LogPattern { name: "simple", parse: parse_simple, shadowed_by: &[1, 3, 6, 7, 8, 9] },
+    LogPattern { name: "logback-time-only", parse: parse_logback_time_only, shadowed_by: &[] },
+    // iwf-spring and maven both start with a bracketed level/context
+    LogPattern { name: "level-only", parse: parse_level_only, shadowed_by: &[2, 5] },
+    LogPattern { name: "genie-rust", parse: parse_genie_rust, shadowed_by: &[] },
+    LogPattern { name: "json-structured", parse: parse_json_structured, shadowed_by: &[] },
+    // salesbox-core also starts with an ISO timestamp
+    LogPattern { name: "iso-timestamp", parse: parse_iso_timestamp, shadowed_by: &[0] },
+];
+
+// ============================================================================
+// Pattern Statistics & Format Affinity
+// ============================================================================
+
+struct PatternCounter {
+    hits: AtomicU64,
+    misses: AtomicU64,
+}
+
+const ZERO_COUNTER: PatternCounter = PatternCounter {
+    hits: AtomicU64::new(0),
+    misses: AtomicU64::new(0),
+};
+
+// How often each pattern was tried and matched/missed (since startup)
+static PATTERN_COUNTERS: [PatternCounter; PATTERN_COUNT] = [ZERO_COUNTER; PATTERN_COUNT];
+
+/// Hit/miss counters for one pattern
+#[derive(Serialize, Clone, Debug)]
+#[serde(rename_all = "camelCase")]
+pub struct PatternStats {
+    pub name: &'static str,
+    pub hits: u64,
+    pub misses: u64,
+}
+
+/// Snapshot of the per-pattern counters (misses are the cost of a format)
+pub fn pattern_stats() -> Vec<PatternStats> {
+    PATTERNS
+        .iter()
+        .zip(PATTERN_COUNTERS.iter())
+        .map(|(pattern, counter)| PatternStats {
+            name: pattern.name,
+            hits: counter.hits.load(Ordering::Relaxed),
+            misses: counter.misses.load(Ordering::Relaxed),
+        })
+        .collect()
+}
+
+/// Run a single pattern and record the outcome
+fn try_pattern(index: usize, line: &str) -> Option<ParsedLogLine> {
+    let result = (PATTERNS[index].parse)(line);
+    let counter = &PATTERN_COUNTERS[index];
+    if result.is_some() {
+        counter.hits.fetch_add(1, Ordering::Relaxed);
+    } else {
+        counter.misses.fetch_add(1, Ordering::Relaxed);
+    }
+    result
+}
+
+/// Find the first matching pattern, trying the affinity pattern first
+fn match_patterns(line: &str, affinity: Option<usize>) -> Option<(usize, ParsedLogLine)> {
+    if let Some(k) = affinity {
+        if let Some(result) = try_pattern(k, line) {
+            if PATTERNS[k].shadowed_by.iter().all(|&j| try_pattern(j, line).is_none()) {
+                return Some((k, result));
+            }
+        }
+    }
+
+    // Full scan in pattern order (the affinity pattern already missed or was shadowed)
+    (0..PATTERN_COUNT)
+        .filter(|&i| Some(i) != affinity)
+        .find_map(|i| try_pattern(i, line).map(|result| (i, result)))
+}
+
+/// Dominant pattern per file (keyed like hashes: file path or name)
+fn format_cache() -> &'static Mutex<HashMap<String, usize>> {
+    static CACHE: OnceLock<Mutex<HashMap<String, usize>>> = OnceLock::new();
+    CACHE.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+/// Pick the pattern that matched most sample lines, if it matched at least half
+fn dominant_pattern(wins: &[usize; PATTERN_COUNT], sampled: usize) -> Option<usize> {
+    let mut best = 0;
+    for i in 1..PATTERN_COUNT {
+        if wins[i] > wins[best] {
+            best = i;
+        }
+    }
+    if wins[best] > 0 && wins[best] * 2 >= sampled {
+        Some(best)
+    } else {
+        None
+    }
+}
+
+// ============================================================================
+// API Call Pattern Detection
+// ============================================================================
+
+fn api_call(direction: &'static str, phase: &'static str, method: Option<&str>, endpoint: String) -> ApiCallInfo {
+    ApiCallInfo {
+        direction: Cow::Borrowed(direction),
+        phase: Cow::Borrowed(phase),
+        method: method.map(|m| m.to_string()),
+        endpoint,
+        ..Default::default()
+    }
+}
+
+/// Parse API call information from log content
+pub fn parse_api_call(content: &str) -> Option<ApiCallInfo> {
+    // Outgoing GET no params: api call (no params) to https://api.example.com/users
+    if let Some(m) = regex!(r"api call \(no params\) to (\S+)", i).captures(content) {
+        return Some(api_call("outgoing", "request", Some("GET"), cap(&m, 1)));
+    }
+
+    // Outgoing GET with params: api call to https://api.example.com/users with {id: 1}
+    if let Some(m) = regex!(r"api call to (\S+) with (.+)", i).captures(content) {
+        let mut info = api_call("outgoing", "request", Some("GET"), cap(&m, 1));
+        info.request_body = Some(cap(&m, 2));
+        return Some(info);
+    }
+
+    // Outgoing DELETE no params
+    if let Some(m) = regex!(r"api DELETE call \(no params\) to (\S+)", i).captures(content) {
+        return Some(api_call("outgoing", "request", Some("DELETE"), cap(&m, 1)));
+    }
+
+    // Outgoing DELETE with params
+    if let Some(m) = regex!(r"api DELETE call to (\S+) with (.+)", i).captures(content) {
+        let mut info = api_call("outgoing", "request", Some("DELETE"), cap(&m, 1));
+        info.request_body = Some(cap(&m, 2));
+        return Some(info);
+    }
+
+    // POST with headers: api call -> https://api.example.com/users with [...]: {...}
+    if let Some(m) = regex!(r"api call -> (\S+) with \[([^\]]*)\]:\s*(.+)", i).captures(content) {
+        let mut info = api_call("outgoing", "request", Some("POST"), cap(&m, 1));
+        info.request_body = Some(cap(&m, 3));
+        return Some(info);
+    }
+
+    // Multipart request: api multipart call -> https://api.example.com/upload with file: ...
+    if let Some(m) = regex!(r"api multipart call -> (\S+) with (.+)", i).captures(content) {
+        let mut info = api_call("outgoing", "request", Some("POST"), cap(&m, 1));
+        info.request_body = Some(cap(&m, 2));
+        return Some(info);
+    }
+
+    // HTTP status response: HTTP POST https://api.example.com/users -> 200 (45ms)
+    if let Some(m) = regex!(r"HTTP (GET|POST|PUT|DELETE|PATCH) (\S+) -> (\d+)(?: \((\d+m?s)\))?", i).captures(content) {
+        let mut info = api_call("outgoing", "response", None, cap(&m, 2));
+        info.method = Some(m[1].to_uppercase());
+        info.status = m[3].parse().ok();
+        info.timing = m.get(4).map(|t| t.as_str().to_string());
+        return Some(info);
+    }
+
+    // GET response: api call /users {id: 1} response: {name: "John"}
+    if let Some(m) = regex!(r"api call (\S+) (\{[^}]*\}) response:\s*(.+)", i).captures(content) {
+        let mut info = api_call("outgoing", "complete", Some("GET"), cap(&m, 1));
+        info.request_body = Some(cap(&m, 2));
+        info.response_body = Some(cap(&m, 3));
+        return Some(info);
+    }
+
+    // POST response: api call -> /users with {...} -> response: {...}
+    if let Some(m) = regex!(r"api call -> (\S+) with (.+?) -> response:\s*(.+)", i).captures(content) {
+        let mut info = api_call("outgoing", "complete", Some("POST"), cap(&m, 1));
+        info.request_body = Some(cap(&m, 2));
+        info.response_body = Some(cap(&m, 3));
+        return Some(info);
+    }
+
+    // Multipart response: api multipart call -> /upload -> response: {...}
+    if let Some(m) = regex!(r"api multipart call -> (\S+) -> response:\s*(.+)", i).captures(content) {
+        let mut info = api_call("outgoing", "complete", Some("POST"), cap(&m, 1));
+        info.response_body = Some(cap(&m, 2));
+        return Some(info);
+    }
+
+    // Incoming request: /api/users <- {...}
+    if let Some(m) = regex!(r"^(\S+) <- (.+)$").captures(content) {
+        if m[1].starts_with('/') {
+            let mut info = api_call("incoming", "request", None, cap(&m, 1));
+            info.request_body = Some(cap(&m, 2));
+            return Some(info);
+        }
+    }
+
+    // Incoming response: /api/users -> {...}
+    if let Some(m) = regex!(r"^(\S+) -> (.+)$").captures(content) {
+        if m[1].starts_with('/') {
+            let mut info = api_call("incoming", "response", None, cap(&m, 1));
+            info.response_body = Some(cap(&m, 2));
+            return Some(info);
+        }
+    }
+
+    // Complete incoming: /api/users <- {...} -> {...}
+    if let Some(m) = regex!(r"^(\S+) <- (.+?) -> (.+)$").captures(content) {
+        if m[1].starts_with('/') {
+            let mut info = api_call("incoming", "complete", None, cap(&m, 1));
+            info.request_body = Some(cap(&m, 2));
+            info.response_body = Some(cap(&m, 3));
+            return Some(info);
+        }
+    }
+
+    None
+}
+
+// ============================================================================
+// Main Parsing Functions
+// ============================================================================
+
+/// Parse a single log line using all patterns, trying the file's dominant
+/// pattern (affinity) first. Also returns the index of the pattern that matched.
+pub fn parse_log_line(data: &str, affinity: Option<usize>) -> (ParsedLogLine, Option<usize>) {
+    // Strip trailing whitespace including \r (Windows line endings)
+    let clean_data = data.trim_end();
+
+    if let Some((index, mut result)) = match_patterns(clean_data, affinity) {
+        result.api_call = parse_api_call(&result.content);
+        return (result, Some(index));
+    }
+
+    // Fallback: return raw content
+    let result = ParsedLogLine {
+        content: clean_data.to_string(),
+        ..Default::default()
+    };
+    (result, None)
+}
+
+/// Normalize log entries by merging continuation lines
+pub fn normalize(logs: Vec<LogEntry>) -> Vec<LogEntry> {
+    let mut result: Vec<LogEntry> = Vec::with_capacity(logs.len());
+
+    for log in logs {
+        match result.last_mut() {
+            Some(prev) if is_continuation_line(&log.data) => {
+                // Merge with previous log
+                prev.data.push('\n');
+                prev.data.push_str(&log.data);
+            }
+            _ => result.push(log),
+        }
+    }
+
+    result
+}
+
+/// MurmurHash3 (x86, 32-bit) over the UTF-8 bytes - same as the `murmurhash` npm package's v3
+pub fn murmurhash3_32(key: &[u8], seed: u32) -> u32 {
+    const C1: u32 = 0xcc9e2d51;
+    const C2: u32 = 0x1b873593;
+
+    let mut h = seed;
+    let mut chunks = key.chunks_exact(4);
+    for chunk in &mut chunks {
+        let mut k = u32::from_le_bytes([chunk[0], chunk[1], chunk[2], chunk[3]]);
+        k = k.wrapping_mul(C1).rotate_left(15).wrapping_mul(C2);
+        h ^= k;
+        h = h.rotate_left(13).wrapping_mul(5).wrapping_add(0xe6546b64);
+    }
+
+    let tail = chunks.remainder();
+    if !tail.is_empty() {
+        let mut k: u32 = 0;
+        for (i, b) in tail.iter().enumerate() {
+            k ^= (*b as u32) << (8 * i);
+        }
+        k = k.wrapping_mul(C1).rotate_left(15).wrapping_mul(C2);
+        h ^= k;
+    }
+
+    h ^= key.len() as u32;
+    h ^= h >> 16;
+    h = h.wrapping_mul(0x85ebca6b);
+    h ^= h >> 13;
+    h = h.wrapping_mul(0xc2b2ae35);
+    h ^= h >> 16;
+    h
+}
+
+/// Generate unique hash for a log entry
+fn generate_hash(service_name: &str, content: &str, index: usize, existing_hashes: &HashSet<String>) -> String {
+    let base = murmurhash3_32(format!("{}|{}", service_name, content).as_bytes(), 0).to_string();
+    if existing_hashes.contains(&base) {
+        return format!("{}.<<{}>>", base, index);
+    }
+    base
+}
+
+/// Start of the last N lines of content, its line count (as `split('\n')`)
+/// and whether lines before the start were left out
+fn last_n_lines_start(content: &str, n: usize) -> (usize, usize, bool) {
+    let bytes = content.as_bytes();
+    let total_lines = 1 + lines::count_newlines(bytes);
+
+    if total_lines <= n {
+        return (0, total_lines, false);
+    }
+
+    // The last N lines start after the N-th newline from the end
+    let start_pos = lines::nth_newline_back(bytes, n - 1).map_or(0, |pos| pos + 1);
+    (start_pos, total_lines, true)
+}
+
+/// Check if a line is a Grafana/Loki export header (should be skipped)
+fn is_grafana_header(line: &str) -> bool {
+    let trimmed = line.trim();
+    if trimmed.is_empty() {
+        return false;
+    }
+    regex!(r#"^:\s*"[\d,]+\s+lines?\s+displayed"$"#, i).is_match(trimmed)
+        || regex!(r"^Total\s+bytes\s+processed:", i).is_match(trimmed)
+        || regex!(r"^Common\s+labels:", i).is_match(trimmed)
+}
+
+/// Parse raw file lines into LogEntry array
+fn parse_file_lines(
+    content: &str,
+    file_name: &str,
+    hash_key: &str,
+    file_path: Option<&str>,
+) -> (Vec<LogEntry>, usize, bool) {
+    let (start, total_lines, truncated) = last_n_lines_start(content, MAX_LINES);
+    let tail = &content[start..];
+    let logs = lines::with_lines(tail.as_bytes(), |spans| {
+        parse_line_spans(tail, spans, file_name, hash_key, file_path)
+    });
+
+    (logs, total_lines, truncated)
+}
+
+/// Turn the split lines of `text` into LogEntry records (lines are only
+/// copied once they become an entry)
+fn parse_line_spans(
+    text: &str,
+    spans: &[LineSpan],
+    file_name: &str,
+    hash_key: &str,
+    file_path: Option<&str>,
+) -> Vec<LogEntry> {
+    let mut logs = Vec::with_capacity(spans.len());
+    let mut existing_hashes = HashSet::new();
+    let now = Utc::now().timestamp_millis();
+
+    for (i, span) in spans.iter().enumerate() {
+        let raw_line = span.of(text);
+        let mut line: Cow<str> = Cow::Borrowed(raw_line);
+
+        // Skip empty lines
+        if line.trim().is_empty() {
+            continue;
+        }
+
+        // Skip Grafana/Loki export header lines
+        if is_grafana_header(&line) {
+            continue;
+        }
+
+        // Skip timestamp-only lines (metadata/sorting keys in some log formats)
+        if is_timestamp_only_line(&line) {
+            continue;
+        }
+
+        // Handle tab-separated epoch format:
+        // 1735123456789\t2025-12-25T10:30:00Z\t[INFO] Log message here
+        let mut timestamp: Option<i64> = None;
+
+        if let Some(tab) = memchr::memchr(b'\t', raw_line.as_bytes()) {
+            let first = raw_line[..tab].trim();
+            // Everything after the first tab (and after the second one)
+            let rest = &raw_line[tab + 1..];
+            let after_second = memchr::memchr(b'\t', rest.as_bytes()).map(|t| (&rest[..t], &rest[t + 1..]));
+            let is_epoch = regex!(r"^\d{10,}$").is_match(first);
+
+            match after_second {
+                Some((second, remainder)) if is_epoch && regex!(r"^\d{4}-\d{2}-\d{2}T").is_match(second.trim()) => {
+                    // 3-part Grafana/Loki format: epoch \t ISO_timestamp \t actual_log_line
+                    timestamp = first.parse::<f64>().ok().map(|f| f as i64);
+                    line = Cow::Borrowed(remainder);
+                }
+                _ if is_epoch => {
+                    // 2-part format: epoch \t log line
+                    timestamp = first.parse::<f64>().ok().map(|f| f as i64);
+                    line = Cow::Borrowed(rest);
+                }
+                _ if regex!(r"^\d{4}-\d{2}-\d{2}").is_match(first) => {
+                    // Replace space with T for ISO format, and comma with dot for milliseconds
+                    let date_str = first.replacen(' ', "T", 1).replacen(',', ".", 1);
+                    if let Some(parsed) = parse_js_date(&date_str) {
+                        let remainder = rest.trim();
+                        // Skip if remaining line is empty (timestamp-only metadata line)
+                        if remainder.is_empty() {
+                            continue;
+                        }
+                        timestamp = Some(parsed);
+                        // If the tab was within a log line (digits + [thread] follow), keep the original
+                        if !regex!(r"^\d+\s+\[").is_match(remainder) {
+                            line = Cow::Borrowed(remainder);
+                        }
+                    }
+                }
+                _ => {}
+            }
+        }
+
+        // Generate fake timestamp based on line order if not extracted
+        let timestamp = match timestamp {
+            Some(t) if t != 0 => t,
+            _ => now - ((spans.len() - i) as i64) * 1000,
+        };
+
+        let hash = generate_hash(hash_key, &line, i, &existing_hashes);
+        existing_hashes.insert(hash.clone());
+
+        logs.push(LogEntry {
+            name: file_name.to_string(),
+            file_path: file_path.map(|p| p.to_string()),
+            data: line.into_owned(),
+            is_err: false,
+            hash: Some(hash),
+            timestamp: Some(timestamp),
+            sort_index: None,
+            parsed: None,
+        });
+    }
+
+    logs
+}
+
+// ============================================================================
+// Timestamps
+// ============================================================================
+
+/// Parse a date string the way V8's `Date.parse` does, for the strings the
+/// parsers pass it (they start with a `YYYY-MM-DD` date). ECMAScript
+/// date-time strings are tried first: date-only forms are UTC, date-time
+/// forms without an offset are local time. Anything else goes through V8's
+/// legacy grammar, of which the forms found in logs are supported: a space
+/// before the time, 1-digit fields, AM/PM, `Z`/`UTC`/`GMT` and offsets
+/// like `+01`, `+0100` or `+01:00` (local time without one) and a trailing
+/// `(comment)`. The fixtures in spec/fixtures/js-dates.json are checked
+/// against both this and V8 (scripts/check-js-dates.js).
+pub fn parse_js_date(s: &str) -> Option<i64> {
+    match regex!(r"^([+-]\d{6}|\d{4})(?:-(\d{2})(?:-(\d{2}))?)?(?:T(\d{2}):(\d{2})(?::(\d{2})(?:\.(\d+))?)?)?(Z|[+-]\d{2}:?\d{2})?$").captures(s) {
+        Some(m) => parse_iso_date(&m),
+        None => parse_legacy_date(s),
+    }
+}
+
+/// Capture group `i` as a number (`default` if it didn't participate)
+fn date_field(m: &regex::Captures, i: usize, default: u32) -> Option<u32> {
+    match m.get(i) {
+        Some(g) => g.as_str().parse().ok(),
+        None => Some(default),
+    }
+}
+
+/// Milliseconds of a fraction of a second (digits past the third are ignored)
+fn date_millis(m: &regex::Captures, i: usize) -> u32 {
+    m.get(i)
+        .map(|f| {
+            let digits: String = f.as_str().chars().chain("000".chars()).take(3).collect();
+            digits.parse::<u32>().unwrap_or(0)
+        })
+        .unwrap_or(0)
+}
+
+/// ECMAScript date-time string (see parse_js_date)
+fn parse_iso_date(m: &regex::Captures) -> Option<i64> {
+    if &m[1] == "-000000" {
+        return None;
+    }
+    let year: i32 = m[1].parse().ok()?;
+    let has_time = m.get(4).is_some();
+    let zone = m.get(8).map(|z| z.as_str());
+    if !has_time && zone.is_some() {
+        return None;
+    }
+
+    let time = (date_field(m, 4, 0)?, date_field(m, 5, 0)?, date_field(m, 6, 0)?, date_millis(m, 7));
+    let offset = match zone {
+        _ if !has_time => Some(0),
+        None => None,
+        Some("Z") => Some(0),
+        Some(offset) => {
+            let sign: i64 = if offset.starts_with('-') { -1 } else { 1 };
+            let hours: i64 = offset[1..3].parse().ok()?;
+            let minutes: i64 = offset[offset.len() - 2..].parse().ok()?;
+            if hours > 23 || minutes > 59 {
+                return None;
+            }
+            Some(sign * (hours * 60 + minutes))
+        }
+    };
+    js_epoch(year, date_field(m, 2, 1)?, date_field(m, 3, 1)?, time, offset)
+}
+
+/// `YYYY-M-D[ H:M[:S[.fff]]]` in V8's legacy grammar (see parse_js_date)
+fn parse_legacy_date(s: &str) -> Option<i64> {
+    let m = regex!(r"^(\d{4})-(\d{1,2})-(\d{1,2})(?:\s+(\d{1,2}):(\d{1,2})(?::(\d{1,2})(?:\.(\d+))?)?)?(?:\s+(am|pm))?(?:\s*(z)|\s+(utc|gmt))?(?:\s*([+-])(?:(\d{1,2}):(\d{2})|(\d{1,4})))?(?:\s*\([^)]*\))*\s*$", i).captures(s)?;
+
+    let mut hour = date_field(&m, 4, 0)?;
+    if let Some(meridiem) = m.get(8) {
+        if hour > 12 {
+            return None;
+        }
+        let pm = meridiem.as_str().eq_ignore_ascii_case("pm");
+        hour = match (hour, pm) {
+            (12, false) => 0,
+            (h, true) if h < 12 => h + 12,
+            (h, _) => h,
+        };
+    }
+    let time = (hour, date_field(&m, 5, 0)?, date_field(&m, 6, 0)?, date_millis(&m, 7));
+
+    // Offsets count from UTC; a UTC marker alone is +00:00, neither is local time
+    let offset = match m.get(11) {
+        Some(sign) => {
+            let sign: i64 = if sign.as_str() == "-" { -1 } else { 1 };
+            let (hours, minutes): (i64, i64) = match (m.get(12), m.get(13), m.get(14)) {
+                (Some(h), Some(min), _) => (h.as_str().parse().ok()?, min.as_str().parse().ok()?),
+                (_, _, Some(digits)) if digits.as_str().len() <= 2 => (digits.as_str().parse().ok()?, 0),
+                (_, _, Some(digits)) => {
+                    let n: i64 = digits.as_str().parse().ok()?;
+                    (n / 100, n % 100)
+                }
+                _ => return None,
+            };
+            Some(sign * (hours * 60 + minutes))
+        }
+        None if m.get(9).is_some() || m.get(10).is_some() => Some(0),
+        None => None,
+    };
+    js_epoch(m[1].parse().ok()?, date_field(&m, 2, 1)?, date_field(&m, 3, 1)?, time, offset)
+}
+
+/// Epoch of a date and (hour, minute, second, millis) at `offset` minutes
+/// east of UTC, or in local time. Like `Date`, days past the end of the
+/// month (up to 31) roll over into the next one and 24:00 is the next
+/// midnight.
+fn js_epoch(year: i32, month: u32, day: u32, time: (u32, u32, u32, u32), offset: Option<i64>) -> Option<i64> {
+    if !(1..=12).contains(&month) || !(1..=31).contains(&day) {
+        return None;
+    }
+    let date = NaiveDate::from_ymd_opt(year, month, 1)?.checked_add_signed(chrono::Duration::days(day as i64 - 1))?;
+    let (hour, minute, second, millis) = time;
+    let naive = if hour == 24 && minute == 0 && second == 0 && millis == 0 {
+        NaiveDateTime::new(date.succ_opt()?, NaiveTime::MIN)
+    } else {
+        NaiveDateTime::new(date, NaiveTime::from_hms_milli_opt(hour, minute, second, millis)?)
+    };
+
+    match offset {
+        Some(minutes) => Some(Utc.from_utc_datetime(&naive).timestamp_millis() - minutes * 60_000),
+        None => {
+            // Local time; inside a DST gap JS moves forward, so try an hour later
+            Local
+                .from_local_datetime(&naive)
+                .earliest()
+                .or_else(|| Local.from_local_datetime(&(naive + chrono::Duration::hours(1))).earliest())
+                .map(|dt| dt.timestamp_millis())
+        }
+    }
+}
+
+/// Check if a timestamp string includes a date component
+pub fn timestamp_has_date(timestamp: &str) -> bool {
+    regex!(r"\d{4}-\d{2}-\d{2}").is_match(timestamp)
+}
+
+/// Convert a parsed timestamp string to epoch milliseconds
+/// (see parseTimestampToEpoch in parser.ts for the supported formats)
+pub fn parse_timestamp_to_epoch(timestamp: &str) -> Option<i64> {
+    if timestamp.is_empty() {
+        return None;
+    }
+
+    // Normalize: comma → dot for milliseconds
+    let mut normalized = timestamp.replacen(',', ".", 1);
+
+    // If it's time-only (no date), prepend today's date
+    if regex!(r"^\d{2}:\d{2}:\d{2}").is_match(&normalized) && !normalized.contains('-') {
+        normalized = format!("{} {}", Utc::now().format("%Y-%m-%d"), normalized);
+    }
+
+    // Normalize: space → T for ISO format if needed
+    if regex!(r"^\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}").is_match(&normalized) {
+        normalized = regex!(r"\s+").replace(&normalized, "T").into_owned();
+    }
+
+    parse_js_date(&normalized)
+}
+
+/// Epoch of a raw line's timestamp when it has a date (the pattern
+/// parse_log_line would pick without affinity; pattern counters are left
+/// alone). Used for the time index in index.rs.
+pub fn line_epoch(line: &str) -> Option<i64> {
+    let line = line.trim_end();
+    let parsed = PATTERNS.iter().find_map(|pattern| (pattern.parse)(line))?;
+    parsed
+        .timestamp
+        .filter(|t| !t.is_empty() && timestamp_has_date(t))
+        .and_then(|t| parse_timestamp_to_epoch(&t))
+}
+
+/// Recalculate timestamp and sortIndex for log entries.
+/// Handles backfilling when first real timestamp is found.
+pub fn recalculate_timestamps(logs: &mut [LogEntry]) {
+    let mut last_timestamp: i64 = 0;
+    let mut last_sort_index: i64 = 0;
+    let mut first_real_timestamp: Option<i64> = None;
+
+    for i in 0..logs.len() {
+        let real_timestamp = logs[i]
+            .parsed
+            .as_ref()
+            .and_then(|p| p.timestamp.as_deref())
+            .filter(|t| !t.is_empty() && timestamp_has_date(t))
+            .and_then(parse_timestamp_to_epoch);
+
+        match real_timestamp {
+            Some(epoch) => {
+                logs[i].timestamp = Some(epoch);
+                logs[i].sort_index = Some(0);
+                last_sort_index = 0;
+
+                if first_real_timestamp.is_none() {
+                    first_real_timestamp = Some(epoch);
+                    for j in 0..i {
+                        logs[j].timestamp = Some(epoch);
+                        logs[j].sort_index = Some(j as i64 - i as i64);
+                    }
+                }
+            }
+            None => {
+                last_sort_index += 1;
+                logs[i].sort_index = Some(last_sort_index);
+                logs[i].timestamp = Some(if first_real_timestamp.is_some() { last_timestamp } else { 0 });
+            }
+        }
+
+        let ts = logs[i].timestamp.unwrap_or(0);
+        if ts != 0 {
+            last_timestamp = ts;
+        }
+    }
+}
+
+/// Parse a complete log file into structured log entries
+/// `file_path` is used for hash uniqueness in multi-file mode
+pub fn parse_log_file(content: &str, file_name: &str, file_path: Option<&str>) -> ParsedLogFileResult {
+    // Use filePath for hash generation to ensure uniqueness across files
+    let hash_key = file_path.unwrap_or(file_name);
+    let (raw_logs, total_lines, truncated) = parse_file_lines(content, file_name, hash_key, file_path);
+    let mut logs = normalize(raw_logs);
+
+    // Format affinity: reuse the dominant pattern detected for this file,
+    // or detect it from the first lines
+    let cached = format_cache().lock().unwrap().get(hash_key).copied();
+    let mut affinity = cached;
+
+    // Detect the format from the first lines, unless it is known
+    let mut sampled = 0;
+    if affinity.is_none() {
+        let mut wins = [0usize; PATTERN_COUNT];
+        for log in logs.iter_mut().take(AFFINITY_SAMPLE_LINES) {
+            let (parsed, matched) = parse_log_line(&log.data, None);
+            log.parsed = Some(parsed);
+            if let Some(i) = matched {
+                wins[i] += 1;
+            }
+            sampled += 1;
+        }
+        if sampled == AFFINITY_SAMPLE_LINES {
+            affinity = dominant_pattern(&wins, sampled);
+        }
+    }
+
+    // Parse the remaining lines to extract structured data (on the load
+    // pool when there are many: entries are independent once continuation
+    // lines are merged)
+    let parse = |log: &mut LogEntry| {
+        let (parsed, matched) = parse_log_line(&log.data, affinity);
+        log.parsed = Some(parsed);
+        matched
+    };
+    let rest = &mut logs[sampled..];
+    let matches: Vec<Option<usize>> = if rest.len() >= PARALLEL_PARSE_MIN_LINES && pool::load_threads() > 1 {
+        pool::load_pool().install(|| rest.par_iter_mut().map(parse).collect())
+    } else {
+        rest.iter_mut().map(parse).collect()
+    };
+    let (affinity_hits, affinity_misses) = match affinity {
+        Some(k) => {
+            let hits = matches.iter().filter(|&&m| m == Some(k)).count();
+            (hits, matches.len() - hits)
+        }
+        None => (0, 0),
+    };
+
+    // Remember the detected format; forget it if the file stopped matching
+    // (e.g. it was replaced by a different log)
+    if affinity_misses > affinity_hits {
+        format_cache().lock().unwrap().remove(hash_key);
+    } else if let Some(k) = affinity {
+        if cached != Some(k) {
+            format_cache().lock().unwrap().insert(hash_key.to_string(), k);
+        }
+    }
+
+    // Calculate timestamp and sortIndex for all logs
+    recalculate_timestamps(&mut logs);
+
+    ParsedLogFileResult {
+        logs,
+        total_lines,
+        truncated,
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn fixture_time(s: &str) -> NaiveDateTime {
+        NaiveDateTime::parse_from_str(s, "%Y-%m-%dT%H:%M:%S%.3f").unwrap()
+    }
+
+    /// spec/fixtures/js-dates.json (checked against Date.parse by scripts/check-js-dates.js)
+    #[test]
+    fn parse_js_date_matches_date_parse() {
+        let fixtures: serde_json::Value =
+            serde_json::from_str(include_str!("../../spec/fixtures/js-dates.json")).unwrap();
+        for case in fixtures["cases"].as_array().unwrap() {
+            let input = case["input"].as_str().unwrap();
+            let expected = case["expected"].as_str().map(|e| match e.strip_suffix('Z') {
+                Some(utc) => Utc.from_utc_datetime(&fixture_time(utc)).timestamp_millis(),
+                None => Local.from_local_datetime(&fixture_time(e)).earliest().unwrap().timestamp_millis(),
+            });
+            assert_eq!(parse_js_date(input), expected, "{}", input);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+//! Thread pool for loading files
+//!
+//! Initial loads split their work across this pool: indexing a large file
+//! counts newlines in newline-aligned chunks (index.rs), and the lines of a
+//! read are parsed in parallel (parse_log_file in parser.rs). Its size
+//! follows the `loadThreads` setting (0 = one thread per core, 1 = load
+//! serially); the pool is rebuilt when the setting changes.
+
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex, OnceLock};
+
+// Configured thread count (0 = rayon's default, one per core)
+static LOAD_THREADS: AtomicUsize = AtomicUsize::new(0);
+
+/// The pool and the thread count it was built with
+struct LoadPool {
+    threads: usize,
+    pool: Arc<rayon::ThreadPool>,
+}
+
+fn current() -> &'static Mutex<Option<LoadPool>> {
+    static POOL: OnceLock<Mutex<Option<LoadPool>>> = OnceLock::new();
+    POOL.get_or_init(|| Mutex::new(None))
+}
+
+/// Number of threads loads are split across (the configured count, or the
+/// number of cores)
+pub fn load_threads() -> usize {
+    match LOAD_THREADS.load(Ordering::Relaxed) {
+        0 => std::thread::available_parallelism().map_or(1, |n| n.get()),
+        n => n,
+    }
+}
+
+/// Thread pool for loads (kept apart from Tauri's async runtime and from
+/// the search pool, so a long search doesn't hold up opening a file)
+pub fn load_pool() -> Arc<rayon::ThreadPool> {
+    let threads = LOAD_THREADS.load(Ordering::Relaxed);
+    let mut current = current().lock().unwrap();
+    match current.as_ref() {
+        Some(pool) if pool.threads == threads => pool.pool.clone(),
+        _ => {
+            let pool = Arc::new(
+                rayon::ThreadPoolBuilder::new()
+                    .num_threads(threads)
+                    .thread_name(|i| format!("mocha-load-{}", i))
+                    .build()
+                    .expect("failed to create load thread pool"),
+            );
+            *current = Some(LoadPool { threads, pool: pool.clone() });
+            pool
+        }
+    }
+}
+
+/// Set the number of threads used to load files (0 = one per core). Loads
+/// already running finish on the old pool.
+#[tauri::command]
+pub fn set_load_threads(threads: usize) -> bool {
+    LOAD_THREADS.store(threads, Ordering::Relaxed);
+    true
+}
@@ -0,0 +1,728 @@
+//! File search over memory-mapped files
+//!
+//! Jump-to-source scans chunks with memchr's SIMD substring search, so it
+//! touches only the pages it needs and stops at the first match. Full-text
+//! search splits the file into line-aligned chunks, scans them in parallel on
+//! a dedicated thread pool and streams match batches as events.
+//! Long searches report progress as events and can be cancelled by id.
+//! Compressed files (see compressed.rs) are decoded as they are scanned:
+//! jump-to-source stops decoding at the match and reads its context through
+//! the line index; full-text search decodes the file into memory.
+
+use memchr::memmem;
+use memmap2::Mmap;
+use rayon::prelude::*;
+use regex::bytes::{Regex, RegexBuilder};
+use serde::Serialize;
+use std::collections::HashMap;
+use std::io::{self, Read, Seek, SeekFrom};
+use std::ops::Deref;
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
+use std::sync::{Arc, Mutex, OnceLock};
+use tauri::{AppHandle, Emitter};
+
+use crate::compressed::{is_compressed, LogFile};
+use crate::index::{has_index, with_index, LineIndex};
+use crate::lines;
+
+/// Event emitted while a long search runs
+pub const SEARCH_PROGRESS_EVENT: &str = "search-progress";
+/// Event carrying a batch of search_file matches
+pub const SEARCH_MATCHES_EVENT: &str = "search-matches";
+
+// Bytes scanned between progress reports / cancellation checks
+const SEARCH_CHUNK_SIZE: usize = 64 * 1024 * 1024;
+// Decoded bytes held at a time when looking for a line in a compressed file
+const STREAM_CHUNK_SIZE: u64 = 4 * 1024 * 1024;
+// Bytes per parallel search_file task (one match batch per chunk)
+const PARALLEL_CHUNK_SIZE: usize = 4 * 1024 * 1024;
+// Stop search_file after this many matching lines
+const MAX_SEARCH_MATCHES: usize = 10_000;
+// Snippet length around a match (long lines are cut)
+const MAX_SNIPPET_BYTES: usize = 240;
+const SNIPPET_LEAD_BYTES: usize = 80;
+
+/// Payload for the search-progress event
+#[derive(Serialize, Clone)]
+#[serde(rename_all = "camelCase")]
+pub struct SearchProgressEvent {
+    pub search_id: String,
+    pub scanned: u64, // Bytes scanned so far
+    pub total: u64,   // File size in bytes
+}
+
+// ============================================================================
+// Cancellation
+// ============================================================================
+
+/// Cancel flags of running searches (by frontend-provided search id)
+fn active_searches() -> &'static Mutex<HashMap<String, Arc<AtomicBool>>> {
+    static ACTIVE: OnceLock<Mutex<HashMap<String, Arc<AtomicBool>>>> = OnceLock::new();
+    ACTIVE.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+/// A running search: registered while alive so cancel_search can reach it
+struct SearchHandle {
+    id: Option<String>,
+    cancelled: Arc<AtomicBool>,
+}
+
+impl SearchHandle {
+    fn register(id: Option<String>) -> Self {
+        let cancelled = Arc::new(AtomicBool::new(false));
+        if let Some(id) = &id {
+            active_searches().lock().unwrap().insert(id.clone(), cancelled.clone());
+        }
+        SearchHandle { id, cancelled }
+    }
+
+    fn is_cancelled(&self) -> bool {
+        self.cancelled.load(Ordering::Relaxed)
+    }
+
+    /// Report progress to the frontend (only searches with an id are listened to)
+    fn progress(&self, app: &AppHandle, scanned: u64, total: u64) {
+        if let Some(id) = &self.id {
+            let event = SearchProgressEvent {
+                search_id: id.clone(),
+                scanned,
+                total,
+            };
+            let _ = app.emit(SEARCH_PROGRESS_EVENT, event);
+        }
+    }
+}
+
+impl Drop for SearchHandle {
+    fn drop(&mut self) {
+        if let Some(id) = &self.id {
+            let mut active = active_searches().lock().unwrap();
+            // Only remove our own flag (the id may have been reused by a newer search)
+            if active.get(id).is_some_and(|flag| Arc::ptr_eq(flag, &self.cancelled)) {
+                active.remove(id);
+            }
+        }
+    }
+}
+
+/// Cancel a running search. Returns false if no search with that id is running.
+#[tauri::command]
+pub fn cancel_search(search_id: String) -> bool {
+    match active_searches().lock().unwrap().get(&search_id) {
+        Some(flag) => {
+            flag.store(true, Ordering::Relaxed);
+            true
+        }
+        None => false,
+    }
+}
+
+// ============================================================================
+// Scanning helpers
+// ============================================================================
+
+/// Content of a file being searched
+enum FileData {
+    Mapped(Mmap),
+    Decoded(Vec<u8>), // Compressed file, decompressed into memory
+}
+
+impl Deref for FileData {
+    type Target = [u8];
+
+    fn deref(&self) -> &[u8] {
+        match self {
+            FileData::Mapped(map) => map,
+            FileData::Decoded(data) => data,
+        }
+    }
+}
+
+/// Map a file read-only. Empty files can't be mapped and yield None.
+fn map_file(path: &str) -> io::Result<Option<FileData>> {
+    let file = match LogFile::open(path)? {
+        LogFile::Plain(file) => file,
+        LogFile::Compressed(mut file) => {
+            let mut data = Vec::new();
+            file.read_to_end(&mut data)?;
+            return Ok(Some(FileData::Decoded(data)));
+        }
+    };
+    if file.metadata()?.len() == 0 {
+        return Ok(None);
+    }
+    // Safety: the mapping is read-only. A log truncated while we scan it can
+    // still fault, which is the accepted trade-off for not copying the file.
+    unsafe { Mmap::map(&file) }.map(|map| Some(FileData::Mapped(map)))
+}
+
+/// Does `data[start..end]` span whole lines (\n or \r\n line endings)?
+fn is_whole_line(data: &[u8], start: usize, end: usize) -> bool {
+    let starts_line = start == 0 || data[start - 1] == b'\n';
+    let ends_line = end == data.len()
+        || data[end] == b'\n'
+        || (data[end] == b'\r' && (end + 1 == data.len() || data[end + 1] == b'\n'));
+    starts_line && ends_line
+}
+
+/// Find the first occurrence of `needle` as whole line(s), scanning chunk by chunk.
+/// Returns Err(()) if the search was cancelled.
+fn find_line(
+    data: &[u8],
+    needle: &[u8],
+    handle: &SearchHandle,
+    mut on_progress: impl FnMut(u64),
+) -> Result<Option<usize>, ()> {
+    let finder = memmem::Finder::new(needle);
+    let mut chunk_start = 0;
+
+    while chunk_start < data.len() {
+        let chunk_end = (chunk_start + SEARCH_CHUNK_SIZE).min(data.len());
+        // Overlap so matches crossing the chunk boundary are found
+        let window_end = (chunk_end + needle.len() - 1).min(data.len());
+
+        for pos in finder.find_iter(&data[chunk_start..window_end]) {
+            let start = chunk_start + pos;
+            if start >= chunk_end {
+                break; // Belongs to the next chunk
+            }
+            if is_whole_line(data, start, start + needle.len()) {
+                return Ok(Some(start));
+            }
+        }
+
+        chunk_start = chunk_end;
+        if handle.is_cancelled() {
+            return Err(());
+        }
+        on_progress(chunk_start as u64);
+    }
+
+    Ok(None)
+}
+
+/// find_line over a file read piece by piece (compressed files are decoded
+/// only up to the match). Cancellation is returned as ErrorKind::Interrupted.
+fn find_line_streaming(
+    file: &mut LogFile,
+    needle: &[u8],
+    handle: &SearchHandle,
+    mut on_progress: impl FnMut(u64),
+) -> io::Result<Option<u64>> {
+    let finder = memmem::Finder::new(needle);
+    // Kept from the previous piece: a match that may continue into the next
+    // one plus the byte before it (to check it starts a line)
+    let keep = needle.len() + 2;
+    let mut buf = Vec::new();
+    let mut buf_start = 0u64; // File offset of buf[0]
+    file.seek(SeekFrom::Start(0))?;
+
+    loop {
+        let dropped = buf.len().saturating_sub(keep);
+        buf.drain(..dropped);
+        buf_start += dropped as u64;
+        let at_end = (&mut *file).take(STREAM_CHUNK_SIZE).read_to_end(&mut buf)? == 0;
+
+        for pos in finder.find_iter(&buf) {
+            if pos == 0 && buf_start > 0 {
+                continue; // Checked with the previous piece
+            }
+            let end = pos + needle.len();
+            if !at_end && end + 2 > buf.len() {
+                break; // Needs the next piece to check the line end
+            }
+            if is_whole_line(&buf, pos, end) {
+                return Ok(Some(buf_start + pos as u64));
+            }
+        }
+
+        if at_end {
+            return Ok(None);
+        }
+        if handle.is_cancelled() {
+            return Err(io::Error::new(io::ErrorKind::Interrupted, "Search cancelled"));
+        }
+        on_progress(buf_start + buf.len() as u64);
+    }
+}
+
+/// Byte range covering the lines [start, end) plus `context` lines on each side
+fn context_range(data: &[u8], start: usize, end: usize, context: usize) -> (usize, usize) {
+    let mut from = start;
+    for _ in 0..context {
+        if from == 0 {
+            break;
+        }
+        from = match memchr::memrchr(b'\n', &data[..from - 1]) {
+            Some(p) => p + 1,
+            None => 0,
+        };
+    }
+
+    // End of the matched line, then `context` more lines
+    let mut to = match memchr::memchr(b'\n', &data[end..]) {
+        Some(p) => end + p,
+        None => data.len(),
+    };
+    for _ in 0..context {
+        if to >= data.len() {
+            break;
+        }
+        to = match memchr::memchr(b'\n', &data[to + 1..]) {
+            Some(p) => to + 1 + p,
+            None => data.len(),
+        };
+    }
+
+    (from, to)
+}
+
+// ============================================================================
+// Jump to source
+// ============================================================================
+
+/// Result for search_file_for_line command
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct SearchLineResult {
+    pub success: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub content: Option<String>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub line_number: Option<usize>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub start_line: Option<usize>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub total_lines: Option<usize>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub error: Option<String>,
+}
+
+fn search_line_error(error: &str, total_lines: Option<usize>) -> SearchLineResult {
+    SearchLineResult {
+        success: false,
+        content: None,
+        line_number: None,
+        start_line: None,
+        total_lines,
+        error: Some(error.to_string()),
+    }
+}
+
+/// Line number of `offset` and total line count (like `str::lines().count()`).
+/// Taken from the file's line-offset index if it has one; otherwise the
+/// newlines of the mapping are counted rather than indexing the whole file
+/// for one lookup.
+fn line_numbers(path: &str, data: &[u8], offset: usize) -> io::Result<(usize, usize)> {
+    let (line, mut total) = if has_index(path) {
+        with_index(path, |index, file| {
+            let line = index.line_at_offset(file, offset as u64)?;
+            Ok((line as usize, index.total_lines() as usize))
+        })?
+    } else {
+        let line = lines::count_newlines(&data[..offset]);
+        (line, line + lines::count_newlines(&data[offset..]) + 1)
+    };
+    if data.last() == Some(&b'\n') {
+        total -= 1; // No line after the final newline
+    }
+    Ok((line, total))
+}
+
+/// Search for a specific line (or multi-line entry) in a file and return surrounding context.
+/// Used for "jump to source" when the log is outside the truncated view.
+/// Pass `search_id` to get search-progress events and be able to cancel_search.
+#[tauri::command(async)]
+pub fn search_file_for_line(
+    app: AppHandle,
+    path: String,
+    search_line: String,
+    context_lines: usize,
+    search_id: Option<String>,
+) -> SearchLineResult {
+    let handle = SearchHandle::register(search_id);
+    locate_line(&path, &search_line, context_lines, &handle, |scanned, total| {
+        handle.progress(&app, scanned, total)
+    })
+}
+
+/// search_file_for_line without progress events or cancellation (benchmarks)
+pub fn search_line(path: &str, search_line: &str, context_lines: usize) -> SearchLineResult {
+    locate_line(path, search_line, context_lines, &SearchHandle::register(None), |_, _| {})
+}
+
+fn locate_line(
+    path: &str,
+    search_line: &str,
+    context_lines: usize,
+    handle: &SearchHandle,
+    progress: impl Fn(u64, u64),
+) -> SearchLineResult {
+    if path.is_empty() || search_line.is_empty() {
+        return search_line_error("Invalid parameters", None);
+    }
+
+    if is_compressed(path) {
+        return locate_compressed(path, search_line, context_lines, handle, progress);
+    }
+
+    let mmap = match map_file(path) {
+        Ok(m) => m,
+        Err(_) => return search_line_error("Cannot read file", None),
+    };
+    let data: &[u8] = mmap.as_deref().unwrap_or(&[]);
+
+    let total_size = data.len() as u64;
+    let found = find_line(data, search_line.as_bytes(), handle, |scanned| progress(scanned, total_size));
+
+    let found = match found {
+        Ok(f) => f,
+        Err(()) => return search_line_error("Search cancelled", None),
+    };
+
+    let start = match found {
+        Some(start) => start,
+        None => {
+            let total = line_numbers(path, data, 0).ok().map(|(_, total)| total);
+            return search_line_error("Line not found in file", total);
+        }
+    };
+
+    let (line, total_lines) = match line_numbers(path, data, start) {
+        Ok(n) => n,
+        Err(_) => return search_line_error("Cannot read file", None),
+    };
+
+    // Extract lines with context
+    let (from, to) = context_range(data, start, start + search_line.len(), context_lines);
+    let lines_before = memchr::memchr_iter(b'\n', &data[from..start]).count();
+
+    SearchLineResult {
+        success: true,
+        content: Some(String::from_utf8_lossy(&data[from..to]).into_owned()),
+        line_number: Some(line + 1), // 1-indexed
+        start_line: Some(line - lines_before),
+        total_lines: Some(total_lines),
+        error: None,
+    }
+}
+
+/// Total line count like line_numbers (no line after a final newline)
+fn counted_lines(index: &LineIndex, file: &mut LogFile) -> io::Result<usize> {
+    let mut total = index.total_lines() as usize;
+    if index.size() > 0 {
+        let mut last = [0u8; 1];
+        file.seek(SeekFrom::Start(index.size() - 1))?;
+        file.read_exact(&mut last)?;
+        if last[0] == b'\n' {
+            total -= 1;
+        }
+    }
+    Ok(total)
+}
+
+/// locate_line for compressed files: decode until the line is found, then
+/// read the lines around it from the nearest seek point
+fn locate_compressed(
+    path: &str,
+    search_line: &str,
+    context_lines: usize,
+    handle: &SearchHandle,
+    progress: impl Fn(u64, u64),
+) -> SearchLineResult {
+    let needle = search_line.as_bytes();
+    let located = with_index(path, |index, file| {
+        let total_size = index.size();
+        let found = find_line_streaming(file, needle, handle, |scanned| progress(scanned, total_size))?;
+        let total_lines = counted_lines(index, file)?;
+        let Some(start) = found else {
+            return Ok(search_line_error("Line not found in file", Some(total_lines)));
+        };
+
+        let line = index.line_at_offset(file, start)?;
+        let last_line = line + memchr::memchr_iter(b'\n', needle).count() as u64;
+        let from = line.saturating_sub(context_lines as u64);
+        let to = (last_line + 1 + context_lines as u64).min(index.total_lines());
+        let content = index.read_range(file, from, to)?;
+
+        Ok(SearchLineResult {
+            success: true,
+            content: Some(String::from_utf8_lossy(&content).into_owned()),
+            line_number: Some(line as usize + 1), // 1-indexed
+            start_line: Some(from as usize),
+            total_lines: Some(total_lines),
+            error: None,
+        })
+    });
+
+    match located {
+        Ok(result) => result,
+        Err(e) if e.kind() == io::ErrorKind::Interrupted => search_line_error("Search cancelled", None),
+        Err(_) => search_line_error("Cannot read file", None),
+    }
+}
+
+// ============================================================================
+// Full-text search
+// ============================================================================
+
+/// One matching line
+#[derive(Serialize, Clone)]
+#[serde(rename_all = "camelCase")]
+pub struct SearchMatch {
+    pub line_number: usize, // 1-indexed
+    pub offset: usize,      // Byte offset of the match
+    pub snippet: String,    // The matching line (cut around the match if long)
+}
+
+/// Payload for the search-matches event. Batches arrive in file order.
+#[derive(Serialize, Clone)]
+#[serde(rename_all = "camelCase")]
+pub struct SearchMatchesEvent {
+    pub search_id: String,
+    pub path: String,
+    pub matches: Vec<SearchMatch>,
+}
+
+/// Result for search_file command (sent once the scan is complete)
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct SearchFileResult {
+    pub success: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub match_count: Option<usize>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub truncated: Option<bool>, // Matches past MAX_SEARCH_MATCHES were dropped
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub error: Option<String>,
+}
+
+fn search_file_error(error: &str) -> SearchFileResult {
+    SearchFileResult {
+        success: false,
+        match_count: None,
+        truncated: None,
+        error: Some(error.to_string()),
+    }
+}
+
+/// Thread pool for search_file (kept apart from Tauri's async runtime)
+fn search_pool() -> &'static rayon::ThreadPool {
+    static POOL: OnceLock<rayon::ThreadPool> = OnceLock::new();
+    POOL.get_or_init(|| {
+        rayon::ThreadPoolBuilder::new()
+            .thread_name(|i| format!("mocha-search-{}", i))
+            .build()
+            .expect("failed to create search thread pool")
+    })
+}
+
+/// Compile a toolbar query: case-insensitive like the frontend search,
+/// with `^`/`$` matching at line boundaries. Regex queries are compiled
+/// without Unicode classes, so `\d`, `\w` and `\b` are ASCII like a
+/// JavaScript RegExp (non-ASCII literals still match as UTF-8).
+fn search_regex(query: &str, is_regex: bool) -> Result<Regex, regex::Error> {
+    let source = if is_regex { query.to_string() } else { regex::escape(query) };
+    RegexBuilder::new(&format!("(?mR){}", source))
+        .case_insensitive(true)
+        .unicode(!is_regex)
+        .build()
+}
+
+/// Move `pos` back to the start of a UTF-8 character
+fn char_boundary(data: &[u8], mut pos: usize, min: usize) -> usize {
+    while pos > min && (data[pos] & 0xC0) == 0x80 {
+        pos -= 1;
+    }
+    pos
+}
+
+/// The line [line_start, line_end) cut to MAX_SNIPPET_BYTES around a match at `pos`
+fn snippet(data: &[u8], line_start: usize, line_end: usize, pos: usize) -> String {
+    let mut from = line_start;
+    let mut to = line_end;
+    if to - from > MAX_SNIPPET_BYTES {
+        from = char_boundary(data, pos.saturating_sub(SNIPPET_LEAD_BYTES).max(line_start), line_start);
+        to = (from + MAX_SNIPPET_BYTES).min(line_end);
+        if to < line_end {
+            to = char_boundary(data, to, from);
+        }
+    }
+    String::from_utf8_lossy(&data[from..to]).into_owned()
+}
+
+/// Up to `limit` matching lines in chunk [start, end), which begins at line
+/// `first_line`. The flag is set if the limit left a match out.
+fn search_chunk(
+    data: &[u8],
+    (start, end): (usize, usize),
+    first_line: usize,
+    regex: &Regex,
+    limit: usize,
+) -> (Vec<SearchMatch>, bool) {
+    let chunk = &data[..end];
+    let mut matches = Vec::new();
+    let mut line = first_line;
+    let mut counted = start; // Newlines before here are counted in `line`
+    let mut at = start;
+
+    while at < end {
+        let m = match regex.find_at(chunk, at) {
+            Some(m) => m,
+            None => break,
+        };
+        let pos = m.start();
+        if pos >= end {
+            break;
+        }
+        if matches.len() == limit {
+            return (matches, true);
+        }
+
+        line += memchr::memchr_iter(b'\n', &data[counted..pos]).count();
+        counted = pos;
+        let line_start = match memchr::memrchr(b'\n', &data[start..pos]) {
+            Some(p) => start + p + 1,
+            None => start,
+        };
+        let newline = memchr::memchr(b'\n', &data[pos..end]).map(|p| pos + p);
+        let mut line_end = newline.unwrap_or(end);
+        if line_end > line_start && data[line_end - 1] == b'\r' {
+            line_end -= 1;
+        }
+
+        matches.push(SearchMatch {
+            line_number: line + 1,
+            offset: pos,
+            snippet: snippet(data, line_start, line_end, pos),
+        });
+
+        // One match per line: continue on the next line
+        at = match newline {
+            Some(n) => n + 1,
+            None => end,
+        };
+    }
+
+    (matches, false)
+}
+
+/// Whether chunk [start, end) has a match
+fn chunk_matches(data: &[u8], (start, end): (usize, usize), regex: &Regex) -> bool {
+    regex.find_at(&data[..end], start).is_some_and(|m| m.start() < end)
+}
+
+/// Search a whole file for `query` (plain text or regex, case-insensitive).
+/// Matching lines stream to the frontend as search-matches events tagged with
+/// `search_id`, in file order; the result is returned once the scan is done.
+/// Past MAX_SEARCH_MATCHES the first matches in the file are kept.
+#[tauri::command(async)]
+pub fn search_file(
+    app: AppHandle,
+    path: String,
+    query: String,
+    is_regex: bool,
+    search_id: String,
+) -> SearchFileResult {
+    if path.is_empty() || query.is_empty() {
+        return search_file_error("Invalid parameters");
+    }
+    let regex = match search_regex(&query, is_regex) {
+        Ok(r) => r,
+        Err(_) => return search_file_error("Invalid regex"),
+    };
+
+    // Registered before reading so a cancel during a slow decompress is seen
+    let handle = SearchHandle::register(Some(search_id.clone()));
+    let mmap = match map_file(&path) {
+        Ok(m) => m,
+        Err(_) => return search_file_error("Cannot read file"),
+    };
+    if handle.is_cancelled() {
+        return search_file_error("Search cancelled");
+    }
+    let data: &[u8] = mmap.as_deref().unwrap_or(&[]);
+
+    let chunks = lines::line_chunks(data, PARALLEL_CHUNK_SIZE);
+    let scanned = AtomicU64::new(0);
+    let total_size = data.len() as u64;
+    let mut remaining = MAX_SEARCH_MATCHES;
+    let mut dropped = false;
+
+    search_pool().install(|| {
+        // Line number each chunk starts at (newline counting is cheap next to matching)
+        let newlines: Vec<usize> = chunks
+            .par_iter()
+            .map(|&(start, end)| memchr::memchr_iter(b'\n', &data[start..end]).count())
+            .collect();
+        let first_lines: Vec<usize> = newlines
+            .iter()
+            .scan(0, |line, &n| {
+                let first = *line;
+                *line += n;
+                Some(first)
+            })
+            .collect();
+
+        // Scan one chunk per thread at a time and take the results in file
+        // order, so the budget goes to the lowest line numbers whatever the
+        // timing, and the scan stops at the batch that uses it up
+        let batch_size = rayon::current_num_threads().max(1);
+        let mut next = 0;
+        while next < chunks.len() && !handle.is_cancelled() {
+            if remaining == 0 {
+                // Only need to know whether the rest of the file has a match
+                dropped = chunks[next..].par_iter().any(|&chunk| chunk_matches(data, chunk, &regex));
+                break;
+            }
+            let batch = next..(next + batch_size).min(chunks.len());
+            next = batch.end;
+            let limit = remaining;
+            let results: Vec<(Vec<SearchMatch>, bool)> = chunks[batch.clone()]
+                .par_iter()
+                .zip(first_lines[batch].par_iter())
+                .map(|(&chunk, &first_line)| {
+                    if handle.is_cancelled() {
+                        return (Vec::new(), false);
+                    }
+                    let result = search_chunk(data, chunk, first_line, &regex, limit);
+                    let done = scanned.fetch_add((chunk.1 - chunk.0) as u64, Ordering::Relaxed);
+                    handle.progress(&app, done + (chunk.1 - chunk.0) as u64, total_size);
+                    result
+                })
+                .collect();
+
+            for (mut matches, more) in results {
+                if handle.is_cancelled() {
+                    break;
+                }
+                if matches.len() > remaining {
+                    matches.truncate(remaining);
+                    dropped = true;
+                }
+                dropped |= more;
+                if matches.is_empty() {
+                    continue;
+                }
+                remaining -= matches.len();
+                let event = SearchMatchesEvent {
+                    search_id: search_id.clone(),
+                    path: path.clone(),
+                    matches,
+                };
+                let _ = app.emit(SEARCH_MATCHES_EVENT, event);
+            }
+        }
+    });
+
+    if handle.is_cancelled() {
+        return search_file_error("Search cancelled");
+    }
+
+    SearchFileResult {
+        success: true,
+        match_count: Some(MAX_SEARCH_MATCHES - remaining),
+        truncated: Some(dropped),
+        error: None,
+    }
+}
@@ -0,0 +1,114 @@
+//! Directory and glob sources
+//!
+//! A source is a directory (its `.log`/`.txt` files) or a glob with
+//! wildcards in the file name only (`/var/log/myapp/*.log`). The watcher
+//! watches the source's directory once and opens files that start matching
+//! while it runs; see `watch_source` in watcher.rs.
+
+use std::fs;
+use std::io;
+use std::path::{Path, PathBuf};
+
+// Files a directory source picks up (those that grow - not rotated .gz/.zst)
+const DIRECTORY_EXTENSIONS: &[&str] = &["log", "txt"];
+
+/// A parsed directory or glob source
+pub struct Source {
+    pub dir: PathBuf,        // Canonical directory
+    pattern: Option<String>, // File name glob (None = DIRECTORY_EXTENSIONS)
+}
+
+/// Match a file name against a glob (`*` any run, `?` one character)
+fn glob_match(pattern: &[char], name: &[char]) -> bool {
+    let (mut p, mut n) = (0, 0);
+    // Last `*` seen and the name position it currently covers up to
+    let mut star: Option<(usize, usize)> = None;
+    while n < name.len() {
+        if p < pattern.len() && (pattern[p] == '?' || pattern[p] == name[n]) {
+            p += 1;
+            n += 1;
+        } else if p < pattern.len() && pattern[p] == '*' {
+            star = Some((p, n));
+            p += 1;
+        } else if let Some((sp, sn)) = star {
+            // Let the `*` cover one more character
+            p = sp + 1;
+            n = sn + 1;
+            star = Some((sp, sn + 1));
+        } else {
+            return false;
+        }
+    }
+    pattern[p..].iter().all(|&c| c == '*')
+}
+
+fn has_wildcards(s: &str) -> bool {
+    s.contains('*') || s.contains('?')
+}
+
+impl Source {
+    /// Parse a directory path or a glob like `/var/log/myapp/*.log`
+    pub fn parse(spec: &str) -> Result<Source, String> {
+        let path = Path::new(spec);
+        if path.is_dir() {
+            let dir = fs::canonicalize(path).map_err(|e| format!("Cannot open {}: {}", spec, e))?;
+            return Ok(Source { dir, pattern: None });
+        }
+
+        let name = path.file_name().and_then(|n| n.to_str()).unwrap_or("");
+        let parent = path.parent().filter(|p| !p.as_os_str().is_empty());
+        match parent {
+            Some(parent) if has_wildcards(name) && !has_wildcards(&parent.to_string_lossy()) => {
+                let dir = fs::canonicalize(parent)
+                    .ok()
+                    .filter(|d| d.is_dir())
+                    .ok_or_else(|| format!("Directory not found: {}", parent.display()))?;
+                Ok(Source { dir, pattern: Some(name.to_string()) })
+            }
+            _ if has_wildcards(spec) => Err(format!(
+                "Only the file name can have wildcards (e.g. /var/log/app/*.log): {}",
+                spec
+            )),
+            _ => Err(format!("Not a directory or glob: {}", spec)),
+        }
+    }
+
+    /// Does `path` (in the canonical directory, as reported by the watcher)
+    /// belong to this source?
+    pub fn matches(&self, path: &Path) -> bool {
+        if path.parent() != Some(self.dir.as_path()) {
+            return false;
+        }
+        let name = match path.file_name().and_then(|n| n.to_str()) {
+            Some(n) => n,
+            None => return false,
+        };
+        // Hidden files only match a pattern that starts with a dot (as in a shell)
+        if name.starts_with('.') && !self.pattern.as_ref().is_some_and(|p| p.starts_with('.')) {
+            return false;
+        }
+        match &self.pattern {
+            Some(pattern) => {
+                let pattern: Vec<char> = pattern.chars().collect();
+                let name: Vec<char> = name.chars().collect();
+                glob_match(&pattern, &name)
+            }
+            None => path
+                .extension()
+                .and_then(|e| e.to_str())
+                .is_some_and(|e| DIRECTORY_EXTENSIONS.contains(&e.to_ascii_lowercase().as_str())),
+        }
+    }
+
+    /// Files currently in the source, sorted by path (symlinks are kept as
+    /// links - pod log directories are mostly symlinks)
+    pub fn files(&self) -> io::Result<Vec<PathBuf>> {
+        let mut files: Vec<PathBuf> = fs::read_dir(&self.dir)?
+            .filter_map(|entry| entry.ok())
+            .map(|entry| entry.path())
+            .filter(|path| self.matches(path) && path.is_file())
+            .collect();
+        files.sort();
+        Ok(files)
+    }
+}
@@ -0,0 +1,214 @@
+//! Rotation-aware tailing
+//!
+//! Differential reads (watcher flushes and fallback polls) go through a
+//! per-path tail state instead of trusting the offset alone. The file's ID
+//! (device + inode) and a fingerprint of its first bytes tell whether the
+//! file at the path is still the one read so far:
+//! - same file, grown: the bytes past the offset
+//! - renamed away by a rotator, with a new file at the path: the rest of the
+//!   old file is drained through the handle kept open on it, then the new
+//!   file is read from its start
+//! - truncated or rewritten in place (copytruncate): read from its start
+//!
+//! The last two come back `rotated`; the frontend appends them to the
+//! history it has loaded instead of reloading the file.
+
+use std::collections::HashMap;
+use std::fs::{File, Metadata};
+use std::io::{self, Read, Seek, SeekFrom};
+use std::sync::{Arc, Mutex, OnceLock};
+
+use crate::index::reset_index;
+use crate::parse_cache::fnv1a;
+
+// Bytes at the start of a file that identify its content
+const HEAD_BYTES: u64 = 1024;
+// A rotated or rewritten file is read from its start, but no more than its
+// last MAX_RESTART_READ bytes (same as MAX_READ_SIZE in commands.rs)
+const MAX_RESTART_READ: u64 = 2 * 1024 * 1024;
+
+/// Bytes read past the previous offset
+pub struct TailRead {
+    pub content: Vec<u8>,
+    pub size: u64, // Offset to continue from (in the file now at the path)
+    pub mtime: Option<i64>,
+    pub rotated: bool, // Content continues from a new or rewritten file
+}
+
+/// Device and inode (None where std doesn't expose a file ID)
+#[cfg(unix)]
+fn file_id(metadata: &Metadata) -> Option<(u64, u64)> {
+    use std::os::unix::fs::MetadataExt;
+    Some((metadata.dev(), metadata.ino()))
+}
+
+#[cfg(not(unix))]
+fn file_id(_metadata: &Metadata) -> Option<(u64, u64)> {
+    None
+}
+
+fn mtime_millis(metadata: &Metadata) -> Option<i64> {
+    metadata
+        .modified()
+        .ok()
+        .and_then(|t| t.duration_since(std::time::UNIX_EPOCH).ok())
+        .map(|d| d.as_millis() as i64)
+}
+
+/// Fingerprint of the first `len` bytes
+fn head_hash(file: &mut File, len: u64) -> io::Result<u64> {
+    let mut buf = vec![0u8; len as usize];
+    file.seek(SeekFrom::Start(0))?;
+    file.read_exact(&mut buf)?;
+    Ok(fnv1a(&buf))
+}
+
+/// Bytes [start, end) of a file (fewer if it is shorter)
+fn read_range(file: &mut File, start: u64, end: u64) -> io::Result<Vec<u8>> {
+    let mut content = Vec::with_capacity(end.saturating_sub(start) as usize);
+    if end > start {
+        file.seek(SeekFrom::Start(start))?;
+        file.take(end - start).read_to_end(&mut content)?;
+    }
+    Ok(content)
+}
+
+/// The file being tailed at one path
+struct TailState {
+    file: File, // Handle on the file read so far (still readable once renamed)
+    id: Option<(u64, u64)>,
+    head_len: u64, // Fingerprinted bytes (fewer than HEAD_BYTES while the file is small)
+    head_hash: u64,
+    offset: u64,
+}
+
+impl TailState {
+    /// Start tracking `file`, read up to `offset`
+    fn new(mut file: File, offset: u64) -> io::Result<Self> {
+        let metadata = file.metadata()?;
+        let head_len = HEAD_BYTES.min(offset).min(metadata.len());
+        let head_hash = head_hash(&mut file, head_len)?;
+        Ok(TailState {
+            file,
+            id: file_id(&metadata),
+            head_len,
+            head_hash,
+            offset,
+        })
+    }
+
+    /// Is `file` the file read so far, unchanged up to the offset?
+    fn is_same(&self, file: &mut File, metadata: &Metadata) -> io::Result<bool> {
+        if self.id.is_some() && file_id(metadata) != self.id {
+            return Ok(false);
+        }
+        if metadata.len() < self.offset || metadata.len() < self.head_len {
+            return Ok(false);
+        }
+        Ok(head_hash(file, self.head_len)? == self.head_hash)
+    }
+
+    /// Read `file` (the tracked file) from the offset to its end
+    fn advance(&mut self, file: &mut File, size: u64) -> io::Result<Vec<u8>> {
+        let content = read_range(file, self.offset, size)?;
+        self.offset += content.len() as u64;
+        // Fingerprint more of the head while the file is still short
+        if self.head_len < HEAD_BYTES && self.offset > self.head_len {
+            self.head_len = HEAD_BYTES.min(self.offset);
+            self.head_hash = head_hash(file, self.head_len)?;
+        }
+        Ok(content)
+    }
+
+    /// What was written to the tracked file past the offset, if it still
+    /// holds what was read (it may have been renamed, not truncated)
+    fn drain(&mut self) -> io::Result<Vec<u8>> {
+        let mut file = self.file.try_clone()?;
+        let metadata = file.metadata()?;
+        if !self.is_same(&mut file, &metadata)? {
+            return Ok(Vec::new());
+        }
+        self.advance(&mut file, metadata.len())
+    }
+}
+
+/// Tail states by path as given by the frontend
+fn tails() -> &'static Mutex<HashMap<String, Arc<Mutex<Option<TailState>>>>> {
+    static TAILS: OnceLock<Mutex<HashMap<String, Arc<Mutex<Option<TailState>>>>>> = OnceLock::new();
+    TAILS.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+fn slot(path: &str) -> Arc<Mutex<Option<TailState>>> {
+    tails()
+        .lock()
+        .unwrap()
+        .entry(path.to_string())
+        .or_insert_with(|| Arc::new(Mutex::new(None)))
+        .clone()
+}
+
+/// Remember which file is at `path` after a read up to `offset`, so a
+/// rotation before the next read is noticed
+pub fn track(path: &str, offset: u64) {
+    let slot = slot(path);
+    let mut state = slot.lock().unwrap();
+    if state.as_ref().map_or(true, |s| s.offset != offset) {
+        *state = File::open(path).and_then(|file| TailState::new(file, offset)).ok();
+    }
+}
+
+/// Stop tailing `path` (closes the handle kept on it)
+pub fn forget(path: &str) {
+    tails().lock().unwrap().remove(path);
+}
+
+/// Bytes added to `path` since `offset`, following it across rotation and
+/// truncation
+pub fn read_appended(path: &str, offset: u64) -> io::Result<TailRead> {
+    let slot = slot(path);
+    let mut slot = slot.lock().unwrap();
+    // Not tracked yet, or the caller continues from elsewhere: start from its offset
+    if slot.as_ref().map_or(true, |s| s.offset != offset) {
+        *slot = Some(TailState::new(File::open(path)?, offset)?);
+    }
+    let state = slot.as_mut().unwrap();
+
+    let current = File::open(path).and_then(|file| {
+        let metadata = file.metadata()?;
+        Ok((file, metadata))
+    });
+    let (mut file, metadata) = match current {
+        Ok(current) => current,
+        // Renamed away and not recreated yet: the writer may still be on the old file
+        Err(_) => {
+            let content = state.drain()?;
+            return Ok(TailRead { content, size: state.offset, mtime: None, rotated: false });
+        }
+    };
+    let mtime = mtime_millis(&metadata);
+
+    if state.is_same(&mut file, &metadata)? {
+        let content = state.advance(&mut file, metadata.len())?;
+        return Ok(TailRead { content, size: state.offset, mtime, rotated: false });
+    }
+
+    // Rotated or rewritten: the rest of the old file, then the new one
+    let mut content = state.drain()?;
+    if content.last().is_some_and(|&b| b != b'\n') {
+        content.push(b'\n');
+    }
+    let size = metadata.len();
+    let start = size.saturating_sub(MAX_RESTART_READ);
+    let mut fresh = read_range(&mut file, start, size)?;
+    if start > 0 {
+        // Started mid-line
+        let skip = memchr::memchr(b'\n', &fresh).map_or(fresh.len(), |p| p + 1);
+        fresh.drain(..skip);
+    }
+    content.extend_from_slice(&fresh);
+
+    // Line offsets of the old file no longer apply
+    reset_index(path);
+    *state = TailState::new(file, size)?;
+    Ok(TailRead { content, size, mtime, rotated: true })
+}
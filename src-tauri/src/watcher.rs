@@ -0,0 +1,487 @@
+use notify::{Event, EventKind, RecommendedWatcher, RecursiveMode, Watcher};
+use serde::{Deserialize, Serialize};
+use std::collections::{HashMap, HashSet};
+use std::fs;
+use std::path::{Path, PathBuf};
+use std::sync::mpsc::{self, Receiver, RecvTimeoutError};
+use std::sync::{Arc, Mutex};
+use std::thread;
+use std::time::{Duration, Instant};
+use tauri::{AppHandle, Emitter, State};
+
+use crate::commands::tail_file;
+use crate::compressed;
+use crate::index::reset_index;
+use crate::parser::{parse_log_file, LogEntry};
+use crate::sources::Source;
+use crate::tail;
+
+/// Event emitted to the frontend once per flush, with every watched file
+/// that got new content
+pub const FILES_APPENDED_EVENT: &str = "files-appended";
+
+// Flush once the watched files have been quiet for this long, so loggers
+// that write line-by-line collapse into a single event
+const COALESCE_WINDOW: Duration = Duration::from_millis(75);
+// Upper bound on how long continuously written files can be held back
+const MAX_COALESCE_DELAY: Duration = Duration::from_millis(300);
+
+/// New content of one file (entries parsed from the bytes past the last
+/// offset; after a rotation, the rest of the old file followed by the new
+/// one; for a file new to a source, its initial read)
+#[derive(Serialize, Clone)]
+#[serde(rename_all = "camelCase")]
+pub struct FileAppendedEvent {
+    pub path: String,
+    // Source the file was picked up from (only set with `created`)
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub source: Option<String>,
+    pub logs: Vec<LogEntry>,
+    pub size: u64,
+    pub prev_size: u64,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub mtime: Option<i64>,
+    pub truncated: bool,
+    pub rotated: bool, // Continues from a new or rewritten file (see tail.rs)
+    pub created: bool, // Started matching a watched source (not open in the frontend yet)
+    pub backend_ms: f64, // Reading and parsing the new bytes
+}
+
+/// Payload for the files-appended event
+#[derive(Serialize, Clone)]
+#[serde(rename_all = "camelCase")]
+pub struct FilesAppendedEvent {
+    pub files: Vec<FileAppendedEvent>,
+    pub emitted_at: i64, // Unix millis when sent (delivery latency)
+}
+
+/// A single watched file
+struct WatchedFile {
+    path: String,           // Path as given by the frontend (used as the event key)
+    offset: u64,            // Bytes already delivered to the frontend
+    source: Option<String>, // Source that picked the file up (unwatched with it)
+}
+
+/// A watched directory or glob source
+struct WatchedSource {
+    source: Source,
+    known: HashSet<PathBuf>, // Matches already reported (new ones get opened)
+}
+
+#[derive(Default)]
+struct Watches {
+    files: HashMap<PathBuf, WatchedFile>,     // canonical path -> watched file
+    dirs: HashMap<PathBuf, usize>,            // watched dir -> file + source count
+    sources: HashMap<String, WatchedSource>, // spec as given by the frontend -> source
+}
+
+/// Managed state for the native file watcher.
+/// Parent directories are watched (not the files themselves) so the watch
+/// survives editors and log rotators that replace the file. One worker
+/// thread serves every watched file and source.
+#[derive(Default)]
+pub struct WatcherState {
+    watches: Arc<Mutex<Watches>>,
+    watcher: Arc<Mutex<Option<RecommendedWatcher>>>,
+}
+
+/// Resolve a path reported by the OS to the key used in `Watches::files`
+fn event_key(path: &Path) -> PathBuf {
+    fs::canonicalize(path).unwrap_or_else(|_| path.to_path_buf())
+}
+
+/// Create the OS watcher (FSEvents/inotify/ReadDirectoryChangesW) and the
+/// coalescing thread that turns raw change notifications into events
+fn start_watcher(
+    app: AppHandle,
+    watches: Arc<Mutex<Watches>>,
+    watcher: Arc<Mutex<Option<RecommendedWatcher>>>,
+) -> notify::Result<RecommendedWatcher> {
+    let (tx, rx) = mpsc::channel::<PathBuf>();
+
+    let os_watcher = notify::recommended_watcher(move |res: notify::Result<Event>| {
+        let event = match res {
+            Ok(e) => e,
+            Err(e) => {
+                log::warn!("File watcher error: {}", e);
+                return;
+            }
+        };
+        // Reads don't change content
+        if matches!(event.kind, EventKind::Access(_)) {
+            return;
+        }
+        for path in event.paths {
+            let _ = tx.send(path);
+        }
+    })?;
+
+    thread::spawn(move || coalesce_loop(app, watches, watcher, rx));
+
+    Ok(os_watcher)
+}
+
+/// Start the OS watcher on first use
+fn ensure_watcher(app: AppHandle, state: &WatcherState, guard: &mut Option<RecommendedWatcher>) -> bool {
+    if guard.is_none() {
+        match start_watcher(app, state.watches.clone(), state.watcher.clone()) {
+            Ok(w) => *guard = Some(w),
+            Err(e) => {
+                log::warn!("Cannot start file watcher: {}", e);
+                return false;
+            }
+        }
+    }
+    true
+}
+
+/// Watch `dir` for one more file or source
+fn add_dir(watcher: &mut RecommendedWatcher, watches: &mut Watches, dir: &Path) -> bool {
+    let count = watches.dirs.get(dir).copied().unwrap_or(0);
+    if count == 0 {
+        if let Err(e) = watcher.watch(dir, RecursiveMode::NonRecursive) {
+            log::warn!("Cannot watch {}: {}", dir.display(), e);
+            return false;
+        }
+    }
+    watches.dirs.insert(dir.to_path_buf(), count + 1);
+    true
+}
+
+/// Drop one file or source from `dir`, unwatching it after the last one
+fn remove_dir(watcher: Option<&mut RecommendedWatcher>, watches: &mut Watches, dir: &Path) {
+    let count = watches.dirs.get(dir).copied().unwrap_or(0);
+    if count <= 1 {
+        watches.dirs.remove(dir);
+        if let Some(watcher) = watcher {
+            let _ = watcher.unwatch(dir);
+        }
+    } else {
+        watches.dirs.insert(dir.to_path_buf(), count - 1);
+    }
+}
+
+/// Watch one file from `offset`
+fn add_file(
+    watcher: &mut RecommendedWatcher,
+    watches: &mut Watches,
+    path: String,
+    offset: u64,
+    source: Option<String>,
+) -> bool {
+    if path.is_empty() {
+        return false;
+    }
+    let key = match fs::canonicalize(&path) {
+        Ok(p) => p,
+        Err(_) => return false,
+    };
+    let dir = match key.parent() {
+        Some(d) => d.to_path_buf(),
+        None => return false,
+    };
+
+    // Note which file is at the path, so a rotation before the first flush is seen
+    if offset > 0 {
+        tail::track(&path, offset);
+    }
+
+    // Already watched - just reset the offset
+    if let Some(existing) = watches.files.get_mut(&key) {
+        existing.path = path;
+        existing.offset = offset;
+        return true;
+    }
+
+    if !add_dir(watcher, watches, &dir) {
+        return false;
+    }
+    watches.files.insert(key, WatchedFile { path, offset, source });
+    true
+}
+
+/// Stop watching the file at canonical `key`
+fn remove_file(watcher: Option<&mut RecommendedWatcher>, watches: &mut Watches, key: &Path) {
+    if let Some(file) = watches.files.remove(key) {
+        tail::forget(&file.path);
+    }
+    if let Some(dir) = key.parent() {
+        remove_dir(watcher, watches, dir);
+    }
+}
+
+/// Collect change notifications until the writers go quiet, then flush
+/// every dirty file in one event
+fn coalesce_loop(
+    app: AppHandle,
+    watches: Arc<Mutex<Watches>>,
+    watcher: Arc<Mutex<Option<RecommendedWatcher>>>,
+    rx: Receiver<PathBuf>,
+) {
+    while let Ok(first) = rx.recv() {
+        let mut dirty = HashSet::new();
+        dirty.insert(first);
+
+        let started = Instant::now();
+        loop {
+            let elapsed = started.elapsed();
+            if elapsed >= MAX_COALESCE_DELAY {
+                break;
+            }
+            match rx.recv_timeout(COALESCE_WINDOW.min(MAX_COALESCE_DELAY - elapsed)) {
+                Ok(path) => {
+                    dirty.insert(path);
+                }
+                Err(RecvTimeoutError::Timeout) => break,
+                Err(RecvTimeoutError::Disconnected) => {
+                    flush(&app, &watches, &watcher, dirty);
+                    return;
+                }
+            }
+        }
+
+        flush(&app, &watches, &watcher, dirty);
+    }
+}
+
+/// A file that started matching a watched source: watch it from the start
+/// and return its path and source
+fn claim_new_file(
+    watcher: &Mutex<Option<RecommendedWatcher>>,
+    watches: &Mutex<Watches>,
+    raw: &Path,
+) -> Option<(String, String)> {
+    let mut watcher = watcher.lock().unwrap();
+    let mut watches = watches.lock().unwrap();
+    let spec = watches
+        .sources
+        .iter()
+        .find(|(_, s)| s.source.matches(raw) && !s.known.contains(raw))
+        .map(|(spec, _)| spec.clone())?;
+    // Removed again before the flush (or a directory matching the glob)
+    if !raw.is_file() {
+        return None;
+    }
+    watches.sources.get_mut(&spec)?.known.insert(raw.to_path_buf());
+
+    let path = raw.to_string_lossy().into_owned();
+    if !add_file(watcher.as_mut()?, &mut watches, path.clone(), 0, Some(spec.clone())) {
+        return None;
+    }
+    Some((path, spec))
+}
+
+/// Read and parse new bytes for each dirty file (and the initial content of
+/// files new to a source) and emit them to the frontend together
+fn flush(
+    app: &AppHandle,
+    watches: &Mutex<Watches>,
+    watcher: &Mutex<Option<RecommendedWatcher>>,
+    dirty: HashSet<PathBuf>,
+) {
+    let mut raw_paths: Vec<PathBuf> = dirty.into_iter().collect();
+    raw_paths.sort();
+
+    let mut seen = HashSet::new();
+    let mut files = Vec::new();
+    for raw in raw_paths {
+        let key = event_key(&raw);
+        if !seen.insert(key.clone()) {
+            continue;
+        }
+
+        let watched = {
+            let watches = watches.lock().unwrap();
+            watches.files.get(&key).map(|f| (f.path.clone(), f.offset))
+        };
+        let (path, offset, source) = match watched {
+            Some((path, offset)) => (path, offset, None),
+            // Events for other files in a watched directory are ignored,
+            // unless they belong to a source
+            None => match claim_new_file(watcher, watches, &raw) {
+                Some((path, spec)) => (path, 0, Some(spec)),
+                None => continue,
+            },
+        };
+        let created = source.is_some();
+
+        let start = Instant::now();
+        let result = tail_file(path.clone(), offset);
+        if !result.success {
+            continue;
+        }
+
+        let size = result.size.unwrap_or(offset);
+        let content = result.content.unwrap_or_default();
+        let truncated = result.truncated.unwrap_or(false);
+        let rotated = result.rotated.unwrap_or(false);
+        // A rotation is sent even without new lines: the offset starts over.
+        // A new file is sent even while empty, so the frontend opens it.
+        if content.is_empty() && !truncated && !rotated && !created {
+            continue;
+        }
+
+        // Advance the offset (unless the file was unwatched meanwhile)
+        {
+            let mut watches = watches.lock().unwrap();
+            match watches.files.get_mut(&key) {
+                Some(f) => f.offset = size,
+                None => continue,
+            }
+        }
+
+        let name = result.name.unwrap_or_default();
+        let logs = parse_log_file(&content, &name, Some(&path)).logs;
+
+        files.push(FileAppendedEvent {
+            path,
+            source,
+            logs,
+            size,
+            prev_size: offset,
+            mtime: result.mtime,
+            truncated,
+            rotated,
+            created,
+            backend_ms: start.elapsed().as_secs_f64() * 1000.0,
+        });
+    }
+
+    if files.is_empty() {
+        return;
+    }
+    let event = FilesAppendedEvent {
+        files,
+        emitted_at: chrono::Utc::now().timestamp_millis(),
+    };
+    if let Err(e) = app.emit(FILES_APPENDED_EVENT, event) {
+        log::warn!("Failed to emit {}: {}", FILES_APPENDED_EVENT, e);
+    }
+}
+
+/// A file to watch and the bytes already loaded from it
+#[derive(Deserialize)]
+pub struct WatchRequest {
+    pub path: String,
+    pub offset: u64,
+}
+
+/// Start watching files. New content past each offset is pushed to the
+/// frontend in `files-appended` events. Returns the paths that can't be
+/// watched (the frontend polls those).
+#[tauri::command]
+pub fn watch_files(app: AppHandle, state: State<'_, WatcherState>, files: Vec<WatchRequest>) -> Vec<String> {
+    let mut watcher_guard = state.watcher.lock().unwrap();
+    if !ensure_watcher(app, &state, &mut watcher_guard) {
+        return files.into_iter().map(|f| f.path).collect();
+    }
+    let watcher = watcher_guard.as_mut().unwrap();
+    let mut watches = state.watches.lock().unwrap();
+
+    let mut failed = Vec::new();
+    for file in files {
+        if !add_file(watcher, &mut watches, file.path.clone(), file.offset, None) {
+            failed.push(file.path);
+        }
+    }
+    failed
+}
+
+/// Stop watching files (closed files: their line indexes and seek tables
+/// are dropped too)
+#[tauri::command]
+pub fn unwatch_files(state: State<'_, WatcherState>, paths: Vec<String>) {
+    let mut watcher_guard = state.watcher.lock().unwrap();
+    let mut watches = state.watches.lock().unwrap();
+
+    for path in paths {
+        // Also covers files tailed by polling (those the watcher couldn't watch)
+        tail::forget(&path);
+        reset_index(&path);
+        compressed::forget(&path);
+
+        // Look up by frontend path (the file may no longer exist to canonicalize)
+        let key = match watches.files.iter().find(|(_, f)| f.path == path) {
+            Some((k, _)) => k.clone(),
+            None => continue,
+        };
+        remove_file(watcher_guard.as_mut(), &mut watches, &key);
+    }
+}
+
+/// Result for watch_source command
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct SourceResult {
+    pub success: bool,
+    // Files matching now, sorted (the frontend opens and watches these)
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub files: Option<Vec<String>>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub error: Option<String>,
+}
+
+/// Start watching a directory or glob source. Returns the files matching
+/// now; files that start matching later come with `created` set in the
+/// next `files-appended` event.
+#[tauri::command]
+pub fn watch_source(app: AppHandle, state: State<'_, WatcherState>, spec: String) -> SourceResult {
+    let fail = |error: String| SourceResult { success: false, files: None, error: Some(error) };
+
+    let source = match Source::parse(&spec) {
+        Ok(s) => s,
+        Err(e) => return fail(e),
+    };
+    let matches = match source.files() {
+        Ok(f) => f,
+        Err(e) => return fail(format!("Cannot list {}: {}", source.dir.display(), e)),
+    };
+
+    let mut watcher_guard = state.watcher.lock().unwrap();
+    if !ensure_watcher(app, &state, &mut watcher_guard) {
+        return fail("Cannot start file watcher".to_string());
+    }
+    let watcher = watcher_guard.as_mut().unwrap();
+    let mut watches = state.watches.lock().unwrap();
+
+    if !watches.sources.contains_key(&spec) {
+        if !add_dir(watcher, &mut watches, &source.dir) {
+            return fail(format!("Cannot watch {}", source.dir.display()));
+        }
+        watches.sources.insert(spec.clone(), WatchedSource { source, known: HashSet::new() });
+    }
+    let watched = watches.sources.get_mut(&spec).unwrap();
+    watched.known.extend(matches.iter().cloned());
+
+    SourceResult {
+        success: true,
+        files: Some(matches.iter().map(|p| p.to_string_lossy().into_owned()).collect()),
+        error: None,
+    }
+}
+
+/// Stop watching a source (and the files it picked up that the frontend
+/// didn't watch itself)
+#[tauri::command]
+pub fn unwatch_source(state: State<'_, WatcherState>, spec: String) -> bool {
+    let mut watcher_guard = state.watcher.lock().unwrap();
+    let mut watches = state.watches.lock().unwrap();
+
+    let watched = match watches.sources.remove(&spec) {
+        Some(s) => s,
+        None => return false,
+    };
+    remove_dir(watcher_guard.as_mut(), &mut watches, &watched.source.dir);
+
+    let picked_up: Vec<PathBuf> = watches
+        .files
+        .iter()
+        .filter(|(_, f)| f.source.as_deref() == Some(spec.as_str()))
+        .map(|(k, _)| k.clone())
+        .collect();
+    for key in picked_up {
+        remove_file(watcher_guard.as_mut(), &mut watches, &key);
+    }
+
+    true
+}
@@ -0,0 +1,69 @@
+/**
+ * Filter benchmarks: filterLogs (as used by the log store) over whole
+ * files of each size, scanning and through a token index.
+ *
+ *   npm run bench
+ *   MOCHA_BENCH_SIZES=10MB,100MB npm run bench
+ *
+ * Runs on the first selected format (salesbox-core by default).
+ */
+
+import { bench, describe } from "./harness";
+import { filterLogs, setListTextIndex } from "../src/filters";
+import { normalize, parseLogLine, parseTimestampToEpoch } from "../src/parser";
+import { TokenIndex } from "../src/tokenIndex";
+import type { LogEntry, ParsedFilter } from "../src/types";
+import { benchFormats, benchSizes, generateLog, sizeLabel } from "./synthetic";
+
+console.log = () => {}; // See parser.bench.ts
+
+function text(value: string): ParsedFilter {
+  return { type: "text", value, text: value };
+}
+
+const FILTERS: [string, ParsedFilter[]][] = [
+  ["text", [text("request")]],
+  ["text, two values", [text("timeout"), text("session:")]],
+  ["regex", [{ type: "regex", value: "id=\\d+7\\b", text: "/id=\\d+7\\b/" }]],
+  ["exclude", [{ type: "exclude", value: "debug", text: "-debug" }]],
+];
+const NONE_HIDDEN = new Set<string>();
+
+/**
+ * Every entry of a file, parsed (no MAX_LINES cap, unlike parseLogFile)
+ */
+function parseAll(content: string, name: string): LogEntry[] {
+  const lines = content.split("\n");
+  if (lines[lines.length - 1] === "") lines.pop();
+  const logs = normalize(lines.map((data, i) => ({ name, data, isErr: false, hash: String(i) })));
+  for (const log of logs) {
+    log.parsed = parseLogLine(log.data);
+    log.timestamp = (log.parsed.timestamp && parseTimestampToEpoch(log.parsed.timestamp)) || undefined;
+  }
+  return logs;
+}
+
+const format = benchFormats()[0] ?? "salesbox-core";
+
+for (const size of benchSizes()) {
+  const logs = parseAll(generateLog(format, size), `${format}.log`);
+
+  const index = new TokenIndex();
+  index.add(logs);
+  const indexed = logs.slice();
+  setListTextIndex(indexed, { containingAny: (values) => index.rowsContainingAny(values) });
+
+  describe(`filterLogs ${format} ${sizeLabel(size)} (${logs.length} entries)`, () => {
+    for (const [name, filters] of FILTERS) {
+      bench(name, () => {
+        filterLogs(logs, filters, NONE_HIDDEN);
+      });
+    }
+    bench("text, token index", () => {
+      filterLogs(indexed, [text("request")], NONE_HIDDEN);
+    });
+    bench("hidden service", () => {
+      filterLogs(logs, [], new Set(["MCPController"]));
+    });
+  });
+}
@@ -0,0 +1,127 @@
+/**
+ * Minimal benchmark harness for the UI suite (run by bench/run.js through
+ * Vite's module loader, so it needs nothing outside the lockfile).
+ *
+ * Bench files register groups with describe() and benchmarks with bench(),
+ * like Vitest's bench API. Each benchmark is warmed up, then timed one call
+ * per sample until both the time budget and the minimum sample count are
+ * reached.
+ */
+
+// Per benchmark: warm-up time, measuring time and minimum samples
+const WARMUP_MS = 100;
+const TIME_MS = 500;
+const MIN_SAMPLES = 10;
+
+interface Benchmark {
+  name: string;
+  fn: () => unknown;
+}
+
+interface Group {
+  name: string;
+  benchmarks: Benchmark[];
+}
+
+/**
+ * Timings of one benchmark, in milliseconds (same fields as Vitest's
+ * --outputJson, which scripts/bench-report.js reads)
+ */
+export interface BenchmarkResult {
+  name: string;
+  mean: number;
+  median: number;
+  min: number;
+  max: number;
+  hz: number; // Calls per second
+  rme: number; // Relative margin of error (%, 95% confidence)
+  sampleCount: number;
+}
+
+export interface GroupResult {
+  fullName: string;
+  benchmarks: BenchmarkResult[];
+}
+
+let groups: Group[] = [];
+let current: Group | null = null;
+
+/**
+ * Register a group of benchmarks (registered by `fn`)
+ */
+export function describe(name: string, fn: () => void): void {
+  const group: Group = { name, benchmarks: [] };
+  groups.push(group);
+  current = group;
+  try {
+    fn();
+  } finally {
+    current = null;
+  }
+}
+
+/**
+ * Register a benchmark in the current group
+ */
+export function bench(name: string, fn: () => unknown): void {
+  if (!current) throw new Error(`bench("${name}") outside describe()`);
+  current.benchmarks.push({ name, fn });
+}
+
+/**
+ * Take the groups registered so far (by the bench file just loaded)
+ */
+export function takeGroups(): Group[] {
+  const taken = groups;
+  groups = [];
+  return taken;
+}
+
+function measure({ name, fn }: Benchmark): BenchmarkResult {
+  const warmupEnd = performance.now() + WARMUP_MS;
+  do fn();
+  while (performance.now() < warmupEnd);
+
+  const samples: number[] = [];
+  const end = performance.now() + TIME_MS;
+  while (samples.length < MIN_SAMPLES || performance.now() < end) {
+    const start = performance.now();
+    fn();
+    samples.push(performance.now() - start);
+  }
+
+  samples.sort((a, b) => a - b);
+  const n = samples.length;
+  const mean = samples.reduce((sum, t) => sum + t, 0) / n;
+  const variance = samples.reduce((sum, t) => sum + (t - mean) ** 2, 0) / (n - 1);
+  const half = n >> 1;
+  return {
+    name,
+    mean,
+    median: n % 2 ? samples[half] : (samples[half - 1] + samples[half]) / 2,
+    min: samples[0],
+    max: samples[n - 1],
+    hz: mean > 0 ? 1000 / mean : 0,
+    rme: mean > 0 ? ((1.96 * Math.sqrt(variance / n)) / mean) * 100 : 0,
+    sampleCount: n,
+  };
+}
+
+/**
+ * Run the groups of a bench file, reporting each benchmark as it finishes
+ */
+export function runGroups(
+  file: string,
+  fileGroups: Group[],
+  onResult: (group: string, result: BenchmarkResult) => void,
+): GroupResult[] {
+  return fileGroups.map((group) => {
+    const fullName = `${file} > ${group.name}`;
+    const benchmarks = group.benchmarks.map((benchmark) => {
+      const result = measure(benchmark);
+      onResult(fullName, result);
+      return result;
+    });
+    return { fullName, benchmarks };
+  });
+}
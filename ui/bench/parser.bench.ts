@@ -0,0 +1,42 @@
+/**
+ * Parser benchmarks: parseLogFile per format over a 2 MB tail (what an
+ * initial read hands the parser), and tokenizeContent over the parsed
+ * contents of every format.
+ *
+ *   npm run bench
+ *   MOCHA_BENCH_FORMATS=salesbox-core,json-structured npm run bench
+ */
+
+import { bench, describe } from "./harness";
+import { parseLogFile, tokenizeContent } from "../src/parser";
+import { benchFormats, generateLog } from "./synthetic";
+
+// MAX_READ_SIZE in commands.rs
+const TAIL_BYTES = 2 * 1024 * 1024;
+
+// parseLogLine logs unparsed lines (stack traces merged into an entry) -
+// keep that out of the measurements
+console.log = () => {};
+
+const inputs = benchFormats().map((format) => ({
+  format,
+  content: generateLog(format, TAIL_BYTES),
+}));
+
+describe("parseLogFile", () => {
+  for (const { format, content } of inputs) {
+    bench(format, () => {
+      parseLogFile(content, "bench.log", `/bench/${format}.log`);
+    });
+  }
+});
+
+describe("tokenizeContent", () => {
+  const contents = inputs.flatMap(({ format, content }) =>
+    parseLogFile(content, "bench.log", `/bench/${format}.log`).logs.map((log) => log.parsed?.content ?? log.data),
+  );
+
+  bench(`all formats (${contents.length} entries)`, () => {
+    for (const content of contents) tokenizeContent(content);
+  });
+});
@@ -0,0 +1,77 @@
+#!/usr/bin/env node
+
+/**
+ * UI benchmark runner: loads every bench/*.bench.ts through Vite's SSR
+ * module loader (TypeScript and the src/ imports work as in the app), runs
+ * them with bench/harness.ts and writes bench-results.json for
+ * scripts/bench-report.js.
+ *
+ * Usage (from ui/):
+ *   npm run bench
+ *   node bench/run.js parser                # Only bench files matching "parser"
+ */
+
+import fs from 'node:fs';
+import path from 'node:path';
+import { fileURLToPath } from 'node:url';
+import { createServer } from 'vite';
+
+const UI_ROOT = path.resolve(path.dirname(fileURLToPath(import.meta.url)), '..');
+const BENCH_DIR = path.join(UI_ROOT, 'bench');
+const RESULTS_FILE = path.join(UI_ROOT, 'bench-results.json');
+
+// Bench files silence console.log (the parser logs unparsed lines)
+const print = console.log.bind(console);
+
+function formatTime(ms) {
+  if (ms >= 1000) return `${(ms / 1000).toFixed(2)} s`;
+  if (ms >= 1) return `${ms.toFixed(2)} ms`;
+  return `${(ms * 1000).toFixed(2)} µs`;
+}
+
+async function main() {
+  const filter = process.argv[2];
+  const files = fs
+    .readdirSync(BENCH_DIR)
+    .filter((file) => file.endsWith('.bench.ts') && (!filter || file.includes(filter)))
+    .sort();
+  if (files.length === 0) {
+    console.error('No bench files found');
+    process.exit(1);
+  }
+
+  // Only the module loader is used: no config file, dev server or dependency scan
+  const server = await createServer({
+    root: UI_ROOT,
+    configFile: false,
+    logLevel: 'error',
+    appType: 'custom',
+    server: { middlewareMode: true, hmr: false, ws: false },
+    optimizeDeps: { noDiscovery: true, include: [] },
+  });
+
+  const results = { files: [] };
+  try {
+    const harness = await server.ssrLoadModule('/bench/harness.ts');
+    for (const file of files) {
+      const filepath = `bench/${file}`;
+      await server.ssrLoadModule(`/${filepath}`);
+      const groups = harness.runGroups(filepath, harness.takeGroups(), (group, result) => {
+        print(
+          `${group} > ${result.name}: ${formatTime(result.mean)} ±${result.rme.toFixed(2)}% (${result.sampleCount} samples)`,
+        );
+      });
+      results.files.push({ filepath, groups });
+    }
+  } finally {
+    await server.close();
+  }
+
+  fs.writeFileSync(RESULTS_FILE, JSON.stringify(results, null, 2) + '\n');
+  print(`\nResults written to ${path.relative(process.cwd(), RESULTS_FILE)}`);
+}
+
+main().catch((err) => {
+  console.error(err);
+  process.exit(1);
+});
@@ -0,0 +1,218 @@
+/**
+ * Mocha Log Viewer - Synthetic Logs for Benchmarks
+ *
+ * One line template per parser pattern, filled from a seeded PRNG so every
+ * run benchmarks the same text. Keep in sync with
+ * src-tauri/benches/synthetic/mod.rs: both generators produce identical
+ * files.
+ */
+
+const SEED = 0x6d6f6368; // "moch"
+const BASE_MS = 1_767_225_600_000; // 2026-01-01T00:00:00Z
+
+/**
+ * Formats, by parser pattern name
+ */
+export const FORMATS = [
+  "salesbox-core",
+  "salesbox-app",
+  "iwf-spring",
+  "logback-with-source",
+  "logback-internal",
+  "maven",
+  "logback",
+  "bracketed",
+  "python-logging",
+  "logback-with-thread",
+  "simple",
+  "logback-time-only",
+  "level-only",
+  "genie-rust",
+  "json-structured",
+  "iso-timestamp",
+] as const;
+
+export type Format = (typeof FORMATS)[number];
+
+const THREADS = [
+  "main",
+  "http-nio-3004-exec-5",
+  "scheduled-executor-thread-2",
+  "default-nioEventLoopGroup-1-5",
+];
+
+const STACK_TRACE = [
+  "\tat com.example.core.LeadService.process(LeadService.java:211)",
+  "\tat com.example.core.Worker.run(Worker.java:57)",
+  "\tat java.base/java.lang.Thread.run(Thread.java:1583)",
+];
+
+/**
+ * mulberry32
+ */
+function createRng(seed: number): () => number {
+  let state = seed >>> 0;
+  return () => {
+    state = (state + 0x6d2b79f5) >>> 0;
+    let t = state;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return (t ^ (t >>> 14)) >>> 0;
+  };
+}
+
+function level(r: number): string {
+  const n = r % 100;
+  if (n <= 1) return "ERROR";
+  if (n <= 7) return "WARN";
+  if (n <= 29) return "DEBUG";
+  return "INFO";
+}
+
+function message(i: number, kind: number, r: number): string {
+  switch (kind % 6) {
+    case 0:
+      return `Processing request id=${i} user=u${r % 1000}`;
+    case 1:
+      return `api call (no params) to https://api.example.com/users/${r % 5000}?line=${i}`;
+    case 2:
+      return `Completed batch ${i} in ${r % 900}ms`;
+    case 3:
+      return `Cache miss for key session:${r.toString(16).padStart(8, "0")} line ${i}`;
+    case 4:
+      return `GET response: api call /leads {id: ${r % 100}} response: {status: ok, line: ${i}}`;
+    default:
+      return `Sending message ${i} to queue events-${r % 8}`;
+  }
+}
+
+/**
+ * Line `i` of a format, followed by its continuation lines (a stack trace
+ * after errors, except for JSON logs)
+ */
+function entry(format: Format, i: number, rng: () => number): string {
+  const rLevel = rng();
+  const rThread = rng();
+  const rKind = rng();
+  const rValue = rng();
+  const lvl = level(rLevel);
+  const thread = THREADS[rThread % THREADS.length];
+  const msg = message(i, rKind, rValue);
+
+  const iso = new Date(BASE_MS + i * 7 + (rValue % 5)).toISOString();
+  const date = iso.slice(0, 10);
+  const time = iso.slice(11, 19);
+  const frac = iso.slice(20, 23);
+
+  let line: string;
+  switch (format) {
+    case "salesbox-core":
+      line = `${iso} ${date} ${time}.${frac} [${thread}] ${lvl} c.s.c.c.bizlogic.MCPController [MCPController.java:466] [default] - ${msg}`;
+      break;
+    case "salesbox-app":
+      line = `${date} ${time},${frac} ${i} [${thread}] ${lvl} com.r2.util.SQSUtil - ${msg}`;
+      break;
+    case "iwf-spring":
+      line = `[${thread}] ${lvl} i.i.w.u.StateWaitForLeads [StateWaitForLeads.java:133] [default] - ${msg}`;
+      break;
+    case "logback-with-source":
+      line = `${date} ${time}.${frac} [${thread}] ${lvl} c.s.p.LeadService [LeadService.java:88] [default] - ${msg}`;
+      break;
+    case "logback-internal":
+      line = `${time},${frac} |-${lvl} in ch.qos.logback.core.joran.action.AppenderAction - ${msg}`;
+      break;
+    case "maven":
+      line = `[${lvl === "WARN" ? "WARNING" : lvl}] ${msg}`;
+      break;
+    case "logback":
+      line = `${date} ${time},${frac} ${lvl} [c.r.u.d.RedashApiUtil:37] ${msg}`;
+      break;
+    case "bracketed":
+      line = `${date} ${time}.${frac} [${lvl}] ${msg}`;
+      break;
+    case "python-logging":
+      line = `${date} ${time},${frac} - db.py - ${lvl} - ${msg}`;
+      break;
+    case "logback-with-thread":
+      line = `${date} ${time}.${frac} [${thread}] ${lvl.padEnd(5)} c.s.c.s.ActivityProcessingScheduler - ${msg}`;
+      break;
+    case "simple":
+      line = `${date} ${time}.${frac} ${lvl} ${msg}`;
+      break;
+    case "logback-time-only":
+      line = `${time}.${frac} [${thread}] ${lvl} c.s.platform.util.CryptKeyUtil - ${msg}`;
+      break;
+    case "level-only":
+      line = `${lvl} ${msg}`;
+      break;
+    case "genie-rust":
+      line = `[${date}][${time}][app_lib::core::setup][${lvl}] ${msg}`;
+      break;
+    case "json-structured":
+      return `{"label":"core","level":"${lvl.toLowerCase()}","message":"${msg}","timestamp":"${iso}"}\n`;
+    case "iso-timestamp":
+      line = `${iso} ${msg}`;
+      break;
+  }
+
+  let out = line + "\n";
+  if (lvl === "ERROR") {
+    out += `java.lang.IllegalStateException: request ${i} failed\n`;
+    for (const frame of STACK_TRACE) out += frame + "\n";
+  }
+  return out;
+}
+
+/**
+ * At least `bytes` of a format (whole entries). Strings are capped by V8
+ * at about 512 MB; larger sizes only fit the Rust benchmarks.
+ */
+export function generateLog(format: Format, bytes: number): string {
+  const rng = createRng(SEED);
+  const parts: string[] = [];
+  let written = 0;
+  for (let i = 0; written < bytes; i++) {
+    const e = entry(format, i, rng);
+    parts.push(e);
+    written += e.length;
+  }
+  return parts.join("");
+}
+
+/**
+ * Parse "10MB", "1GB", "512KB" (binary units)
+ */
+export function parseSize(size: string): number | null {
+  const match = size.trim().toUpperCase().match(/^(\d+)(B|KB|MB|GB)?$/);
+  if (!match) return null;
+  const shift = { B: 0, KB: 10, MB: 20, GB: 30 }[match[2] ?? "B"] ?? 0;
+  return Number(match[1]) * 2 ** shift;
+}
+
+/**
+ * Formats to run (MOCHA_BENCH_FORMATS, comma-separated; default all)
+ */
+export function benchFormats(): Format[] {
+  const list = process.env.MOCHA_BENCH_FORMATS;
+  if (!list) return [...FORMATS];
+  const names = list.split(",").map((name) => name.trim());
+  return FORMATS.filter((format) => names.includes(format));
+}
+
+/**
+ * Sizes to run (MOCHA_BENCH_SIZES, e.g. "10MB,100MB"; default 10MB)
+ */
+export function benchSizes(): number[] {
+  return (process.env.MOCHA_BENCH_SIZES ?? "10MB").split(",").map((size) => {
+    const bytes = parseSize(size);
+    if (bytes === null) throw new Error(`Invalid MOCHA_BENCH_SIZES entry: ${size}`);
+    return bytes;
+  });
+}
+
+export function sizeLabel(bytes: number): string {
+  if (bytes >= 2 ** 30 && bytes % 2 ** 30 === 0) return `${bytes / 2 ** 30}GB`;
+  if (bytes >= 2 ** 20 && bytes % 2 ** 20 === 0) return `${bytes / 2 ** 20}MB`;
+  if (bytes >= 2 ** 10 && bytes % 2 ** 10 === 0) return `${bytes / 2 ** 10}KB`;
+  return `${bytes}B`;
+}
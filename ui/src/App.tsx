@@ -2,31 +2,310 @@ import { useEffect, useRef, useCallback, useMemo, useState } from "react";
 import { Upload, FileSearch, Zap } from "lucide-react";
 import { open as openFileDialog } from "@tauri-apps/plugin-dialog";
 import { getCurrentWebview } from "@tauri-apps/api/webview";
-import type { LogEntry, OpenedFileWithLogs } from "./types";
+import { useShallow } from "zustand/react/shallow";
+import type {
+  FileAppendedEvent,
+  FileChange,
+  LogEntry,
+  OpenedFileWithLogs,
+  NewOpenedFile,
+  ParseFileResult,
+  ParsedLogFileResult,
+  SearchMatch,
+} from "./types";
 import "./types";
 import {
   isTauri,
   waitForConnection,
-  readFile,
+  parseFile,
+  parseLines,
+  readTimeRange,
   getRecentFiles,
   addRecentFile,
   removeRecentFile as removeRecentFileApi,
   clearRecentFiles,
   searchFileForLine,
+  searchFile,
+  onSearchMatches,
+  cancelSearch,
+  onSearchProgress,
+  watchFiles,
+  unwatchFiles,
+  watchSource,
+  unwatchSource,
+  onFilesAppended,
+  setLoadThreads,
 } from "./api";
 import { parseLogFile } from "./parser";
+import { measure, recordIngest, recordSpan } from "./diagnostics";
 import {
   useLogViewerStore,
   useStoryStore,
   useFileStore,
   useSettingsStore,
   filterLogs,
+  compileFilters,
+  getTextIndex,
+  setListTextIndex,
 } from "./store";
+import { timelineTextIndex, type TokenIndex } from "./tokenIndex";
+import {
+  isLogWorkerSupported,
+  isAbortError,
+  parseFileInWorker,
+  filterInWorker,
+  searchInWorker,
+  dropWorkerFile,
+} from "./logWorkerClient";
+import { Timeline } from "./timeline";
+import type { ServiceLevelCounts } from "./logColumns";
 import { Sidebar, Toolbar, LogViewer } from "./components";
 import { LogbookView } from "./components/LogbookView";
 import { ToastContainer } from "./components/Toast";
+import { DiagnosticsPanel } from "./components/DiagnosticsPanel";
 import { useToastStore } from "./toastStore";
 
+// Lines loaded per page when scrolling back through large files
+const OLDER_PAGE_LINES = 1000;
+// Lines loaded around a whole-file search match
+const SEARCH_SECTION_LINES = 1000;
+// Wait for typing to pause before searching whole files
+const FILE_SEARCH_DEBOUNCE_MS = 300;
+// Files parsed by the backend at once when restoring or opening a source
+// (each parse runs on its own thread)
+const PARSE_CONCURRENCY = 4;
+const DAY_MS = 24 * 60 * 60 * 1000;
+
+/**
+ * Parse a time-range input: "HH:MM[:SS[.mmm]]" on the day of `reference`,
+ * or a full "YYYY-MM-DD HH:MM[:SS]" (local time). An end covers the whole
+ * minute or second it names. Returns epoch ms, or null if unrecognized.
+ */
+function parseTimeInput(text: string, reference: number, isEnd = false): number | null {
+  const time = /^(\d{1,2}):(\d{2})(?::(\d{2})(?:[.,](\d{1,3}))?)?$/.exec(text);
+  let epoch: number;
+  if (time) {
+    const date = new Date(reference);
+    date.setHours(
+      Number(time[1]),
+      Number(time[2]),
+      Number(time[3] ?? 0),
+      Number((time[4] ?? "0").padEnd(3, "0")),
+    );
+    epoch = date.getTime();
+  } else {
+    epoch = Date.parse(text.replace(" ", "T"));
+    if (Number.isNaN(epoch)) return null;
+  }
+  if (!isEnd || /[.,]\d+$/.test(text)) return epoch;
+  return epoch + (/:\d{2}:\d{2}$/.test(text) ? 999 : 59_999);
+}
+
+/**
+ * Whether a file was opened through the backend, so it can be searched,
+ * paged and watched by path (files from the browser file input only exist
+ * in memory)
+ */
+function isBackendFile(file: OpenedFileWithLogs): boolean {
+  return isTauri() && !file.inMemory;
+}
+
+/**
+ * Log the time since launch once a startup milestone has been painted
+ */
+function logStartupMilestone(label: string): void {
+  requestAnimationFrame(() =>
+    setTimeout(() => {
+      performance.mark(`mocha:${label}`);
+      console.info(`[startup] ${label}: ${Math.round(performance.now())}ms`);
+    }, 0),
+  );
+}
+
+/**
+ * Parse files in the backend, PARSE_CONCURRENCY at a time, handing the
+ * results over in the order of `paths`
+ */
+async function parseFilesInOrder(
+  paths: string[],
+  onParsed: (path: string, result: ParseFileResult) => void,
+): Promise<void> {
+  const parses = new Map<string, Promise<ParseFileResult>>();
+  let started = 0;
+  const startNext = () => {
+    if (started >= paths.length) return;
+    const path = paths[started++];
+    parses.set(path, parseFile(path, 0));
+  };
+  for (let i = 0; i < PARSE_CONCURRENCY; i++) startNext();
+
+  for (const path of paths) {
+    const result = await parses.get(path)!;
+    startNext();
+    onParsed(path, result);
+  }
+}
+
+/**
+ * Open a file that started matching an open source (its initial read comes
+ * with the watcher event)
+ */
+function openCreatedFile(update: FileAppendedEvent, watchedPaths: Set<string>): void {
+  const { sources, openedFiles, openFile } = useFileStore.getState();
+  // Source closed meanwhile, or the file is open already
+  if (!update.source || !sources.includes(update.source) || openedFiles.has(update.path)) return;
+
+  // The backend already watches it from the size it read
+  watchedPaths.add(update.path);
+  recordIngest(update.path, update.size, update.logs.length);
+  openFile({
+    path: update.path,
+    name: update.path.split(/[\\/]/).pop() || update.path,
+    size: update.size,
+    logs: update.logs,
+    lastModified: update.size,
+    mtime: update.mtime,
+    source: update.source,
+  });
+  if (update.logs.length > 0) {
+    useStoryStore.getState().addLogsToMatchingStories(update.logs);
+  }
+}
+
+/**
+ * Backend update of an opened file (watcher event or fallback poll)
+ */
+interface FileUpdate {
+  path: string;
+  logs?: LogEntry[];
+  size?: number;
+  mtime?: number;
+  truncated?: boolean;
+  rotated?: boolean;
+}
+
+/**
+ * Store change for a backend update of an opened file, or null if there is
+ * nothing to apply. Truncated/replaced files are reloaded entirely, grown
+ * files get the new lines appended. Rotated files (the backend followed the
+ * path to a new or rewritten file) are appended too, keeping the loaded history.
+ * @param lastModified - Size read up to so far (ahead of the store when an
+ *   earlier update of the same batch grew the file)
+ */
+function fileChangeFor(update: FileUpdate, lastModified: number): FileChange | null {
+  const newSize = update.size ?? 0;
+  const newLogs = update.logs ?? [];
+
+  if (update.truncated) {
+    recordIngest(update.path, newSize, newLogs.length);
+    // File was replaced/truncated - reload entirely, and read on from its new size.
+    // Reloaded content isn't line-indexed - stop paging until reopened
+    return {
+      path: update.path,
+      logs: newLogs,
+      replace: true,
+      lastModified: newSize,
+      mtime: update.mtime,
+      resetFirstLine: true,
+    };
+  }
+  if (update.rotated) {
+    recordIngest(update.path, newSize, newLogs.length);
+    // The new file's size is the next offset, even if it is below the old one.
+    // Loaded lines are no longer lines of the file at this path - stop paging
+    return {
+      path: update.path,
+      logs: newLogs,
+      lastModified: newSize,
+      mtime: update.mtime,
+      resetFirstLine: true,
+    };
+  }
+  if (newLogs.length > 0 && newSize > lastModified) {
+    // Normal append - file grew (appendFileLogs continues the timestamps of earlier logs)
+    recordIngest(update.path, newSize - lastModified, newLogs.length);
+    return { path: update.path, logs: newLogs, lastModified: newSize };
+  }
+  return null;
+}
+
+/**
+ * Apply backend updates of opened files as one store update, then
+ * auto-capture all their new logs to logbooks with matching patterns in one pass
+ */
+function applyFileUpdates(updates: FileUpdate[]): void {
+  const { openedFiles } = useFileStore.getState();
+  const changes: FileChange[] = [];
+  const offsets = new Map<string, number>();
+
+  for (const update of updates) {
+    const file = openedFiles.get(update.path);
+    if (!file) continue;
+    try {
+      const change = fileChangeFor(update, offsets.get(file.path) ?? file.lastModified);
+      if (!change) continue;
+      changes.push(change);
+      offsets.set(file.path, change.lastModified ?? file.lastModified);
+    } catch (err) {
+      console.error(`Update error for ${file.name}:`, err);
+    }
+  }
+  if (changes.length === 0) return;
+
+  let count = 0;
+  for (const change of changes) count += change.logs.length;
+  measure("append", () => useFileStore.getState().applyFileChanges(changes), { count });
+
+  const newLogs: LogEntry[] = [];
+  for (const change of changes) {
+    for (const log of change.logs) newLogs.push(log);
+  }
+  useStoryStore.getState().addLogsToMatchingStories(newLogs);
+}
+
+// Watcher updates not applied yet: events arriving within a frame are
+// applied together, as one store update
+const FLUSH_TIMEOUT_MS = 250; // Hidden windows get no animation frames
+let pendingUpdates: FileAppendedEvent[] = [];
+let scheduledFlush: { frame: number; timer: number } | null = null;
+
+/**
+ * Apply the pending watcher updates now
+ */
+function flushFileUpdates(watchedPaths: Set<string>): void {
+  if (scheduledFlush) {
+    cancelAnimationFrame(scheduledFlush.frame);
+    window.clearTimeout(scheduledFlush.timer);
+    scheduledFlush = null;
+  }
+  if (pendingUpdates.length === 0) return;
+
+  const updates = pendingUpdates;
+  pendingUpdates = [];
+  const appended: FileAppendedEvent[] = [];
+  for (const update of updates) {
+    if (update.created) {
+      openCreatedFile(update, watchedPaths);
+    } else {
+      appended.push(update);
+    }
+  }
+  applyFileUpdates(appended);
+}
+
+/**
+ * Queue watcher updates to be applied with the next frame
+ */
+function queueFileUpdates(updates: FileAppendedEvent[], watchedPaths: Set<string>): void {
+  for (const update of updates) pendingUpdates.push(update);
+  if (scheduledFlush) return;
+  const flush = () => flushFileUpdates(watchedPaths);
+  scheduledFlush = {
+    frame: requestAnimationFrame(flush),
+    timer: window.setTimeout(flush, FLUSH_TIMEOUT_MS),
+  };
+}
+
 function App() {
   // Log viewer store
   const {
@@ -36,7 +315,16 @@ function App() {
     addFilter,
     removeFilter,
     setInput,
-  } = useLogViewerStore();
+  } = useLogViewerStore(
+    useShallow((state) => ({
+      inactiveNames: state.inactiveNames,
+      filters: state.filters,
+      input: state.input,
+      addFilter: state.addFilter,
+      removeFilter: state.removeFilter,
+      setInput: state.setInput,
+    })),
+  );
 
   // Ensure inactiveNames is a Set (handles hydration race condition)
   const inactiveNames = useMemo(
@@ -60,7 +348,21 @@ function App() {
     removeFromStory,
     moveEntryToStory,
     setMainViewMode,
-  } = useStoryStore();
+  } = useStoryStore(
+    useShallow((state) => ({
+      stories: state.stories,
+      activeStoryId: state.activeStoryId,
+      mainViewMode: state.mainViewMode,
+      createStory: state.createStory,
+      deleteStory: state.deleteStory,
+      renameStory: state.renameStory,
+      setActiveStory: state.setActiveStory,
+      toggleStory: state.toggleStory,
+      removeFromStory: state.removeFromStory,
+      moveEntryToStory: state.moveEntryToStory,
+      setMainViewMode: state.setMainViewMode,
+    })),
+  );
 
   // Get active story
   const activeStory = useMemo(
@@ -80,12 +382,39 @@ function App() {
     addRecentFile: addRecentFileToStore,
     removeRecentFile,
     clearOpenedFiles,
+    sources,
+    addSource,
+    removeSource,
     setLoading,
     setError,
-  } = useFileStore();
+  } = useFileStore(
+    useShallow((state) => ({
+      openedFiles: state.openedFiles,
+      recentFiles: state.recentFiles,
+      isLoading: state.isLoading,
+      error: state.error,
+      openFile: state.openFile,
+      closeFile: state.closeFile,
+      setRecentFiles: state.setRecentFiles,
+      addRecentFile: state.addRecentFile,
+      removeRecentFile: state.removeRecentFile,
+      clearOpenedFiles: state.clearOpenedFiles,
+      sources: state.sources,
+      addSource: state.addSource,
+      removeSource: state.removeSource,
+      setLoading: state.setLoading,
+      setError: state.setError,
+    })),
+  );
 
-  // Settings store - theme
-  const { theme, setTheme } = useSettingsStore();
+  // Settings store - theme and backend load threads
+  const { theme, setTheme, loadThreads } = useSettingsStore(
+    useShallow((state) => ({
+      theme: state.theme,
+      setTheme: state.setTheme,
+      loadThreads: state.loadThreads,
+    })),
+  );
 
   // File input ref (for browser mode)
   const fileInputRef = useRef<HTMLInputElement>(null);
@@ -96,6 +425,19 @@ function App() {
   // Sidebar collapsed state
   const [sidebarCollapsed, setSidebarCollapsed] = useState(false);
 
+  // Diagnostics panel (Cmd/Ctrl+Shift+D)
+  const [showDiagnostics, setShowDiagnostics] = useState(false);
+  useEffect(() => {
+    const handleKeyDown = (e: KeyboardEvent) => {
+      if ((e.metaKey || e.ctrlKey) && e.shiftKey && e.key.toLowerCase() === "d") {
+        e.preventDefault();
+        setShowDiagnostics((shown) => !shown);
+      }
+    };
+    window.addEventListener("keydown", handleKeyDown);
+    return () => window.removeEventListener("keydown", handleKeyDown);
+  }, []);
+
   // Search state for log stream
   const [searchQuery, setSearchQuery] = useState("");
   const [searchIsRegex, setSearchIsRegex] = useState(false);
@@ -123,31 +465,106 @@ function App() {
     [openedFiles],
   );
 
-  // Merged logs from all open files, sorted by (timestamp, sortIndex)
-  // sortIndex ensures stable ordering for lines without parseable timestamps
+  // Merged logs from all open files, sorted by (timestamp, sortIndex), ties
+  // in file order. Files are merged as sorted runs; appends only touch the
+  // newest end of the timeline.
+  const timelineRef = useRef(new Timeline());
   const mergedLogs = useMemo(() => {
-    const allLogs: LogEntry[] = [];
-    safeOpenedFiles.forEach((file) => {
-      allLogs.push(...file.logs);
-    });
-    // Sort by timestamp first, then by sortIndex for stable ordering within same timestamp
-    return allLogs.sort((a, b) => {
-      const timestampDiff = (a.timestamp ?? 0) - (b.timestamp ?? 0);
-      if (timestampDiff !== 0) return timestampDiff;
-      return (a.sortIndex ?? 0) - (b.sortIndex ?? 0);
-    });
+    const files = Array.from(safeOpenedFiles.values(), (file) => file.logs);
+    const merged = timelineRef.current.update(files);
+    // Text filters over the timeline resolve through the files' token indexes
+    const indexes = files.map(getTextIndex);
+    if (indexes.every((index) => index !== null)) {
+      setListTextIndex(merged, timelineTextIndex(indexes as TokenIndex[]));
+    }
+    return merged;
   }, [safeOpenedFiles]);
 
-  // Filter logs for display (apply filters)
+  // Browser mode: parsing, filtering and search run in the log worker and
+  // come back as row indices; LogViewer then only sorts and renders
+  const workerPipeline = useMemo(() => !isTauri() && isLogWorkerSupported(), []);
+  const [workerView, setWorkerView] = useState<{
+    filterId: number; // 0 when filtered on this thread
+    logs: LogEntry[];
+  } | null>(null);
+  const [workerSearchMatches, setWorkerSearchMatches] = useState<number[]>([]);
+
+  // Filter logs for display (filters are compiled once per change)
+  const filterPlan = useMemo(() => compileFilters(filters), [filters]);
   const filteredLogs = useMemo(() => {
-    return filterLogs(mergedLogs, filters, inactiveNames);
-  }, [mergedLogs, filters, inactiveNames]);
+    if (workerPipeline) return workerView?.logs ?? [];
+    return filterLogs(mergedLogs, filterPlan, inactiveNames);
+  }, [workerPipeline, workerView, mergedLogs, filterPlan, inactiveNames]);
+
+  useEffect(() => {
+    if (!workerPipeline) return;
+    const controller = new AbortController();
+    const files = Array.from(safeOpenedFiles.values());
+
+    filterInWorker(
+      files.map((file) => file.path),
+      filters,
+      inactiveNames,
+      controller.signal,
+    )
+      .then((result) => {
+        // Rows map onto the store's logs only if both hold the same rows
+        // (not for files the worker never parsed or the store trimmed)
+        const aligned =
+          !result.missing &&
+          files.every((file, i) => file.logs.length === result.totals[i]);
+        if (!aligned) {
+          setWorkerView({
+            filterId: 0,
+            logs: filterLogs(mergedLogs, filterPlan, inactiveNames),
+          });
+          return;
+        }
+        const logs: LogEntry[] = new Array(result.rows.length);
+        for (let i = 0; i < logs.length; i++) {
+          logs[i] = files[result.files[i]].logs.at(result.rows[i]) as LogEntry;
+        }
+        setWorkerView({ filterId: result.filterId, logs });
+      })
+      .catch((err) => {
+        if (!isAbortError(err)) console.error("Log worker filter failed:", err);
+      });
+
+    // Typing a new filter aborts the pass in flight
+    return () => controller.abort();
+  }, [workerPipeline, safeOpenedFiles, mergedLogs, filters, filterPlan, inactiveNames]);
+
+  const workerSearchActive = workerPipeline && !!workerView?.filterId;
+  useEffect(() => {
+    if (!workerSearchActive || !workerView) return;
+    setWorkerSearchMatches([]);
+    if (!searchQuery.trim()) return;
+    const controller = new AbortController();
+
+    searchInWorker(workerView.filterId, searchQuery, searchIsRegex, controller.signal)
+      .then((matches) => setWorkerSearchMatches(Array.from(matches).reverse()))
+      .catch((err) => {
+        if (!isAbortError(err)) console.error("Log worker search failed:", err);
+      });
+
+    return () => controller.abort();
+  }, [workerSearchActive, workerView, searchQuery, searchIsRegex]);
+
+  // Release the worker's copy of closed files
+  const workerFileKeysRef = useRef<string[]>([]);
+  useEffect(() => {
+    if (!workerPipeline) return;
+    for (const key of workerFileKeysRef.current) {
+      if (!safeOpenedFiles.has(key)) dropWorkerFile(key);
+    }
+    workerFileKeysRef.current = Array.from(safeOpenedFiles.keys());
+  }, [workerPipeline, safeOpenedFiles]);
 
   // Search matches in filtered logs
   // Note: filteredLogs is in ascending order (oldest first), but LogViewer displays
   // newest-first. So we reverse the matches to match visual order (top to bottom).
-  const searchMatches = useMemo(() => {
-    if (!searchQuery.trim()) return [];
+  const localSearchMatches = useMemo(() => {
+    if (workerSearchActive || !searchQuery.trim()) return [];
 
     const matches: number[] = []; // indices into filteredLogs
 
@@ -168,7 +585,8 @@ function App() {
 
     // Reverse to match visual order (newest/top first)
     return matches.reverse();
-  }, [searchQuery, searchIsRegex, filteredLogs]);
+  }, [workerSearchActive, searchQuery, searchIsRegex, filteredLogs]);
+  const searchMatches = workerSearchActive ? workerSearchMatches : localSearchMatches;
 
   // Reset search index when query changes
   useEffect(() => {
@@ -180,6 +598,11 @@ function App() {
     document.documentElement.setAttribute("data-theme", theme);
   }, [theme]);
 
+  // Tell the backend how many threads to open large files with
+  useEffect(() => {
+    if (isTauri()) setLoadThreads(loadThreads);
+  }, [loadThreads]);
+
   // Current match hash for scrolling and highlighting
   const searchCurrentMatchHash = useMemo(() => {
     if (searchMatches.length === 0) return null;
@@ -202,13 +625,196 @@ function App() {
     }
   }, [searchMatches.length]);
 
+  // Whole-file search: the loaded logs are only a window of large files, so
+  // the backend also scans every opened file and streams back matching lines
+  const [fileSearchMatchCount, setFileSearchMatchCount] = useState(0);
+  const [fileSearchScanning, setFileSearchScanning] = useState(false);
+  const fileSearchMatchesRef = useRef<{ path: string; match: SearchMatch }[]>([]);
+  const fileSearchIndexRef = useRef(0);
+  const openedPathsKey = useMemo(
+    () =>
+      Array.from(safeOpenedFiles.values())
+        .filter(isBackendFile)
+        .map((file) => file.path)
+        .sort()
+        .join("\n"),
+    [safeOpenedFiles],
+  );
+
+  useEffect(() => {
+    fileSearchMatchesRef.current = [];
+    fileSearchIndexRef.current = 0;
+    setFileSearchMatchCount(0);
+    setFileSearchScanning(false);
+
+    const paths = openedPathsKey ? openedPathsKey.split("\n") : [];
+    if (!isTauri() || !searchQuery.trim() || paths.length === 0) return;
+
+    // One search id per file so each scan can be cancelled
+    const searchIds = paths.map((_, i) => `search-${Date.now()}-${i}`);
+    let stopped = false;
+    let unlisten: (() => void) | null = null;
+
+    const timer = setTimeout(async () => {
+      unlisten = await onSearchMatches((event) => {
+        if (!searchIds.includes(event.searchId)) return;
+        for (const match of event.matches) {
+          fileSearchMatchesRef.current.push({ path: event.path, match });
+        }
+        setFileSearchMatchCount(fileSearchMatchesRef.current.length);
+      });
+      if (stopped) {
+        unlisten();
+        return;
+      }
+
+      setFileSearchScanning(true);
+      const results = await Promise.all(
+        paths.map((path, i) =>
+          searchFile(path, searchQuery, searchIsRegex, searchIds[i]),
+        ),
+      );
+      if (stopped) return;
+      setFileSearchScanning(false);
+
+      // Batches arrive out of order - keep matches in file order for navigation
+      fileSearchMatchesRef.current.sort(
+        (a, b) =>
+          a.path.localeCompare(b.path) || a.match.lineNumber - b.match.lineNumber,
+      );
+      if (results.some((r) => r.truncated)) {
+        useToastStore
+          .getState()
+          .addToast("info", "Too many matches in file - showing the first ones");
+      }
+    }, FILE_SEARCH_DEBOUNCE_MS);
+
+    return () => {
+      stopped = true;
+      clearTimeout(timer);
+      unlisten?.();
+      searchIds.forEach((id) => cancelSearch(id));
+    };
+  }, [searchQuery, searchIsRegex, openedPathsKey]);
+
+  // Load the file section around the next whole-file match and scroll to it
+  const handleSearchInFiles = useCallback(async () => {
+    const matches = fileSearchMatchesRef.current;
+    if (matches.length === 0) return;
+
+    const index = fileSearchIndexRef.current % matches.length;
+    fileSearchIndexRef.current = index + 1;
+    const { path, match } = matches[index];
+
+    const line = match.lineNumber - 1;
+    const start = Math.max(0, line - SEARCH_SECTION_LINES / 2);
+    const result = await parseLines(path, start, SEARCH_SECTION_LINES);
+    const openedFile = useFileStore.getState().openedFiles.get(path);
+    if (!result.success || !result.logs || !openedFile) {
+      useToastStore
+        .getState()
+        .addToast("error", result.error || "Could not load search match");
+      return;
+    }
+
+    openFile({
+      ...openedFile,
+      logs: result.logs,
+      firstLine: result.startLine ?? start,
+    });
+
+    const snippet = match.snippet.trim();
+    const target = result.logs.find((l) => l.data.includes(snippet));
+    useToastStore
+      .getState()
+      .addToast(
+        "added",
+        `Match ${index + 1} of ${matches.length}: line ${match.lineNumber.toLocaleString()} of ${openedFile.name}`,
+      );
+    if (target?.hash) {
+      const hash = target.hash;
+      setTimeout(() => setJumpToHash(hash), 100);
+    }
+  }, [openFile]);
+
+  // Load the lines of a time range from the whole files (via the backend
+  // time index) and scroll to its start
+  const handleJumpToTime = useCallback(
+    async (fromText: string, toText: string) => {
+      const { openedFiles } = useFileStore.getState();
+      const files = Array.from(openedFiles.values()).filter(isBackendFile);
+      if (files.length === 0) return;
+
+      // Times without a date are on the day of the newest loaded log
+      let newest = 0;
+      for (const file of files) {
+        for (const log of file.logs) newest = Math.max(newest, log.timestamp ?? 0);
+      }
+      const reference = newest || Date.now();
+      const from = parseTimeInput(fromText, reference);
+      let to = toText ? parseTimeInput(toText, reference, true) : Number.MAX_SAFE_INTEGER;
+      if (from === null || to === null) {
+        useToastStore
+          .getState()
+          .addToast("error", "Unrecognized time - use HH:MM[:SS] or YYYY-MM-DD HH:MM[:SS]");
+        return;
+      }
+      // "23:50 - 00:10" ends the next day
+      if (to < from && !/\d{4}-/.test(toText)) to += DAY_MS;
+
+      const results = await Promise.all(
+        files.map(async (file) => ({ file, result: await readTimeRange(file.path, from, to) })),
+      );
+
+      let loaded = 0;
+      let truncated = false;
+      let target: LogEntry | undefined;
+      for (const { file, result } of results) {
+        if (!result.success || !result.logs?.length) continue;
+        const current = useFileStore.getState().openedFiles.get(file.path) ?? file;
+        openFile({ ...current, logs: result.logs, firstLine: result.startLine });
+        loaded += 1;
+        truncated ||= !!result.truncated;
+        const first = result.logs.find((l) => (l.timestamp ?? 0) >= from);
+        if (first && (!target || (first.timestamp ?? 0) < (target.timestamp ?? 0))) {
+          target = first;
+        }
+      }
+
+      const label = toText ? `${fromText}–${toText}` : `${fromText} onwards`;
+      if (loaded === 0) {
+        const error = results.find((r) => r.result.error)?.result.error;
+        useToastStore.getState().addToast("removed", error || `Nothing logged in ${label}`);
+        return;
+      }
+      useToastStore
+        .getState()
+        .addToast(
+          "added",
+          `Loaded ${label} from ${loaded} ${loaded === 1 ? "file" : "files"}${truncated ? " (first 2000 lines)" : ""}`,
+        );
+      if (target?.hash) {
+        const hash = target.hash;
+        setTimeout(() => setJumpToHash(hash), 100);
+      }
+    },
+    [openFile],
+  );
+
   // Error/warning navigation - LogViewer handles the actual navigation,
   // we just track stats and trigger navigation via counter increments
-  const [errorWarningStats, setErrorWarningStats] = useState({
+  const [errorWarningStats, setErrorWarningStats] = useState<{
+    errorCount: number;
+    warningCount: number;
+    currentErrorIndex: number;
+    currentWarningIndex: number;
+    byService: ServiceLevelCounts[];
+  }>({
     errorCount: 0,
     warningCount: 0,
     currentErrorIndex: -1,
     currentWarningIndex: -1,
+    byService: [],
   });
 
   // Navigation triggers - increment to trigger navigation in LogViewer
@@ -266,8 +872,12 @@ function App() {
     loadRecentFiles();
   }, [setRecentFiles]);
 
-  // Restore opened files from previous session (runs once on mount)
+  // Restore opened files from previous session (runs once on mount).
+  // The most recently opened file is loaded and painted first; the rest
+  // parse concurrently in the background and are added in their old order.
   useEffect(() => {
+    logStartupMilestone("shell painted");
+
     const restoreOpenedFiles = async () => {
       if (!isTauri()) return;
 
@@ -275,42 +885,125 @@ function App() {
       const connected = await waitForConnection(5000);
       if (!connected) return;
 
-      // Get paths that were open in previous session
-      const pathsToRestore = useFileStore.getState().getPathsToRestore();
-      if (pathsToRestore.length === 0) return;
-
-      // Restore each file (only if it's not already open)
-      for (const path of pathsToRestore) {
-        // Skip if already open (shouldn't happen, but be safe)
-        const currentOpened = useFileStore.getState().openedFiles;
-        if (currentOpened.has(path)) continue;
-
-        // Only restore files that exist on disk (skip if path doesn't start with /)
-        if (!path.startsWith("/")) continue;
+      // Get paths that were open in previous session - only files on disk
+      // (absolute paths) that aren't open yet
+      const { openedFiles, recentFiles, sources } = useFileStore.getState();
+      const paths = useFileStore
+        .getState()
+        .getPathsToRestore()
+        .filter((path) => path.startsWith("/") && !openedFiles.has(path));
+      if (paths.length === 0 && sources.length === 0) return;
+
+      let rest = paths;
+      if (paths.length > 0) {
+        const lastOpened = new Map(recentFiles.map((f) => [f.path, f.lastOpened]));
+        const first = paths.reduce((a, b) =>
+          (lastOpened.get(b) ?? 0) > (lastOpened.get(a) ?? 0) ? b : a,
+        );
+        await handleOpenFile(first);
+        logStartupMilestone("first file painted");
+        rest = paths.filter((path) => path !== first);
+      }
 
-        try {
-          // Open the file (this will handle errors if file doesn't exist)
-          // Use the store's state directly to avoid dependency issues
-          await handleOpenFile(path);
-        } catch (err) {
-          // File might have been deleted/moved - silently skip it
-          console.log(`Skipping restore for ${path}:`, err);
+      // Reopen sources - their files are listed again, including ones
+      // created while the app was closed
+      const sourceOf = new Map<string, string>();
+      for (const spec of sources) {
+        const result = await watchSource(spec);
+        if (!result.success) {
+          useFileStore.getState().removeSource(spec);
+          useToastStore.getState().addToast("removed", result.error || `Cannot open ${spec}`);
+          continue;
+        }
+        for (const path of result.files ?? []) {
+          if (!sourceOf.has(path) && !paths.includes(path)) sourceOf.set(path, spec);
         }
       }
+      rest = rest.concat(Array.from(sourceOf.keys()));
+
+      await parseFilesInOrder(rest, (path, result) => {
+        // Skip if opened meanwhile (e.g. dropped by the user)
+        if (useFileStore.getState().openedFiles.has(path)) return;
+        // File might have been deleted/moved - the error is shown and we move on
+        openParsedFile(path, result, sourceOf.get(path));
+      });
+      if (rest.length > 0) logStartupMilestone(`${paths.length + sourceOf.size} files restored`);
 
       // Clear the restore paths after restoration
       useFileStore.getState().clearPathsToRestore();
     };
 
-    // Small delay to ensure store is hydrated
+    // After the first paint (the store hydrates synchronously from localStorage)
     const timer = setTimeout(() => {
       restoreOpenedFiles();
-    }, 100);
+    }, 0);
 
     return () => clearTimeout(timer);
     // eslint-disable-next-line react-hooks/exhaustive-deps
   }, []); // Run only once on mount
 
+  // Add a file parsed by the backend to the view (files of a source are
+  // announced once for the source, and not added to the recent files)
+  const openParsedFile = useCallback(
+    (path: string, result: ParseFileResult, source?: string) => {
+      if (!result.success) {
+        setError(result.error || "Failed to read file");
+        return;
+      }
+
+      const filePath = result.path ?? path;
+      const fileName = result.name ?? path.split("/").pop() ?? "unknown";
+      const fileSize = result.size ?? 0;
+      const logs = result.logs ?? [];
+
+      console.log(`${logs.length} logs from ${fileName}`);
+
+      // Add file to opened files map
+      const newFile: NewOpenedFile = {
+        path: filePath,
+        name: fileName,
+        size: fileSize,
+        logs,
+        lastModified: fileSize,
+        mtime: result.mtime,
+        firstLine: result.startLine,
+        source,
+      };
+      openFile(newFile);
+
+      // Scan loaded logs against logbook patterns (covers initial open + restore)
+      if (logs.length > 0) {
+        useStoryStore.getState().addLogsToMatchingStories(logs);
+      }
+      if (source) return;
+
+      // Show toast and highlight sidebar
+      const lineCount = logs.length;
+      useToastStore
+        .getState()
+        .addToast(
+          "added",
+          `Added: ${fileName} (${lineCount.toLocaleString()} lines)`,
+        );
+      setHighlightedFilePath(filePath);
+      setTimeout(() => setHighlightedFilePath(null), 1000);
+
+      // Background updates - use store action to avoid race conditions with multiple drops
+      setTimeout(() => {
+        addRecentFile(filePath); // Persist to Tauri backend
+        addRecentFileToStore({
+          path: filePath,
+          name: fileName,
+          lastOpened: Date.now(),
+          exists: true,
+          size: fileSize,
+          mtime: result.mtime,
+        });
+      }, 0);
+    },
+    [openFile, setError, addRecentFileToStore],
+  );
+
   // Handle opening a file (adds to view, doesn't replace)
   const handleOpenFile = useCallback(
     async (path?: string) => {
@@ -332,68 +1025,12 @@ function App() {
 
         try {
           console.time("total");
-          console.time("read");
-          const result = await readFile(path, 0);
-          console.timeEnd("read");
-
-          if (!result.success) {
-            setError(result.error || "Failed to read file");
-            setLoading(false);
-            return;
-          }
-
-          const fileContent = result.content ?? "";
-          const filePath = result.path ?? path;
-          const fileName = result.name ?? path.split("/").pop() ?? "unknown";
-          const fileSize = result.size ?? 0;
-
-          console.time("parse");
-          const parsed = parseLogFile(fileContent, fileName, filePath);
-          console.timeEnd("parse");
-
-          console.log(`${parsed.logs.length} logs from ${fileName}`);
-
-          // Add file to opened files map
-          const newFile: OpenedFileWithLogs = {
-            path: filePath,
-            name: fileName,
-            size: fileSize,
-            logs: parsed.logs,
-            lastModified: fileSize,
-            mtime: result.mtime,
-          };
-          openFile(newFile);
-
-          // Scan loaded logs against logbook patterns (covers initial open + restore)
-          if (parsed.logs.length > 0) {
-            useStoryStore.getState().addLogsToMatchingStories(parsed.logs);
-          }
-
-          // Show toast and highlight sidebar
-          const lineCount = parsed.logs.length;
-          useToastStore
-            .getState()
-            .addToast(
-              "added",
-              `Added: ${fileName} (${lineCount.toLocaleString()} lines)`,
-            );
-          setHighlightedFilePath(filePath);
-          setTimeout(() => setHighlightedFilePath(null), 1000);
-
+          console.time("read+parse");
+          // Read and parse in the backend so large files don't block the UI thread
+          const result = await parseFile(path, 0);
+          console.timeEnd("read+parse");
+          openParsedFile(path, result);
           console.timeEnd("total");
-
-          // Background updates - use store action to avoid race conditions with multiple drops
-          setTimeout(() => {
-            addRecentFile(filePath); // Persist to Tauri backend
-            addRecentFileToStore({
-              path: filePath,
-              name: fileName,
-              lastOpened: Date.now(),
-              exists: true,
-              size: fileSize,
-              mtime: result.mtime,
-            });
-          }, 0);
         } catch (err) {
           setError(err instanceof Error ? err.message : "Failed to open file");
         } finally {
@@ -404,7 +1041,7 @@ function App() {
           try {
             const selected = await openFileDialog({
               multiple: false,
-              filters: [{ name: "Log Files", extensions: ["log", "txt"] }],
+              filters: [{ name: "Log Files", extensions: ["log", "txt", "gz", "zst"] }],
             });
             if (selected) {
               handleOpenFile(selected);
@@ -419,7 +1056,61 @@ function App() {
         }
       }
     },
-    [safeOpenedFiles, openFile, setLoading, setError, addRecentFileToStore],
+    [safeOpenedFiles, openParsedFile, setLoading, setError],
+  );
+
+  // Open a directory or glob source: its files are opened together and
+  // tailed by one backend watcher, which also opens files that start matching
+  const handleOpenSource = useCallback(
+    async (spec?: string) => {
+      if (!isTauri()) {
+        setError("Cannot open folders in browser mode");
+        return;
+      }
+      if (!spec) {
+        try {
+          const selected = await openFileDialog({ directory: true, multiple: false });
+          if (selected) {
+            handleOpenSource(selected);
+          }
+        } catch (err) {
+          setError(err instanceof Error ? err.message : "Failed to open folder dialog");
+        }
+        return;
+      }
+      if (useFileStore.getState().sources.includes(spec)) return;
+
+      setLoading(true);
+      setError(null);
+      try {
+        const result = await watchSource(spec);
+        if (!result.success) {
+          setError(result.error || "Failed to open folder");
+          return;
+        }
+        addSource(spec);
+
+        const paths = (result.files ?? []).filter(
+          (path) => !useFileStore.getState().openedFiles.has(path),
+        );
+        let opened = 0;
+        await parseFilesInOrder(paths, (path, parsed) => {
+          const state = useFileStore.getState();
+          // Source closed, or the file opened, while the files were loading
+          if (!state.sources.includes(spec) || state.openedFiles.has(path)) return;
+          openParsedFile(path, parsed, spec);
+          if (parsed.success) opened++;
+        });
+        useToastStore
+          .getState()
+          .addToast("added", `Added: ${spec} (${opened.toLocaleString()} files)`);
+      } catch (err) {
+        setError(err instanceof Error ? err.message : "Failed to open folder");
+      } finally {
+        setLoading(false);
+      }
+    },
+    [openParsedFile, addSource, setLoading, setError],
   );
 
   // Jump to source from logbook - open file if needed, minimize logbook and scroll to the log
@@ -457,10 +1148,9 @@ function App() {
         // Wait for the file to be loaded and rendered, then check if we found it
         setTimeout(async () => {
           // Re-check if the log exists after opening the file
-          const currentLogs = Array.from(
+          const foundAfterOpen = Array.from(
             useFileStore.getState().openedFiles.values(),
-          ).flatMap((f) => f.logs);
-          const foundAfterOpen = currentLogs.some((l) => l.hash === hash);
+          ).some((f) => f.logs.toArray().some((l) => l.hash === hash));
 
           if (foundAfterOpen) {
             setJumpToHash(hash);
@@ -493,18 +1183,49 @@ function App() {
   );
 
   // Helper: Search file for a log line and load that section
+  // (a new jump cancels the search of the previous one)
+  const jumpSearchIdRef = useRef<string | null>(null);
   const loadLogSectionFromFile = useCallback(
     async (filePath: string, log: LogEntry) => {
       const hash = log.hash;
       if (!hash) return;
 
+      if (jumpSearchIdRef.current) {
+        cancelSearch(jumpSearchIdRef.current);
+      }
+      const searchId = `jump-${Date.now()}`;
+      jumpSearchIdRef.current = searchId;
+
+      // Searches that outlast the first chunk report progress - tell the user once
+      let notified = false;
+      const unlisten = await onSearchProgress((event) => {
+        if (event.searchId !== searchId || notified) return;
+        notified = true;
+        useToastStore
+          .getState()
+          .addToast("info", "Searching large file for log line...");
+      });
+
       // Search the file for the exact log line
-      const result = await searchFileForLine(filePath, log.data, 1000);
+      const result = await searchFileForLine(
+        filePath,
+        log.data,
+        1000,
+        searchId,
+      );
+      unlisten();
+      if (jumpSearchIdRef.current === searchId) {
+        jumpSearchIdRef.current = null;
+      }
+      if (result.error === "Search cancelled") return;
 
       if (result.success && result.content) {
         // Parse the section and update the file's logs
         const fileName = filePath.split("/").pop() || "unknown";
-        const parsed = parseLogFile(result.content, fileName, filePath);
+        const content = result.content;
+        const parsed = measure("parse", () => parseLogFile(content, fileName, filePath), {
+          path: filePath,
+        });
 
         // Find the target log in the parsed section
         const targetLog = parsed.logs.find((l) => l.data === log.data);
@@ -513,9 +1234,10 @@ function App() {
           // Update the file's logs with this section
           const openedFile = safeOpenedFiles.get(filePath);
           if (openedFile) {
-            const updatedFile: OpenedFileWithLogs = {
+            const updatedFile: NewOpenedFile = {
               ...openedFile,
               logs: parsed.logs,
+              firstLine: result.startLine,
             };
             openFile(updatedFile);
 
@@ -555,66 +1277,105 @@ function App() {
     setJumpToHash(null);
   }, []);
 
+  // Page back through large files: when the oldest loaded log is reached,
+  // load the previous lines of every file that has more (via the line index)
+  const loadingOlderRef = useRef(false);
+  const handleLoadOlder = useCallback(async () => {
+    if (!isTauri() || loadingOlderRef.current) return;
+
+    const files = Array.from(useFileStore.getState().openedFiles.values()).filter(
+      (f) => isBackendFile(f) && (f.firstLine ?? 0) > 0,
+    );
+    if (files.length === 0) return;
+
+    loadingOlderRef.current = true;
+    try {
+      await Promise.all(
+        files.map(async (file) => {
+          const end = file.firstLine ?? 0;
+          const start = Math.max(0, end - OLDER_PAGE_LINES);
+          const result = await parseLines(file.path, start, end - start);
+          if (!result.success) {
+            console.error(`Failed to load older logs for ${file.name}:`, result.error);
+            return;
+          }
+          useFileStore
+            .getState()
+            .prependFileLogs(file.path, result.logs ?? [], result.startLine ?? start);
+        }),
+      );
+    } finally {
+      loadingOlderRef.current = false;
+    }
+  }, []);
+
   // Handle file selection from browser file input
   const handleFileInputChange = useCallback(
-    (e: React.ChangeEvent<HTMLInputElement>) => {
+    async (e: React.ChangeEvent<HTMLInputElement>) => {
       const file = e.target.files?.[0];
+      e.target.value = "";
       if (!file) return;
 
       // Check if file is already opened
       const existing = safeOpenedFiles.get(file.name);
       if (existing) {
         // File already open - nothing to do
-        e.target.value = "";
         return;
       }
 
       setLoading(true);
       setError(null);
 
-      const reader = new FileReader();
-      reader.onload = (evt) => {
-        try {
-          const content = evt.target?.result as string;
-          const parsed = parseLogFile(content, file.name, file.name);
-
-          const newFile: OpenedFileWithLogs = {
+      try {
+        // Parse in the log worker when available (the bytes are transferred)
+        let parsed: ParsedLogFileResult;
+        let size: number;
+        if (workerPipeline) {
+          const start = performance.now();
+          ({ result: parsed, size } = await parseFileInWorker(file, file.name));
+          recordSpan("parse", start, performance.now() - start, {
             path: file.name,
-            name: file.name,
-            size: content.length,
-            logs: parsed.logs,
-            lastModified: content.length,
-          };
-          openFile(newFile);
-
-          // Scan loaded logs against logbook patterns
-          if (parsed.logs.length > 0) {
-            useStoryStore.getState().addLogsToMatchingStories(parsed.logs);
-          }
+            count: parsed.logs.length,
+          });
+        } else {
+          const content = await file.text();
+          parsed = measure("parse", () => parseLogFile(content, file.name, file.name), {
+            path: file.name,
+          });
+          size = content.length;
+        }
 
-          setTimeout(() => {
-            addRecentFileToStore({
-              path: file.name,
-              name: file.name,
-              lastOpened: Date.now(),
-              exists: true,
-              size: content.length,
-            });
-          }, 0);
-        } catch (err) {
-          setError(err instanceof Error ? err.message : "Failed to parse file");
-        } finally {
-          setLoading(false);
+        const newFile: NewOpenedFile = {
+          path: file.name,
+          name: file.name,
+          size,
+          logs: parsed.logs,
+          lastModified: size,
+          inMemory: true,
+        };
+        openFile(newFile);
+
+        // Scan loaded logs against logbook patterns
+        if (parsed.logs.length > 0) {
+          useStoryStore.getState().addLogsToMatchingStories(parsed.logs);
         }
-      };
-      reader.onerror = () => {
-        setError("Failed to read file");
+
+        setTimeout(() => {
+          addRecentFileToStore({
+            path: file.name,
+            name: file.name,
+            lastOpened: Date.now(),
+            exists: true,
+            size,
+          });
+        }, 0);
+      } catch (err) {
+        setError(err instanceof Error ? err.message : "Failed to parse file");
+      } finally {
         setLoading(false);
-      };
-      reader.readAsText(file);
-      e.target.value = "";
+      }
     },
-    [safeOpenedFiles, openFile, setLoading, setError, addRecentFileToStore],
+    [safeOpenedFiles, workerPipeline, openFile, setLoading, setError, addRecentFileToStore],
   );
 
   // Tauri drag/drop event listener - uses native file paths for recent files persistence
@@ -632,10 +1393,14 @@ function App() {
           // Open each dropped file using the same path as "Open File"
           const paths = event.payload.paths as string[];
           for (const path of paths) {
-            // Filter to only .log and .txt files
+            // Filter to only .log and .txt files (and rotated .gz/.zst logs,
+            // which the backend reads decompressed)
             const lowerPath = path.toLowerCase();
-            if (lowerPath.endsWith(".log") || lowerPath.endsWith(".txt")) {
+            if (/\.(log|txt|gz|zst|zstd)$/.test(lowerPath)) {
               handleOpenFile(path);
+            } else if (!/\.[^\\/]*$/.test(lowerPath)) {
+              // No extension - most likely a directory, opened as a source
+              handleOpenSource(path);
             }
           }
         } else {
@@ -650,7 +1415,7 @@ function App() {
     return () => {
       unlisten?.();
     };
-  }, [handleOpenFile]);
+  }, [handleOpenFile, handleOpenSource]);
 
   // Handle clicking a file in sidebar - open if not already open
   const handleSelectFile = useCallback(
@@ -701,69 +1466,117 @@ function App() {
     [removeRecentFile, recentFiles],
   );
 
-  // Polling effect for open files
+  // Files handed to the backend watcher, and the ones it couldn't watch
+  // (those fall back to polling)
+  const watchedPathsRef = useRef<Set<string>>(new Set());
+  const pollFallbackPathsRef = useRef<Set<string>>(new Set());
+
+  // Keep the backend watcher in sync with the set of open files
+  // (one call for everything opened or closed at once)
+  useEffect(() => {
+    if (!isTauri()) return;
+
+    const watched = watchedPathsRef.current;
+    const fallback = pollFallbackPathsRef.current;
+
+    const added: { path: string; offset: number }[] = [];
+    safeOpenedFiles.forEach((file) => {
+      if (!isBackendFile(file) || watched.has(file.path)) return;
+      watched.add(file.path);
+      added.push({ path: file.path, offset: file.lastModified });
+    });
+    if (added.length > 0) {
+      watchFiles(added).then((failed) => {
+        for (const path of failed) {
+          if (watched.has(path)) fallback.add(path);
+        }
+      });
+    }
+
+    const removed: string[] = [];
+    for (const path of Array.from(watched)) {
+      if (!safeOpenedFiles.has(path)) {
+        watched.delete(path);
+        fallback.delete(path);
+        removed.push(path);
+      }
+    }
+    if (removed.length > 0) {
+      unwatchFiles(removed);
+    }
+  }, [safeOpenedFiles]);
+
+  // Stop watching closed sources (they are watched when opened)
+  const watchedSourcesRef = useRef<Set<string>>(new Set());
+  useEffect(() => {
+    if (!isTauri()) return;
+
+    const watched = watchedSourcesRef.current;
+    sources.forEach((spec) => watched.add(spec));
+    for (const spec of Array.from(watched)) {
+      if (!sources.includes(spec)) {
+        watched.delete(spec);
+        unwatchSource(spec);
+      }
+    }
+  }, [sources]);
+
+  // Receive new content pushed by the backend watcher (one event per flush,
+  // covering every file that changed; events within a frame are applied
+  // as one store update)
   // Note: We get fresh state inside the callback to avoid stale closure issues
   // that could cause lines to be skipped or duplicated
   useEffect(() => {
     if (!isTauri()) return;
 
-    // Only run polling if we have open files (quick check)
-    const hasOpenFiles = Array.from(safeOpenedFiles.values()).some((f) =>
-      f.path.startsWith("/"),
-    );
-    if (!hasOpenFiles) return;
+    let unlisten: (() => void) | undefined;
+    let cancelled = false;
 
-    const pollInterval = window.setInterval(async () => {
-      // Get FRESH state inside callback to avoid stale closures
-      const currentFiles = useFileStore.getState().openedFiles;
-      const openFiles = Array.from(currentFiles.values()).filter((f) =>
-        f.path.startsWith("/"),
-      );
+    onFilesAppended((event) => {
+      queueFileUpdates(event.files, watchedPathsRef.current);
+    }).then((fn) => {
+      if (cancelled) {
+        fn();
+      } else {
+        unlisten = fn;
+      }
+    });
+
+    return () => {
+      cancelled = true;
+      unlisten?.();
+    };
+  }, []);
+
+  // Fallback polling for files the native watcher couldn't watch
+  useEffect(() => {
+    if (!isTauri()) return;
 
-      for (const file of openFiles) {
+    const pollInterval = window.setInterval(async () => {
+      const fallback = pollFallbackPathsRef.current;
+      if (fallback.size === 0) return;
+      // Read on from what watcher updates still pending would set
+      flushFileUpdates(watchedPathsRef.current);
+
+      const updates: FileUpdate[] = [];
+      for (const path of Array.from(fallback)) {
+        // Get FRESH state for each file to avoid stale offsets
+        const file = useFileStore.getState().openedFiles.get(path);
+        if (!file) continue;
         try {
-          const result = await readFile(file.path, file.lastModified);
+          const result = await parseFile(file.path, file.lastModified);
           if (!result.success) continue;
-          const newSize = result.size ?? 0;
-
-          if (result.truncated && result.content) {
-            // File was replaced/truncated - reload entirely
-            const newLines = parseLogFile(result.content, file.name, file.path);
-            useFileStore.getState().updateFileLogs(file.path, newLines.logs);
-            // Also update the lastModified (size) for next poll
-            const currentFiles = useFileStore.getState().openedFiles;
-            const updatedFile = currentFiles.get(file.path);
-            if (updatedFile) {
-              useFileStore.getState().openFile({
-                ...updatedFile,
-                lastModified: newSize,
-                mtime: result.mtime,
-              });
-            }
-            // Auto-capture to logbooks with matching patterns
-            if (newLines.logs.length > 0) {
-              useStoryStore.getState().addLogsToMatchingStories(newLines.logs);
-            }
-          } else if (result.content && newSize > file.lastModified) {
-            // Normal append - file grew
-            // Just parse and append - recalculateTimestamps in appendFileLogs handles ordering
-            const newLines = parseLogFile(result.content, file.name, file.path);
-            useFileStore
-              .getState()
-              .appendFileLogs(file.path, newLines.logs, newSize);
-            // Auto-capture to logbooks with matching patterns
-            if (newLines.logs.length > 0) {
-              useStoryStore.getState().addLogsToMatchingStories(newLines.logs);
-            }
-          }
+          updates.push({ ...result, path: file.path });
         } catch (err) {
           console.error(`Polling error for ${file.name}:`, err);
         }
       }
+      // All polled files in one store update
+      applyFileUpdates(updates);
     }, 3000); // Poll every 3 seconds
 
     return () => window.clearInterval(pollInterval);
-  }, [safeOpenedFiles]); // Only re-create interval when files change
+  }, []);
 
   return (
     <div className="h-screen flex" style={{ background: "var(--mocha-bg)" }}>
@@ -789,6 +1602,14 @@ function App() {
         onCloseFile={handleCloseFile}
         onRemoveFile={handleRemoveFile}
         onClearRecent={handleClearRecent}
+        sources={sources}
+        onOpenSource={(spec) => {
+          if (mainViewMode === "logbook") {
+            setMainViewMode("logs");
+          }
+          handleOpenSource(spec);
+        }}
+        onCloseSource={removeSource}
         // Logbook management
         stories={stories}
         activeStoryId={activeStoryId}
@@ -829,11 +1650,16 @@ function App() {
             onSearchRegexToggle={() => setSearchIsRegex(!searchIsRegex)}
             onSearchNext={handleSearchNext}
             onSearchPrev={handleSearchPrev}
+            searchFileMatchCount={fileSearchMatchCount}
+            searchFileScanning={fileSearchScanning}
+            onSearchInFiles={handleSearchInFiles}
+            onJumpToTime={isTauri() ? handleJumpToTime : undefined}
             // Error/warning navigation - stats come from LogViewer
             errorCount={errorWarningStats.errorCount}
             warningCount={errorWarningStats.warningCount}
             currentErrorIndex={errorWarningStats.currentErrorIndex}
             currentWarningIndex={errorWarningStats.currentWarningIndex}
+            levelCountsByService={errorWarningStats.byService}
             onJumpToNextError={handleJumpToNextError}
             onJumpToPrevError={handleJumpToPrevError}
             onJumpToNextWarning={handleJumpToNextWarning}
@@ -917,7 +1743,8 @@ function App() {
                 {/* Virtualized Log viewer */}
                 {mergedLogs.length > 0 ? (
                   <LogViewer
-                    logs={mergedLogs}
+                    logs={workerPipeline ? filteredLogs : mergedLogs}
+                    prefiltered={workerPipeline}
                     onToggleStory={handleToggleStory}
                     searchQuery={searchQuery}
                     searchIsRegex={searchIsRegex}
@@ -930,6 +1757,7 @@ function App() {
                     jumpToPrevError={jumpToPrevErrorTrigger}
                     jumpToNextWarning={jumpToNextWarningTrigger}
                     jumpToPrevWarning={jumpToPrevWarningTrigger}
+                    onLoadOlder={handleLoadOlder}
                   />
                 ) : (
                   /* Beautiful empty state */
@@ -1154,6 +1982,10 @@ function App() {
         </div>
       </div>
 
+      {showDiagnostics && (
+        <DiagnosticsPanel onClose={() => setShowDiagnostics(false)} />
+      )}
+
       {/* Toast notifications */}
       <ToastContainer />
     </div>
@@ -6,7 +6,28 @@
  */
 
 import { invoke } from '@tauri-apps/api/core';
-import type { FileResult, RecentFile, SearchLineResult } from './types';
+import { listen, type UnlistenFn } from '@tauri-apps/api/event';
+import type {
+  ExportTraceResult,
+  FilesAppendedEvent,
+  FileResult,
+  LoadLogbooksResult,
+  LogbookEntriesResult,
+  LogbookOp,
+  LogEntry,
+  ParseFileResult,
+  ParseLinesResult,
+  PatternStats,
+  RecentFile,
+  SearchFileResult,
+  SearchLineResult,
+  SearchMatchesEvent,
+  SearchProgressEvent,
+  SourceResult,
+  TimeRangeResult,
+} from './types';
+import { getPatternStats } from './parser';
+import { recordRoundTrip, recordSpan } from './diagnostics';
 
 /**
  * Check if running in Tauri context
@@ -43,7 +64,9 @@ export async function readFile(path: string, offset: number = 0): Promise<FileRe
   }
 
   try {
+    const start = performance.now();
     const result = await invoke<FileResult>('read_file', { path, offset });
+    recordRoundTrip(start, undefined, { path });
     return result;
   } catch (err) {
     return {
@@ -53,6 +76,199 @@ export async function readFile(path: string, offset: number = 0): Promise<FileRe
   }
 }
 
+/**
+ * Read and parse a file in the backend
+ *
+ * @param path - Full path to the file
+ * @param offset - Byte offset to start reading from (same semantics as readFile)
+ * @returns ParseFileResult with parsed log entries and size info
+ *
+ * Parsing happens off the UI thread, so large tails don't freeze the window.
+ * Behaves like readFile followed by parseLogFile.
+ */
+export async function parseFile(path: string, offset: number = 0): Promise<ParseFileResult> {
+  if (!isTauri()) {
+    return { success: false, error: 'Not running in Tauri context' };
+  }
+
+  try {
+    const start = performance.now();
+    const result = await invoke<ParseFileResult>('parse_file', { path, offset });
+    recordRoundTrip(start, result.backendMs, { path, count: result.logs?.length });
+    return result;
+  } catch (err) {
+    return {
+      success: false,
+      error: err instanceof Error ? err.message : String(err),
+    };
+  }
+}
+
+/**
+ * Read and parse a range of lines (at most 2000) via the backend line-offset index
+ *
+ * @param path - Full path to the file
+ * @param start - First line to read (0-based)
+ * @param count - Number of lines to read
+ * @returns ParseLinesResult with parsed entries - used to page through older logs
+ *
+ * The index is built on first access and extended as the file grows,
+ * so any part of an arbitrarily large file can be read.
+ */
+export async function parseLines(path: string, start: number, count: number): Promise<ParseLinesResult> {
+  if (!isTauri()) {
+    return { success: false, error: 'Not running in Tauri context' };
+  }
+
+  try {
+    return await invoke<ParseLinesResult>('parse_lines', { path, start, count });
+  } catch (err) {
+    return {
+      success: false,
+      error: err instanceof Error ? err.message : String(err),
+    };
+  }
+}
+
+/**
+ * Read and parse the lines of a time range via the backend time index
+ *
+ * @param path - Full path to the file
+ * @param from - Start of the range (epoch ms)
+ * @param to - End of the range (epoch ms, inclusive)
+ * @returns TimeRangeResult with the parsed entries (at most 2000 lines)
+ */
+export async function readTimeRange(path: string, from: number, to: number): Promise<TimeRangeResult> {
+  if (!isTauri()) {
+    return { success: false, error: 'Not running in Tauri context' };
+  }
+
+  try {
+    return await invoke<TimeRangeResult>('read_time_range', { path, from, to });
+  } catch (err) {
+    return {
+      success: false,
+      error: err instanceof Error ? err.message : String(err),
+    };
+  }
+}
+
+/**
+ * Get per-pattern hit/miss counters of the log parser
+ *
+ * @returns Counters from the Rust parser, or from parser.ts in browser mode
+ */
+export async function getParserStats(): Promise<PatternStats[]> {
+  if (!isTauri()) {
+    return getPatternStats();
+  }
+
+  try {
+    return await invoke<PatternStats[]>('get_parser_stats');
+  } catch (err) {
+    console.error('getParserStats error:', err);
+    return [];
+  }
+}
+
+/**
+ * Start watching files for changes via the native backend watcher
+ *
+ * @param files - Full paths and the bytes already loaded from each (new content is read from there)
+ * @returns Paths that can't be watched (caller should poll those)
+ *
+ * Changes are delivered as "files-appended" events - see onFilesAppended.
+ */
+export async function watchFiles(files: { path: string; offset: number }[]): Promise<string[]> {
+  if (!isTauri()) return files.map((f) => f.path);
+
+  try {
+    return await invoke<string[]>('watch_files', { files });
+  } catch (err) {
+    console.error('watchFiles error:', err);
+    return files.map((f) => f.path);
+  }
+}
+
+/**
+ * Stop watching files
+ *
+ * @param paths - Full paths that were passed to watchFiles
+ */
+export async function unwatchFiles(paths: string[]): Promise<void> {
+  if (!isTauri()) return;
+
+  try {
+    await invoke('unwatch_files', { paths });
+  } catch (err) {
+    console.error('unwatchFiles error:', err);
+  }
+}
+
+/**
+ * Start watching a directory or glob source (e.g. /var/log/myapp/*.log)
+ *
+ * @param spec - Directory path, or a glob with wildcards in the file name
+ * @returns The files matching now; files that start matching later arrive in
+ *          "files-appended" events with created set
+ */
+export async function watchSource(spec: string): Promise<SourceResult> {
+  if (!isTauri()) {
+    return { success: false, error: 'Not running in Tauri context' };
+  }
+
+  try {
+    return await invoke<SourceResult>('watch_source', { spec });
+  } catch (err) {
+    return {
+      success: false,
+      error: err instanceof Error ? err.message : String(err),
+    };
+  }
+}
+
+/**
+ * Stop watching a source
+ *
+ * @param spec - Spec that was passed to watchSource
+ */
+export async function unwatchSource(spec: string): Promise<void> {
+  if (!isTauri()) return;
+
+  try {
+    await invoke('unwatch_source', { spec });
+  } catch (err) {
+    console.error('unwatchSource error:', err);
+  }
+}
+
+/**
+ * Subscribe to new content from watched files
+ *
+ * The backend coalesces bursts of writes across all watched files, so each
+ * event carries every file that changed since the previous event, each with
+ * all bytes appended since then.
+ *
+ * @returns Function that removes the listener
+ */
+export async function onFilesAppended(
+  handler: (event: FilesAppendedEvent) => void
+): Promise<UnlistenFn> {
+  if (!isTauri()) return () => {};
+
+  return listen<FilesAppendedEvent>('files-appended', (event) => {
+    const { files, emittedAt } = event.payload;
+    const now = performance.now();
+    const delivery = Math.max(0, Date.now() - emittedAt);
+    for (const { path, logs, backendMs } of files) {
+      recordSpan('backend', now - delivery - backendMs, backendMs, { path, count: logs.length });
+    }
+    const count = files.reduce((sum, f) => sum + f.logs.length, 0);
+    recordSpan('ipc', now - delivery, delivery, { count });
+    handler(event.payload);
+  });
+}
+
 /**
  * Get the list of recently opened files from ~/.mocha/recent.json
  *
@@ -138,6 +354,90 @@ export async function exportFile(path: string, content: string): Promise<boolean
   }
 }
 
+/**
+ * Write diagnostics trace events to the app log (see diagnostics.ts)
+ *
+ * @param events - Chrome trace events
+ * @returns ExportTraceResult with the number of events and the log directory
+ */
+export async function exportTrace(events: object[]): Promise<ExportTraceResult> {
+  if (!isTauri()) {
+    return { success: false, error: 'Not running in Tauri context' };
+  }
+
+  try {
+    return await invoke<ExportTraceResult>('export_trace', { events });
+  } catch (err) {
+    console.error('exportTrace error:', err);
+    return {
+      success: false,
+      error: err instanceof Error ? err.message : String(err),
+    };
+  }
+}
+
+/**
+ * List the logbooks stored in ~/.mocha/logbooks (metadata and entry hashes)
+ *
+ * @returns LoadLogbooksResult; initialized is false if nothing was stored yet
+ */
+export async function loadLogbooks(): Promise<LoadLogbooksResult> {
+  if (!isTauri()) {
+    return { success: false, initialized: false, error: 'Not running in Tauri context' };
+  }
+
+  try {
+    return await invoke<LoadLogbooksResult>('load_logbooks');
+  } catch (err) {
+    return {
+      success: false,
+      initialized: false,
+      error: err instanceof Error ? err.message : String(err),
+    };
+  }
+}
+
+/**
+ * Load the entries of a stored logbook
+ *
+ * @param id - Logbook id
+ * @returns Entries in logbook order, or null on failure
+ */
+export async function loadLogbookEntries(id: string): Promise<LogEntry[] | null> {
+  if (!isTauri()) return null;
+
+  try {
+    const result = await invoke<LogbookEntriesResult>('load_logbook_entries', { id });
+    if (!result.success) {
+      console.error('loadLogbookEntries error:', result.error);
+      return null;
+    }
+    return result.entries ?? [];
+  } catch (err) {
+    console.error('loadLogbookEntries error:', err);
+    return null;
+  }
+}
+
+/**
+ * Write a batch of logbook changes (applied in order, off the main thread)
+ *
+ * @param ops - Metadata and entry operations
+ * @returns true if all were written
+ */
+export async function writeLogbooks(ops: LogbookOp[]): Promise<boolean> {
+  if (!isTauri()) return false;
+
+  try {
+    const result = await invoke<{ success: boolean; error?: string }>('write_logbooks', { ops });
+    if (!result.success) console.error('writeLogbooks error:', result.error);
+    return result.success;
+  } catch (err) {
+    console.error('writeLogbooks error:', err);
+    return false;
+  }
+}
+
 /**
  * Search for a specific line in a file and return surrounding context
  * Used for "jump to source" when the log is outside the truncated view (2000 lines)
@@ -145,12 +445,14 @@ export async function exportFile(path: string, content: string): Promise<boolean
  * @param path - Full path to the file to search
  * @param searchLine - The exact line content to search for
  * @param contextLines - Number of lines to include before and after the match (default: 500)
+ * @param searchId - Optional id to receive search-progress events and allow cancelSearch
  * @returns SearchLineResult with context content and line number if found
  */
 export async function searchFileForLine(
   path: string,
   searchLine: string,
-  contextLines: number = 500
+  contextLines: number = 500,
+  searchId?: string
 ): Promise<SearchLineResult> {
   if (!isTauri()) {
     return { success: false, error: 'Not running in Tauri context' };
@@ -161,6 +463,7 @@ export async function searchFileForLine(
       path,
       searchLine,
       contextLines,
+      searchId,
     });
     return result;
   } catch (err) {
@@ -170,3 +473,100 @@ export async function searchFileForLine(
     };
   }
 }
+
+/**
+ * Search a whole file for text or a regex (case-insensitive), in parallel chunks.
+ * Matches stream in as search-matches events (see onSearchMatches) while the scan runs.
+ *
+ * @param path - Full path to the file to search
+ * @param query - Text or regex to search for
+ * @param isRegex - Treat query as a regex
+ * @param searchId - Id tagging the match events, also used by cancelSearch
+ * @returns SearchFileResult with the match count once the scan is done
+ */
+export async function searchFile(
+  path: string,
+  query: string,
+  isRegex: boolean,
+  searchId: string
+): Promise<SearchFileResult> {
+  if (!isTauri()) {
+    return { success: false, error: 'Not running in Tauri context' };
+  }
+
+  try {
+    return await invoke<SearchFileResult>('search_file', {
+      path,
+      query,
+      isRegex,
+      searchId,
+    });
+  } catch (err) {
+    return {
+      success: false,
+      error: err instanceof Error ? err.message : String(err),
+    };
+  }
+}
+
+/**
+ * Subscribe to match batches streamed by searchFile
+ *
+ * @param handler - Called with each batch of matching lines
+ * @returns Unlisten function
+ */
+export async function onSearchMatches(
+  handler: (event: SearchMatchesEvent) => void
+): Promise<UnlistenFn> {
+  if (!isTauri()) return () => {};
+
+  return listen<SearchMatchesEvent>('search-matches', (event) => handler(event.payload));
+}
+
+/**
+ * Set the number of threads the backend indexes and parses large files with
+ *
+ * @param threads - Thread count (0 = one per core, 1 = load serially)
+ * @returns true once the backend uses the new count for the next load
+ */
+export async function setLoadThreads(threads: number): Promise<boolean> {
+  if (!isTauri()) return false;
+
+  try {
+    return await invoke<boolean>('set_load_threads', { threads });
+  } catch (err) {
+    console.error('setLoadThreads error:', err);
+    return false;
+  }
+}
+
+/**
+ * Cancel a running search started with a searchId
+ *
+ * @param searchId - Id passed to the search
+ * @returns true if a running search was cancelled
+ */
+export async function cancelSearch(searchId: string): Promise<boolean> {
+  if (!isTauri()) return false;
+
+  try {
+    return await invoke<boolean>('cancel_search', { searchId });
+  } catch (err) {
+    console.error('cancelSearch error:', err);
+    return false;
+  }
+}
+
+/**
+ * Subscribe to progress of long-running searches
+ *
+ * @param handler - Called with the search id and bytes scanned so far
+ * @returns Unlisten function
+ */
+export async function onSearchProgress(
+  handler: (event: SearchProgressEvent) => void
+): Promise<UnlistenFn> {
+  if (!isTauri()) return () => {};
+
+  return listen<SearchProgressEvent>('search-progress', (event) => handler(event.payload));
+}
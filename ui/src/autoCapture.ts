@@ -0,0 +1,213 @@
+/**
+ * Mocha Log Viewer - Logbook Auto-Capture Matcher
+ *
+ * The auto-capture patterns of every logbook compiled into one matcher, so
+ * each new line is checked once against all logbooks instead of once per
+ * pattern per logbook.
+ *
+ * Text patterns go into an Aho-Corasick automaton, matched over the same
+ * lowercased search text as text filters (see filters.ts). Regex patterns
+ * are joined into one alternation that gates the per-logbook regexes: a
+ * line none of them match costs one regex test. Regexes that can't be
+ * joined (backreferences, clashing group names) are tested on their own.
+ */
+
+import type { LogEntry, ParsedFilter, Story } from "./types";
+import { buildSearchText } from "./filters";
+
+/**
+ * Aho-Corasick automaton over UTF-16 code units. Each pattern carries the
+ * logbook it belongs to; outputs are the logbooks of all patterns ending at
+ * a state (including through fail links).
+ */
+class LiteralAutomaton {
+  private next: Map<number, number>[] = [new Map()];
+  private fail: number[] = [0];
+  private out: number[][] = [[]];
+
+  add(pattern: string, owner: number): void {
+    let state = 0;
+    for (let i = 0; i < pattern.length; i++) {
+      const code = pattern.charCodeAt(i);
+      let to = this.next[state].get(code);
+      if (to === undefined) {
+        to = this.next.length;
+        this.next.push(new Map());
+        this.fail.push(0);
+        this.out.push([]);
+        this.next[state].set(code, to);
+      }
+      state = to;
+    }
+    if (!this.out[state].includes(owner)) this.out[state].push(owner);
+  }
+
+  /**
+   * Compute fail links (call once, after all patterns are added)
+   */
+  build(): void {
+    const queue: number[] = [];
+    this.next[0].forEach((to) => queue.push(to));
+    for (let head = 0; head < queue.length; head++) {
+      const state = queue[head];
+      this.next[state].forEach((to, code) => {
+        let f = this.fail[state];
+        while (f !== 0 && !this.next[f].has(code)) f = this.fail[f];
+        const target = this.next[f].get(code);
+        this.fail[to] = target !== undefined && target !== to ? target : 0;
+        for (const owner of this.out[this.fail[to]]) {
+          if (!this.out[to].includes(owner)) this.out[to].push(owner);
+        }
+        queue.push(to);
+      });
+    }
+  }
+
+  /**
+   * Call found for the owner of every pattern occurring in text
+   */
+  scan(text: string, found: (owner: number) => void): void {
+    let state = 0;
+    for (let i = 0; i < text.length; i++) {
+      const code = text.charCodeAt(i);
+      let to = this.next[state].get(code);
+      while (to === undefined && state !== 0) {
+        state = this.fail[state];
+        to = this.next[state].get(code);
+      }
+      state = to ?? 0;
+      const owners = this.out[state];
+      for (let o = 0; o < owners.length; o++) found(owners[o]);
+    }
+  }
+}
+
+// Backreferences change meaning once a regex is part of a larger one
+const BACKREFERENCE = /\\(?:[1-9]|k<)/;
+
+/**
+ * Matcher for the auto-capture patterns of a list of logbooks
+ */
+export class CaptureMatcher {
+  private literals = new LiteralAutomaton();
+  private hasLiterals = false;
+  private always: number[] = []; // Logbooks with an empty text pattern
+  private gate: RegExp | null = null;
+  private gated: { owner: number; regex: RegExp }[] = [];
+  private ungated: { owner: number; regex: RegExp }[] = [];
+  // Per-log dedup: stamp[owner] === run means already reported
+  private stamp: Uint32Array;
+  private run = 0;
+  private matched: number[] = [];
+
+  /**
+   * @param patternLists - Each logbook's patterns (exclude patterns are ignored)
+   */
+  constructor(patternLists: ParsedFilter[][]) {
+    this.stamp = new Uint32Array(patternLists.length);
+    patternLists.forEach((patterns, owner) => {
+      for (const pattern of patterns) {
+        if (pattern.type === "text") {
+          const value = pattern.value.toLowerCase();
+          if (value === "") {
+            if (!this.always.includes(owner)) this.always.push(owner);
+          } else {
+            this.literals.add(value, owner);
+            this.hasLiterals = true;
+          }
+        } else if (pattern.type === "regex") {
+          let regex: RegExp;
+          try {
+            regex = new RegExp(pattern.value, "i");
+          } catch {
+            continue; // Invalid regex never matches
+          }
+          if (BACKREFERENCE.test(pattern.value)) this.ungated.push({ owner, regex });
+          else this.gated.push({ owner, regex });
+        }
+      }
+    });
+    this.literals.build();
+
+    if (this.gated.length > 1) {
+      try {
+        this.gate = new RegExp(
+          this.gated.map(({ regex }) => `(?:${regex.source})`).join("|"),
+          "i",
+        );
+      } catch {
+        // Clashing named groups - test each on its own
+        this.ungated.push(...this.gated);
+        this.gated = [];
+      }
+    }
+  }
+
+  /**
+   * Check if no logbook has an auto-capture pattern
+   */
+  get isEmpty(): boolean {
+    return (
+      !this.hasLiterals &&
+      this.always.length === 0 &&
+      this.gated.length === 0 &&
+      this.ungated.length === 0
+    );
+  }
+
+  /**
+   * Logbooks (indices into the pattern lists) the log is captured by. The
+   * returned array is reused by the next call.
+   */
+  matchingStories(log: LogEntry): readonly number[] {
+    const run = ++this.run;
+    const stamp = this.stamp;
+    const matched = this.matched;
+    matched.length = 0;
+    const found = (owner: number) => {
+      if (stamp[owner] !== run) {
+        stamp[owner] = run;
+        matched.push(owner);
+      }
+    };
+
+    for (const owner of this.always) found(owner);
+    if (this.hasLiterals) this.literals.scan(buildSearchText(log), found);
+
+    if (this.gated.length > 0 && (!this.gate || testLog(this.gate, log))) {
+      for (const { owner, regex } of this.gated) {
+        if (stamp[owner] !== run && testLog(regex, log)) found(owner);
+      }
+    }
+    for (const { owner, regex } of this.ungated) {
+      if (stamp[owner] !== run && testLog(regex, log)) found(owner);
+    }
+    return matched;
+  }
+}
+
+/**
+ * Regex patterns match the raw data or the parsed content
+ */
+function testLog(regex: RegExp, log: LogEntry): boolean {
+  return regex.test(log.data) || (log.parsed?.content ? regex.test(log.parsed.content) : false);
+}
+
+// Matcher of the last story list, rebuilt when any story's patterns change
+let cached: { patterns: ParsedFilter[][]; matcher: CaptureMatcher } | null = null;
+
+/**
+ * Matcher for the logbooks' current patterns (indices follow stories)
+ */
+export function captureMatcherFor(stories: Story[]): CaptureMatcher {
+  const patterns = stories.map((story) => story.patterns || []);
+  if (
+    cached &&
+    cached.patterns.length === patterns.length &&
+    cached.patterns.every((list, i) => list === patterns[i])
+  ) {
+    return cached.matcher;
+  }
+  cached = { patterns, matcher: new CaptureMatcher(patterns) };
+  return cached.matcher;
+}
@@ -0,0 +1,150 @@
+/**
+ * Diagnostics panel - per-stage hot-path timings and per-file ingest rates
+ * (Cmd/Ctrl+Shift+D)
+ */
+
+import { memo, useEffect, useState } from 'react'
+import { Activity, Download, RotateCcw, X } from 'lucide-react'
+import { diagnosticsSnapshot, resetDiagnostics, traceEvents } from '../diagnostics'
+import { exportTrace, isTauri } from '../api'
+import { useToastStore } from '../toastStore'
+
+const REFRESH_MS = 1000
+
+function ms(value: number): string {
+  return value >= 100 ? value.toFixed(0) : value.toFixed(2)
+}
+
+function perSec(value: number, unit: string): string {
+  if (value >= 1024 * 1024 && unit === 'B') return `${(value / (1024 * 1024)).toFixed(1)} MB/s`
+  if (value >= 1024 && unit === 'B') return `${(value / 1024).toFixed(1)} KB/s`
+  return `${value.toFixed(0)} ${unit}/s`
+}
+
+function fileName(path: string): string {
+  return path.split(/[\\/]/).pop() || path
+}
+
+async function saveTrace() {
+  const events = traceEvents()
+  const toasts = useToastStore.getState()
+  if (isTauri()) {
+    const result = await exportTrace(events)
+    if (result.success) {
+      toasts.addToast('info', `Trace (${result.events} events) written to the log in ${result.logDir ?? 'the app log directory'}`)
+    } else {
+      toasts.addToast('error', result.error || 'Could not export trace')
+    }
+    return
+  }
+  const blob = new Blob([JSON.stringify(events)], { type: 'application/json' })
+  const url = URL.createObjectURL(blob)
+  const link = document.createElement('a')
+  link.href = url
+  link.download = 'mocha-trace.json'
+  link.click()
+  URL.revokeObjectURL(url)
+}
+
+const cellStyle = { padding: '2px 8px', textAlign: 'right' as const }
+const headStyle = { ...cellStyle, color: 'var(--mocha-text-muted)', fontWeight: 500 }
+
+export const DiagnosticsPanel = memo(function DiagnosticsPanel({ onClose }: { onClose: () => void }) {
+  const [snapshot, setSnapshot] = useState(diagnosticsSnapshot)
+
+  useEffect(() => {
+    const timer = setInterval(() => setSnapshot(diagnosticsSnapshot()), REFRESH_MS)
+    return () => clearInterval(timer)
+  }, [])
+
+  const buttonClass = 'p-1.5 rounded-md transition-colors hover:bg-[var(--mocha-surface-hover)]'
+
+  return (
+    <div
+      className="fixed top-16 right-6 z-[90] rounded-xl text-xs font-mono"
+      style={{
+        background: 'var(--glass-card-bg)',
+        backdropFilter: 'blur(12px)',
+        border: '1px solid var(--mocha-border)',
+        boxShadow: '0 8px 32px rgba(0,0,0,0.3)',
+        color: 'var(--mocha-text)',
+        maxWidth: '560px',
+      }}
+    >
+      <div className="flex items-center gap-2 px-3 py-2" style={{ borderBottom: '1px solid var(--mocha-border)' }}>
+        <Activity className="w-4 h-4" style={{ color: 'var(--mocha-info)' }} />
+        <span className="flex-1 text-sm font-medium font-sans">Diagnostics</span>
+        <button
+          onClick={() => {
+            resetDiagnostics()
+            setSnapshot(diagnosticsSnapshot())
+          }}
+          className={buttonClass}
+          style={{ color: 'var(--mocha-text-muted)' }}
+          title="Reset"
+        >
+          <RotateCcw className="w-3.5 h-3.5" />
+        </button>
+        <button
+          onClick={saveTrace}
+          className={buttonClass}
+          style={{ color: 'var(--mocha-text-muted)' }}
+          title="Export trace"
+        >
+          <Download className="w-3.5 h-3.5" />
+        </button>
+        <button onClick={onClose} className={buttonClass} style={{ color: 'var(--mocha-text-muted)' }} title="Close">
+          <X className="w-3.5 h-3.5" />
+        </button>
+      </div>
+
+      <table className="m-2">
+        <thead>
+          <tr>
+            <th style={{ ...headStyle, textAlign: 'left' }}>stage (ms)</th>
+            <th style={headStyle}>count</th>
+            <th style={headStyle}>last</th>
+            <th style={headStyle}>avg</th>
+            <th style={headStyle}>p95</th>
+            <th style={headStyle}>max</th>
+          </tr>
+        </thead>
+        <tbody>
+          {snapshot.stages.map((s) => (
+            <tr key={s.stage}>
+              <td style={{ ...cellStyle, textAlign: 'left' }}>{s.stage}</td>
+              <td style={cellStyle}>{s.count}</td>
+              <td style={cellStyle}>{ms(s.last)}</td>
+              <td style={cellStyle}>{ms(s.avg)}</td>
+              <td style={cellStyle}>{ms(s.p95)}</td>
+              <td style={cellStyle}>{ms(s.max)}</td>
+            </tr>
+          ))}
+        </tbody>
+      </table>
+
+      {snapshot.files.length > 0 && (
+        <table className="m-2" style={{ borderTop: '1px solid var(--mocha-border)' }}>
+          <thead>
+            <tr>
+              <th style={{ ...headStyle, textAlign: 'left' }}>file</th>
+              <th style={headStyle}>bytes</th>
+              <th style={headStyle}>lines</th>
+              <th style={headStyle}>total lines</th>
+            </tr>
+          </thead>
+          <tbody>
+            {snapshot.files.map((f) => (
+              <tr key={f.path} title={f.path}>
+                <td style={{ ...cellStyle, textAlign: 'left' }}>{fileName(f.path)}</td>
+                <td style={cellStyle}>{perSec(f.bytesPerSec, 'B')}</td>
+                <td style={cellStyle}>{perSec(f.linesPerSec, 'lines')}</td>
+                <td style={cellStyle}>{f.lines}</td>
+              </tr>
+            ))}
+          </tbody>
+        </table>
+      )}
+    </div>
+  )
+})
@@ -3,7 +3,7 @@ import { Bookmark, Copy, Check, X } from "lucide-react";
 import { JsonView } from "react-json-view-lite";
 import "react-json-view-lite/dist/index.css";
 import type { LogEntry, LogToken, LogLevel } from "../types";
-import { tokenizeContent } from "../parser";
+import { getContentTokens } from "../parser";
 import { deepParseJsonStrings } from "../utils/jsonParser";
 import { Tooltip } from "./Tooltip";
 
@@ -393,7 +393,7 @@ function ExpandedContent({
   }
 
   // Multi-line content - show first line with JSON, then important lines
-  const firstLineTokens = tokenizeContent(firstLine).tokens;
+  const firstLineTokens = getContentTokens(firstLine).tokens;
 
   return (
     <div className="font-mono" style={{ color: "var(--mocha-text)" }}>
@@ -561,17 +561,20 @@ function LogLineComponent({
   const serviceAbbrev = getServiceAbbrev(serviceName);
   const serviceColor = getServiceColor(serviceName);
 
+  // The collapsed row only shows the first lines: long stack traces are
+  // tokenized (and their important lines picked out) once expanded
   const content = log.parsed?.content || log.data;
-  const contentLines = content.split("\n");
-  const firstLine = contentLines[0];
-  const previewLines = contentLines.slice(1, 3); // 2nd and 3rd lines
-  const additionalLineCount = contentLines.length - 3; // Lines beyond first 3
-
-  const { tokens, detectedLevel } = tokenizeContent(firstLine);
-  const fullContentTokens = useMemo(
-    () => tokenizeContent(content).tokens,
-    [content],
-  );
+  const { firstLine, previewLines, additionalLineCount } = useMemo(() => {
+    const contentLines = content.split("\n");
+    return {
+      firstLine: contentLines[0],
+      previewLines: contentLines.slice(1, 3), // 2nd and 3rd lines
+      additionalLineCount: contentLines.length - 3, // Lines beyond first 3
+    };
+  }, [content]);
+
+  // Tokens are cached per content string (shared with LogbookView)
+  const { tokens, detectedLevel } = getContentTokens(firstLine);
 
   const effectiveLevel = log.parsed?.level || detectedLevel;
   const rowStyle = getRowStyle(effectiveLevel);
@@ -786,7 +789,7 @@ function LogLineComponent({
             {/* Expanded content */}
             <ExpandedContent
               content={content}
-              tokens={fullContentTokens}
+              tokens={getContentTokens(content).tokens}
               onShowRaw={() => setShowRaw(true)}
               showRaw={showRaw}
             />
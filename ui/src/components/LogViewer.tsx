@@ -1,12 +1,32 @@
-import { useCallback, useMemo, useRef, useEffect, useState } from "react";
+import { useCallback, useMemo, useRef, useEffect, useLayoutEffect, useState } from "react";
 import { Virtuoso, type VirtuosoHandle } from "react-virtuoso";
 import { Search, FilterX, ChevronUp } from "lucide-react";
+import { useShallow } from "zustand/react/shallow";
 import type { LogEntry } from "../types";
-import { useLogViewerStore, useStoryStore, filterLogs } from "../store";
+import {
+  useLogViewerStore,
+  useStoryStore,
+  filterLogs,
+  compileFilters,
+  matchesFilterPlan,
+  storyHashes,
+  type FilterPlan,
+} from "../store";
+import {
+  LogColumns,
+  LevelIndex,
+  keyPool,
+  levelCode,
+  type RowKeys,
+  type ServiceLevelCounts,
+} from "../logColumns";
 import { LogLine, getServiceName } from "./LogLine";
+import { measure, recordSpan } from "../diagnostics";
 
 export interface LogViewerProps {
   logs: LogEntry[];
+  // Logs are already filtered (browser mode log worker) - only sort and group
+  prefiltered?: boolean;
   onToggleStory?: (log: LogEntry) => void;
   // Search props
   searchQuery?: string;
@@ -21,12 +41,15 @@ export interface LogViewerProps {
     warningCount: number;
     currentErrorIndex: number;
     currentWarningIndex: number;
+    byService: ServiceLevelCounts[]; // Per-service counts, most errors first
   }) => void;
   // Navigation commands from parent (increment to trigger)
   jumpToNextError?: number;
   jumpToPrevError?: number;
   jumpToNextWarning?: number;
   jumpToPrevWarning?: number;
+  // Called when scrolled to the oldest loaded log (load the previous page)
+  onLoadOlder?: () => void;
 }
 
 /**
@@ -38,11 +61,248 @@ function getThreadId(log: LogEntry): string | null {
   return match?.[1] || null;
 }
 
+// Pipeline inputs for prefiltered logs (stable, so they never force a rebuild)
+const NO_FILTERS: FilterPlan = { include: [], exclude: [], includeText: null };
+const NO_HIDDEN_NAMES = new Set<string>();
+
+// Row keys are derived once per entry (regexes on data/logger are not cheap)
+const rowKeyCache = new WeakMap<LogEntry, RowKeys>();
+
+/**
+ * Level, service and thread ids of a log (cached)
+ */
+function rowKeys(log: LogEntry): RowKeys {
+  let keys = rowKeyCache.get(log);
+  if (!keys) {
+    const thread = getThreadId(log);
+    keys = {
+      level: levelCode(log),
+      service: keyPool.id(getServiceName(log)),
+      thread: thread ? keyPool.id(thread) : 0,
+    };
+    rowKeyCache.set(log, keys);
+  }
+  return keys;
+}
+
+// ============================================================================
+// Display pipeline: filter -> sort newest-first -> group
+// ============================================================================
+
+/**
+ * Sort order for display: timestamp descending (newest first), then
+ * sortIndex descending for stable ordering
+ */
+function compareNewestFirst(a: LogEntry, b: LogEntry): number {
+  const timestampDiff = (b.timestamp ?? 0) - (a.timestamp ?? 0);
+  if (timestampDiff !== 0) return timestampDiff;
+  return (b.sortIndex ?? 0) - (a.sortIndex ?? 0);
+}
+
+/**
+ * Group consecutive related logs, keeping chronological order within groups.
+ * Groups only depend on neighbouring pairs, so regrouping the front of the
+ * list never changes groups after the first one.
+ * Returns the grouped logs and the length of the first (newest) group.
+ */
+function groupLogs(
+  sorted: LogEntry[],
+  isSameGroup: (a: LogEntry | null, b: LogEntry) => boolean,
+): { grouped: LogEntry[]; firstGroupLength: number } {
+  const grouped: LogEntry[] = [];
+  let firstGroupLength = 0;
+  let currentGroup: LogEntry[] = [];
+
+  for (const log of sorted) {
+    if (currentGroup.length === 0) {
+      currentGroup.push(log);
+    } else if (isSameGroup(currentGroup[currentGroup.length - 1], log)) {
+      currentGroup.push(log);
+    } else {
+      // Flush current group (reverse for chronological order within group)
+      if (grouped.length === 0) firstGroupLength = currentGroup.length;
+      grouped.push(...currentGroup.reverse());
+      currentGroup = [log];
+    }
+  }
+  // Flush last group
+  if (currentGroup.length > 0) {
+    if (grouped.length === 0) firstGroupLength = currentGroup.length;
+    grouped.push(...currentGroup.reverse());
+  }
+
+  return { grouped, firstGroupLength };
+}
+
+/**
+ * Merge two newest-first lists
+ */
+function mergeNewestFirst(a: LogEntry[], b: LogEntry[]): LogEntry[] {
+  const merged: LogEntry[] = new Array(a.length + b.length);
+  let i = 0;
+  let j = 0;
+  let k = 0;
+  while (i < a.length && j < b.length) {
+    merged[k++] = compareNewestFirst(a[i], b[j]) <= 0 ? a[i++] : b[j++];
+  }
+  while (i < a.length) merged[k++] = a[i++];
+  while (j < b.length) merged[k++] = b[j++];
+  return merged;
+}
+
+/**
+ * Pipeline state kept between renders so appended logs can be applied
+ * without re-filtering and re-sorting everything
+ */
+interface DisplayPipeline {
+  logs: LogEntry[]; // Input the state was built from
+  seen: Set<LogEntry>; // Entries of `logs`
+  plan: FilterPlan;
+  inactiveNames: Set<string>;
+  sorted: LogEntry[]; // Filtered, newest-first
+  grouped: LogEntry[]; // Display order
+  firstGroupLength: number;
+  levels: LevelIndex; // Errors/warnings of `grouped`
+}
+
+// Level index of each display list the pipeline produced (displayed lists
+// may lag behind the latest one while new logs are buffered)
+const levelIndexes = new WeakMap<LogEntry[], LevelIndex>();
+
+function levelIndexOf(grouped: LogEntry[]): LevelIndex {
+  let levels = levelIndexes.get(grouped);
+  if (!levels) {
+    levels = LevelIndex.from(grouped, rowKeys);
+    levelIndexes.set(grouped, levels);
+  }
+  return levels;
+}
+
+function withLevels(grouped: LogEntry[], levels: LevelIndex): LevelIndex {
+  levelIndexes.set(grouped, levels);
+  return levels;
+}
+
+function buildPipeline(
+  logs: LogEntry[],
+  plan: FilterPlan,
+  inactiveNames: Set<string>,
+  isSameGroup: (a: LogEntry | null, b: LogEntry) => boolean,
+): DisplayPipeline {
+  const filtered = measure("filter", () => filterLogs(logs, plan, inactiveNames), {
+    count: logs.length,
+  });
+  const { sorted, grouped, firstGroupLength } = measure(
+    "sort",
+    () => {
+      // Sort over typed-array columns instead of comparing entry objects
+      const order = LogColumns.from(filtered, rowKeys).newestFirstOrder();
+      const sorted: LogEntry[] = new Array(order.length);
+      for (let i = 0; i < order.length; i++) sorted[i] = filtered[order[i]];
+      return { sorted, ...groupLogs(sorted, isSameGroup) };
+    },
+    { count: filtered.length },
+  );
+  return {
+    logs,
+    seen: new Set(logs),
+    plan,
+    inactiveNames,
+    sorted,
+    grouped,
+    firstGroupLength,
+    levels: levelIndexOf(grouped),
+  };
+}
+
+/**
+ * Apply new input logs to the pipeline. Falls back to a full rebuild when
+ * filters, hidden services or the set of logs changed (anything removed).
+ */
+function updatePipeline(
+  prev: DisplayPipeline | null,
+  logs: LogEntry[],
+  plan: FilterPlan,
+  inactiveNames: Set<string>,
+  isSameGroup: (a: LogEntry | null, b: LogEntry) => boolean,
+): DisplayPipeline {
+  if (!prev || prev.plan !== plan || prev.inactiveNames !== inactiveNames) {
+    return buildPipeline(logs, plan, inactiveNames, isSameGroup);
+  }
+  if (prev.logs === logs) return prev;
+
+  // Only additions can be applied incrementally
+  const added: LogEntry[] = [];
+  for (const log of logs) {
+    if (!prev.seen.has(log)) added.push(log);
+  }
+  if (logs.length !== prev.logs.length + added.length) {
+    return buildPipeline(logs, plan, inactiveNames, isSameGroup);
+  }
+
+  // The previous state is replaced, so its set can be extended in place
+  const seen = prev.seen;
+  for (const log of added) seen.add(log);
+
+  const hidden = inactiveNames instanceof Set ? inactiveNames : new Set<string>();
+  const visible = measure("filter", () => added.filter((log) => matchesFilterPlan(log, plan, hidden)), {
+    count: added.length,
+  });
+  if (visible.length === 0) {
+    return { ...prev, logs, seen };
+  }
+  return measure("sort", () => mergeVisible(prev, logs, seen, visible.sort(compareNewestFirst), isSameGroup), {
+    count: visible.length,
+  });
+}
+
+/**
+ * Add newly visible logs (sorted newest-first) to the pipeline's display order
+ */
+function mergeVisible(
+  prev: DisplayPipeline,
+  logs: LogEntry[],
+  seen: Set<LogEntry>,
+  visible: LogEntry[],
+  isSameGroup: (a: LogEntry | null, b: LogEntry) => boolean,
+): DisplayPipeline {
+  const { plan, inactiveNames } = prev;
+  const atEdge =
+    prev.sorted.length === 0 ||
+    compareNewestFirst(visible[visible.length - 1], prev.sorted[0]) <= 0;
+
+  if (!atEdge) {
+    // Interleaved with existing logs (e.g. an older page) - merge and regroup
+    const sorted = mergeNewestFirst(prev.sorted, visible);
+    const { grouped, firstGroupLength } = groupLogs(sorted, isSameGroup);
+    const levels = levelIndexOf(grouped);
+    return { logs, seen, plan, inactiveNames, sorted, grouped, firstGroupLength, levels };
+  }
+
+  // All newer than what is shown: regroup only the new logs plus the old first
+  // group (they may join it); every later group stays as it is
+  const sorted = visible.concat(prev.sorted);
+  const head = visible.concat(prev.sorted.slice(0, prev.firstGroupLength));
+  const { grouped: headGrouped, firstGroupLength } = groupLogs(head, isSameGroup);
+  const grouped = headGrouped.concat(prev.grouped.slice(prev.firstGroupLength));
+  // Only the rows that changed at the top are re-indexed
+  const levels = withLevels(
+    grouped,
+    prev.levels.replaceTop(
+      prev.grouped.slice(0, prev.firstGroupLength),
+      headGrouped,
+      rowKeys,
+    ),
+  );
+  return { logs, seen, plan, inactiveNames, sorted, grouped, firstGroupLength, levels };
+}
+
 /**
  * LogViewer component - Virtualized log display with filtering and story integration.
  */
 export function LogViewer({
   logs,
+  prefiltered,
   onToggleStory,
   searchQuery,
   searchIsRegex,
@@ -54,6 +314,7 @@ export function LogViewer({
   jumpToPrevError,
   jumpToNextWarning,
   jumpToPrevWarning,
+  onLoadOlder,
 }: LogViewerProps) {
   const virtuosoRef = useRef<VirtuosoHandle>(null);
 
@@ -67,17 +328,29 @@ export function LogViewer({
   const [currentWarningIndex, setCurrentWarningIndex] = useState(-1);
 
   // Log viewer store (filters and service visibility)
-  const { inactiveNames, filters } = useLogViewerStore();
+  const { inactiveNames, filters } = useLogViewerStore(
+    useShallow((state) => ({
+      inactiveNames: state.inactiveNames,
+      filters: state.filters,
+    })),
+  );
+  const filterPlan = useMemo(() => compileFilters(filters), [filters]);
 
   // Story store
-  const { stories, activeStoryId, toggleStory } = useStoryStore();
+  const { stories, activeStoryId, toggleStory } = useStoryStore(
+    useShallow((state) => ({
+      stories: state.stories,
+      activeStoryId: state.activeStoryId,
+      toggleStory: state.toggleStory,
+    })),
+  );
 
   // Get active story hashes and convert to Set for fast lookup
   const storyHashSet = useMemo(() => {
     const activeStory = stories.find((s) => s.id === activeStoryId);
-    const hashes =
-      activeStory?.entries.map((e) => e.hash).filter((h): h is string => !!h) ||
-      [];
+    const hashes = activeStory
+      ? Array.from(storyHashes(activeStory)).filter((h): h is string => !!h)
+      : [];
     return new Set(hashes);
   }, [stories, activeStoryId]);
 
@@ -94,51 +367,48 @@ export function LogViewer({
       if (!a.timestamp || !b.timestamp) return false;
 
       const within300ms = Math.abs(a.timestamp - b.timestamp) <= 300;
-      const sameService = getServiceName(a) === getServiceName(b);
+      const aKeys = rowKeys(a);
+      const bKeys = rowKeys(b);
+      const sameService = aKeys.service === bKeys.service;
 
       // Also check thread/source if available
-      const aThread = getThreadId(a);
-      const bThread = getThreadId(b);
-      const sameThread = !aThread || !bThread || aThread === bThread;
+      const sameThread =
+        !aKeys.thread || !bKeys.thread || aKeys.thread === bKeys.thread;
 
       return within300ms && sameService && sameThread;
     },
     [],
   );
 
-  // Filter and sort logs by timestamp (newest-first), then group related entries
+  // Filter and sort logs by timestamp (newest-first), then group related entries.
+  // Appended logs are merged into the previous result; filter, service or
+  // file changes rebuild it.
+  const pipelineRef = useRef<DisplayPipeline | null>(null);
   const filteredLogs = useMemo(() => {
-    const filtered = filterLogs(logs, filters, inactiveNames);
-
-    // Sort by timestamp descending (newest first), then by sortIndex descending for stable ordering
-    const sorted = [...filtered].sort((a, b) => {
-      const timestampDiff = (b.timestamp ?? 0) - (a.timestamp ?? 0);
-      if (timestampDiff !== 0) return timestampDiff;
-      return (b.sortIndex ?? 0) - (a.sortIndex ?? 0);
-    });
-
-    // Group consecutive logs, keeping chronological order within groups
-    const result: LogEntry[] = [];
-    let currentGroup: LogEntry[] = [];
-
-    for (const log of sorted) {
-      if (currentGroup.length === 0) {
-        currentGroup.push(log);
-      } else if (isSameGroup(currentGroup[currentGroup.length - 1], log)) {
-        currentGroup.push(log);
-      } else {
-        // Flush current group (reverse for chronological order within group)
-        result.push(...currentGroup.reverse());
-        currentGroup = [log];
-      }
-    }
-    // Flush last group
-    if (currentGroup.length > 0) {
-      result.push(...currentGroup.reverse());
-    }
+    const pipeline = updatePipeline(
+      pipelineRef.current,
+      logs,
+      prefiltered ? NO_FILTERS : filterPlan,
+      prefiltered ? NO_HIDDEN_NAMES : inactiveNames,
+      isSameGroup,
+    );
+    pipelineRef.current = pipeline;
+    return pipeline.grouped;
+  }, [logs, prefiltered, filterPlan, inactiveNames, isSameGroup]);
+
+  // Show a new display list; the time until it is committed is the "render" span
+  const renderStartRef = useRef<number | null>(null);
+  const showLogs = useCallback((next: LogEntry[]) => {
+    renderStartRef.current = performance.now();
+    setDisplayedLogs(next);
+  }, []);
 
-    return result;
-  }, [logs, filters, inactiveNames, isSameGroup]);
+  useLayoutEffect(() => {
+    const start = renderStartRef.current;
+    if (start === null) return;
+    renderStartRef.current = null;
+    recordSpan("render", start, performance.now() - start, { count: displayedLogs.length });
+  }, [displayedLogs]);
 
   // Track if user is scrolled away from top
   const handleScroll = useCallback(() => {
@@ -151,20 +421,28 @@ export function LogViewer({
       isScrolledRef.current = !atTop;
       // If scrolled to top, show any buffered logs
       if (atTop && newLogsCount > 0) {
-        setDisplayedLogs(filteredLogs);
+        showLogs(filteredLogs);
         setNewLogsCount(0);
       }
     },
-    [filteredLogs, newLogsCount],
+    [filteredLogs, newLogsCount, showLogs],
   );
 
   // Handle log updates - buffer if scrolled, show immediately if at top or logs decreased
   useEffect(() => {
     const logsDecreased = filteredLogs.length < displayedLogs.length;
+    // Newest log unchanged - growth came from an older page at the bottom
+    const olderLogsOnly =
+      displayedLogs.length > 0 && filteredLogs[0]?.hash === displayedLogs[0]?.hash;
 
-    if (!isScrolledRef.current || displayedLogs.length === 0 || logsDecreased) {
-      // At top, first load, or logs removed (file closed) - show all logs
-      setDisplayedLogs(filteredLogs);
+    if (
+      !isScrolledRef.current ||
+      displayedLogs.length === 0 ||
+      logsDecreased ||
+      olderLogsOnly
+    ) {
+      // At top, first load, older page, or logs removed (file closed) - show all logs
+      showLogs(filteredLogs);
       setNewLogsCount(0);
     } else {
       // Scrolled down - calculate how many new logs
@@ -177,40 +455,29 @@ export function LogViewer({
 
   // Show buffered logs when clicking the indicator
   const showNewLogs = useCallback(() => {
-    setDisplayedLogs(filteredLogs);
+    showLogs(filteredLogs);
     setNewLogsCount(0);
     // Scroll to top
     virtuosoRef.current?.scrollToIndex({ index: 0, behavior: "smooth" });
-  }, [filteredLogs]);
+  }, [filteredLogs, showLogs]);
 
-  // Calculate error/warning indices from displayedLogs (visual order)
-  const { errorIndices, warningIndices } = useMemo(() => {
-    const errors: number[] = [];
-    const warnings: number[] = [];
-
-    displayedLogs.forEach((log, index) => {
-      const level = log.parsed?.level?.toUpperCase();
-      if (level === "ERROR") {
-        errors.push(index);
-      } else if (level === "WARN" || level === "WARNING") {
-        warnings.push(index);
-      }
-    });
-
-    return { errorIndices: errors, warningIndices: warnings };
-  }, [displayedLogs]);
+  // Error/warning index of displayedLogs (visual order), maintained by the
+  // pipeline as logs are appended
+  const levels = useMemo(() => levelIndexOf(displayedLogs), [displayedLogs]);
+  const byService = useMemo(() => levels.countsByService(), [levels]);
 
   // Report stats to parent
   useEffect(() => {
     onErrorWarningStats?.({
-      errorCount: errorIndices.length,
-      warningCount: warningIndices.length,
+      errorCount: levels.errorCount,
+      warningCount: levels.warningCount,
       currentErrorIndex,
       currentWarningIndex,
+      byService,
     });
   }, [
-    errorIndices.length,
-    warningIndices.length,
+    levels,
+    byService,
     currentErrorIndex,
     currentWarningIndex,
     onErrorWarningStats,
@@ -227,14 +494,14 @@ export function LogViewer({
     if (
       jumpToNextError === undefined ||
       jumpToNextError === 0 ||
-      errorIndices.length === 0
+      levels.errorCount === 0
     )
       return;
     const nextIndex =
-      currentErrorIndex < 0 ? 0 : (currentErrorIndex + 1) % errorIndices.length;
+      currentErrorIndex < 0 ? 0 : (currentErrorIndex + 1) % levels.errorCount;
     setCurrentErrorIndex(nextIndex);
     virtuosoRef.current?.scrollToIndex({
-      index: errorIndices[nextIndex],
+      index: levels.errorAt(nextIndex),
       align: "center",
       behavior: "smooth",
     });
@@ -244,14 +511,14 @@ export function LogViewer({
     if (
       jumpToPrevError === undefined ||
       jumpToPrevError === 0 ||
-      errorIndices.length === 0
+      levels.errorCount === 0
     )
       return;
     const prevIndex =
-      currentErrorIndex <= 0 ? errorIndices.length - 1 : currentErrorIndex - 1;
+      currentErrorIndex <= 0 ? levels.errorCount - 1 : currentErrorIndex - 1;
     setCurrentErrorIndex(prevIndex);
     virtuosoRef.current?.scrollToIndex({
-      index: errorIndices[prevIndex],
+      index: levels.errorAt(prevIndex),
       align: "center",
       behavior: "smooth",
     });
@@ -262,16 +529,16 @@ export function LogViewer({
     if (
       jumpToNextWarning === undefined ||
       jumpToNextWarning === 0 ||
-      warningIndices.length === 0
+      levels.warningCount === 0
     )
       return;
     const nextIndex =
       currentWarningIndex < 0
         ? 0
-        : (currentWarningIndex + 1) % warningIndices.length;
+        : (currentWarningIndex + 1) % levels.warningCount;
     setCurrentWarningIndex(nextIndex);
     virtuosoRef.current?.scrollToIndex({
-      index: warningIndices[nextIndex],
+      index: levels.warningAt(nextIndex),
       align: "center",
       behavior: "smooth",
     });
@@ -281,16 +548,16 @@ export function LogViewer({
     if (
       jumpToPrevWarning === undefined ||
       jumpToPrevWarning === 0 ||
-      warningIndices.length === 0
+      levels.warningCount === 0
     )
       return;
     const prevIndex =
       currentWarningIndex <= 0
-        ? warningIndices.length - 1
+        ? levels.warningCount - 1
         : currentWarningIndex - 1;
     setCurrentWarningIndex(prevIndex);
     virtuosoRef.current?.scrollToIndex({
-      index: warningIndices[prevIndex],
+      index: levels.warningAt(prevIndex),
       align: "center",
       behavior: "smooth",
     });
@@ -499,6 +766,7 @@ export function LogViewer({
           computeItemKey={(index, log) => log.hash ?? `index-${index}`}
           onScroll={handleScroll}
           atTopStateChange={handleAtTopStateChange}
+          endReached={onLoadOlder}
           style={{ flex: 1 }}
         />
       )}
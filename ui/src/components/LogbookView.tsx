@@ -20,11 +20,11 @@ import { exportFile } from "../api";
 import { JsonView } from "react-json-view-lite";
 import "react-json-view-lite/dist/index.css";
 import type { LogEntry, LogToken, Story } from "../types";
-import { tokenizeContent } from "../parser";
+import { getContentTokens } from "../parser";
 import { getServiceName } from "./LogLine";
 import { deepParseJsonStrings } from "../utils/jsonParser";
 import { PatternManager } from "./PatternManager";
-import { useStoryStore } from "../store";
+import { useStoryStore, storyEntryCount } from "../store";
 
 /**
  * Format a timestamp for display in time period dividers
@@ -370,7 +370,7 @@ function SmartContent({
     );
   }
 
-  const firstLineTokens = tokenizeContent(firstLine).tokens;
+  const firstLineTokens = getContentTokens(firstLine).tokens;
 
   return (
     <div className="font-mono" style={{ color: "var(--mocha-text)" }}>
@@ -564,7 +564,7 @@ const LogbookEvidenceCard = memo(function LogbookEvidenceCard({
   };
   const levelIndicator = getLevelIndicator();
 
-  const { tokens } = tokenizeContent(content);
+  const { tokens } = getContentTokens(content);
   const rawLog = log.data;
 
   const highlightMatches = (text: string) => {
@@ -738,7 +738,7 @@ const LogbookEvidenceCard = memo(function LogbookEvidenceCard({
                             className="text-[10px] tabular-nums"
                             style={{ color: "var(--mocha-text-muted)" }}
                           >
-                            {targetStory.entries.length}
+                            {storyEntryCount(targetStory)}
                           </span>
                         </button>
                       ))}
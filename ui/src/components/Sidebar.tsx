@@ -1,6 +1,8 @@
 import { memo, useCallback, useMemo, useState, useEffect, useRef } from "react";
 import {
   FolderOpen,
+  FolderPlus,
+  Folder,
   FileText,
   Clock,
   Trash2,
@@ -24,6 +26,7 @@ import type {
   ThemeName,
   ParsedFilter,
 } from "../types";
+import { storyEntryCount } from "../store";
 import { PatternManager } from "./PatternManager";
 
 /**
@@ -291,12 +294,13 @@ const LogbookItem = memo(function LogbookItem({
   const [isEditing, setIsEditing] = useState(false);
   const [editName, setEditName] = useState(story.name);
   const [badgePulsing, setBadgePulsing] = useState(false);
-  const prevEntryCountRef = useRef(story.entries.length);
+  const entryCount = storyEntryCount(story);
+  const prevEntryCountRef = useRef(entryCount);
 
   // Detect when entries are added and trigger pulse animation
   useEffect(() => {
     const prevCount = prevEntryCountRef.current;
-    const newCount = story.entries.length;
+    const newCount = entryCount;
 
     if (newCount > prevCount) {
       // Entry was added - trigger pulse
@@ -306,7 +310,7 @@ const LogbookItem = memo(function LogbookItem({
     }
 
     prevEntryCountRef.current = newCount;
-  }, [story.entries.length]);
+  }, [entryCount]);
 
   const handleDoubleClick = useCallback(
     (e: React.MouseEvent) => {
@@ -360,7 +364,7 @@ const LogbookItem = memo(function LogbookItem({
               : "1px solid var(--mocha-border)",
             opacity: isInactiveCollapsed ? 0.85 : 1,
           }}
-          title={`${story.name} (${story.entries.length} entries)${!hasPatterns ? " • No patterns" : ""}`}
+          title={`${story.name} (${entryCount} entries)${!hasPatterns ? " • No patterns" : ""}`}
         >
           <BookOpen
             className="w-4 h-4"
@@ -372,7 +376,7 @@ const LogbookItem = memo(function LogbookItem({
                   : "var(--mocha-text-muted)",
             }}
           />
-          {story.entries.length > 0 && (
+          {entryCount > 0 && (
             <span
               className={`absolute -top-1 -right-1 min-w-[16px] h-4 rounded-full text-[9px] font-bold flex items-center justify-center px-1 ${badgePulsing ? "animate-badge-pulse" : ""}`}
               style={{
@@ -382,7 +386,7 @@ const LogbookItem = memo(function LogbookItem({
                 color: "var(--mocha-bg)",
               }}
             >
-              {story.entries.length}
+              {entryCount}
             </span>
           )}
         </button>
@@ -486,8 +490,8 @@ const LogbookItem = memo(function LogbookItem({
             style={{ color: "var(--mocha-text-faint)" }}
           >
             <span>
-              {story.entries.length}{" "}
-              {story.entries.length === 1 ? "entry" : "entries"}
+              {entryCount}{" "}
+              {entryCount === 1 ? "entry" : "entries"}
             </span>
             {/* No-patterns marker */}
             {!hasPatterns && (
@@ -502,7 +506,7 @@ const LogbookItem = memo(function LogbookItem({
         </div>
 
         {/* Entry count badge */}
-        {story.entries.length > 0 && (
+        {entryCount > 0 && (
           <span
             className={`px-2 py-0.5 rounded-full text-[10px] font-bold shrink-0 ${badgePulsing ? "animate-badge-pulse" : ""}`}
             style={{
@@ -514,7 +518,7 @@ const LogbookItem = memo(function LogbookItem({
                 : "var(--mocha-text-muted)",
             }}
           >
-            {story.entries.length}
+            {entryCount}
           </span>
         )}
 
@@ -559,6 +563,217 @@ const LogbookItem = memo(function LogbookItem({
   );
 });
 
+/**
+ * Short label for a source: the directory name, plus the pattern of a glob
+ */
+function sourceLabel(spec: string): string {
+  const parts = spec.split(/[\\/]/).filter(Boolean);
+  const last = parts.pop() ?? spec;
+  return /[*?]/.test(last) && parts.length > 0 ? `${parts.pop()}/${last}` : last;
+}
+
+/**
+ * Directory/glob source item component
+ */
+const SourceItem = memo(function SourceItem({
+  spec,
+  fileCount,
+  onClose,
+}: {
+  spec: string;
+  fileCount: number;
+  onClose: () => void;
+}) {
+  const [isHovered, setIsHovered] = useState(false);
+
+  return (
+    <div
+      className="group relative animate-slide-in"
+      onMouseEnter={() => setIsHovered(true)}
+      onMouseLeave={() => setIsHovered(false)}
+    >
+      <div
+        className="w-full px-3 py-2.5 rounded-lg flex items-center gap-3"
+        style={{
+          background: "var(--mocha-selection)",
+          border: "1px solid var(--mocha-selection-border)",
+        }}
+        title={spec}
+        data-testid={`source-${spec}`}
+      >
+        <div
+          className="w-8 h-8 rounded-lg flex items-center justify-center shrink-0"
+          style={{
+            background: "var(--mocha-info)",
+            boxShadow: "0 0 12px var(--mocha-selection-glow)",
+          }}
+        >
+          <Folder className="w-4 h-4" style={{ color: "var(--mocha-bg)" }} />
+        </div>
+        <div className="min-w-0 flex-1">
+          <div
+            className="font-medium text-sm truncate"
+            style={{ color: "var(--mocha-info)" }}
+          >
+            {sourceLabel(spec)}
+          </div>
+          <div className="text-xs mt-0.5" style={{ color: "var(--mocha-text-muted)" }}>
+            {fileCount === 1 ? "1 file" : `${fileCount.toLocaleString()} files`}
+          </div>
+        </div>
+      </div>
+
+      {/* Close button */}
+      <button
+        onClick={onClose}
+        className={`
+          absolute right-2 top-1/2 -translate-y-1/2 p-1.5 rounded-md
+          transition-all duration-200
+          ${isHovered ? "opacity-100 scale-100" : "opacity-0 scale-90"}
+        `}
+        style={{
+          background: "var(--mocha-surface-active)",
+          color: "var(--mocha-text-muted)",
+        }}
+        onMouseEnter={(e) => {
+          e.currentTarget.style.background = "var(--mocha-error-bg)";
+          e.currentTarget.style.color = "var(--mocha-error)";
+        }}
+        onMouseLeave={(e) => {
+          e.currentTarget.style.background = "var(--mocha-surface-active)";
+          e.currentTarget.style.color = "var(--mocha-text-muted)";
+        }}
+        title="Close folder and its files"
+      >
+        <X className="w-3.5 h-3.5" />
+      </button>
+    </div>
+  );
+});
+
+/**
+ * Dialog for opening a directory or glob source
+ */
+function OpenSourceDialog({
+  onClose,
+  onOpen,
+}: {
+  onClose: () => void;
+  onOpen: (spec?: string) => void;
+}) {
+  const [spec, setSpec] = useState("");
+
+  const handleOpen = useCallback(() => {
+    if (!spec.trim()) return;
+    onOpen(spec.trim());
+    onClose();
+  }, [spec, onOpen, onClose]);
+
+  return (
+    <div
+      className="fixed inset-0 z-50 flex items-center justify-center animate-fade-in"
+      style={{ background: "rgba(0, 0, 0, 0.6)", backdropFilter: "blur(4px)" }}
+      onClick={(e) => {
+        if (e.target === e.currentTarget) onClose();
+      }}
+    >
+      <div
+        className="w-[380px] rounded-2xl p-5 animate-scale-in"
+        style={{
+          background: "var(--mocha-surface)",
+          border: "1px solid var(--mocha-border)",
+          boxShadow: "0 24px 64px rgba(0,0,0,0.5)",
+        }}
+      >
+        <h2
+          className="text-sm font-semibold mb-4 font-display"
+          style={{ color: "var(--mocha-text)" }}
+        >
+          Open Folder
+        </h2>
+
+        <div className="mb-5">
+          <label
+            className="block text-[10px] font-semibold uppercase tracking-widest mb-1.5"
+            style={{ color: "var(--mocha-text-muted)" }}
+          >
+            Directory or glob
+          </label>
+          <input
+            type="text"
+            value={spec}
+            onChange={(e) => setSpec(e.target.value)}
+            onKeyDown={(e) => {
+              if (e.key === "Enter") {
+                e.preventDefault();
+                handleOpen();
+              }
+              if (e.key === "Escape") onClose();
+            }}
+            placeholder="e.g. /var/log/myapp/*.log"
+            className="w-full px-3 py-2 rounded-lg text-sm font-mono outline-none transition-all duration-200"
+            style={{
+              background: "var(--mocha-surface-raised)",
+              border: "1px solid var(--mocha-border)",
+              color: "var(--mocha-text)",
+            }}
+            onFocus={(e) => {
+              e.currentTarget.style.borderColor = "var(--mocha-accent)";
+            }}
+            onBlur={(e) => {
+              e.currentTarget.style.borderColor = "var(--mocha-border)";
+            }}
+            autoFocus
+          />
+          <p
+            className="text-[10px] mt-1.5"
+            style={{ color: "var(--mocha-text-muted)", opacity: 0.6 }}
+          >
+            A directory opens its .log and .txt files. New matching files are opened as they appear.
+          </p>
+        </div>
+
+        {/* Actions */}
+        <div className="flex justify-end gap-2">
+          <button
+            onClick={() => {
+              onOpen();
+              onClose();
+            }}
+            className="mr-auto px-4 py-2 rounded-lg text-xs font-medium transition-all"
+            style={{
+              color: "var(--mocha-text-muted)",
+              background: "var(--mocha-surface-hover)",
+            }}
+          >
+            Browse…
+          </button>
+          <button
+            onClick={onClose}
+            className="px-4 py-2 rounded-lg text-xs font-medium transition-all"
+            style={{
+              color: "var(--mocha-text-muted)",
+              background: "var(--mocha-surface-hover)",
+            }}
+          >
+            Cancel
+          </button>
+          <button
+            onClick={handleOpen}
+            className="px-4 py-2 rounded-lg text-xs font-semibold transition-all hover:scale-[1.02] active:scale-[0.98]"
+            style={{
+              background: "var(--mocha-accent)",
+              color: "var(--mocha-bg)",
+            }}
+          >
+            Open
+          </button>
+        </div>
+      </div>
+    </div>
+  );
+}
+
 /**
  * Dialog for creating a new logbook with name and optional patterns
  */
@@ -700,6 +915,10 @@ export const Sidebar = memo(function Sidebar({
   onCloseFile,
   onRemoveFile,
   onClearRecent,
+  // Directory/glob sources
+  sources,
+  onOpenSource,
+  onCloseSource,
   // Logbook management
   stories,
   activeStoryId,
@@ -726,6 +945,18 @@ export const Sidebar = memo(function Sidebar({
   // Create logbook dialog
   const [showCreateDialog, setShowCreateDialog] = useState(false);
 
+  // Open folder dialog
+  const [showSourceDialog, setShowSourceDialog] = useState(false);
+
+  // Open files per source
+  const sourceFileCounts = useMemo(() => {
+    const counts = new Map<string, number>();
+    openedFiles.forEach((file) => {
+      if (file.source) counts.set(file.source, (counts.get(file.source) ?? 0) + 1);
+    });
+    return counts;
+  }, [openedFiles]);
+
   // Sort recent files alphabetically by name
   const sortedRecentFiles = useMemo(
     () => [...recentFiles].sort((a, b) => a.name.localeCompare(b.name)),
@@ -840,35 +1071,60 @@ export const Sidebar = memo(function Sidebar({
           </div>
         </div>
 
-        {/* Open File button */}
-        <button
-          onClick={() => onSelectFile()}
-          className={`rounded-xl font-medium text-sm flex items-center justify-center transition-all duration-200 hover:scale-[1.02] active:scale-[0.98] ${
-            isCollapsed ? "w-10 h-10 p-0" : "w-full px-4 py-3 gap-2"
-          }`}
-          style={{
-            background:
-              "linear-gradient(135deg, var(--mocha-surface-raised) 0%, var(--mocha-surface-hover) 100%)",
-            border: "1px solid var(--mocha-border)",
-            color: "var(--mocha-text)",
-            boxShadow: "0 2px 8px rgba(0,0,0,0.2)",
-            margin: isCollapsed ? "0 auto" : undefined,
-          }}
-          onMouseEnter={(e) => {
-            e.currentTarget.style.borderColor = "var(--mocha-accent)";
-            e.currentTarget.style.boxShadow =
-              "0 4px 16px rgba(0,0,0,0.3), 0 0 20px var(--mocha-accent-glow)";
-          }}
-          onMouseLeave={(e) => {
-            e.currentTarget.style.borderColor = "var(--mocha-border)";
-            e.currentTarget.style.boxShadow = "0 2px 8px rgba(0,0,0,0.2)";
-          }}
-          data-testid="open-file-button"
-          title={isCollapsed ? "Open Log File" : undefined}
-        >
-          <FolderOpen className="w-4 h-4 shrink-0" />
-          {!isCollapsed && <span>Open Log File</span>}
-        </button>
+        {/* Open File and Open Folder buttons */}
+        <div className={isCollapsed ? "" : "flex gap-2"}>
+          <button
+            onClick={() => onSelectFile()}
+            className={`rounded-xl font-medium text-sm flex items-center justify-center transition-all duration-200 hover:scale-[1.02] active:scale-[0.98] ${
+              isCollapsed ? "w-10 h-10 p-0" : "flex-1 px-4 py-3 gap-2"
+            }`}
+            style={{
+              background:
+                "linear-gradient(135deg, var(--mocha-surface-raised) 0%, var(--mocha-surface-hover) 100%)",
+              border: "1px solid var(--mocha-border)",
+              color: "var(--mocha-text)",
+              boxShadow: "0 2px 8px rgba(0,0,0,0.2)",
+              margin: isCollapsed ? "0 auto" : undefined,
+            }}
+            onMouseEnter={(e) => {
+              e.currentTarget.style.borderColor = "var(--mocha-accent)";
+              e.currentTarget.style.boxShadow =
+                "0 4px 16px rgba(0,0,0,0.3), 0 0 20px var(--mocha-accent-glow)";
+            }}
+            onMouseLeave={(e) => {
+              e.currentTarget.style.borderColor = "var(--mocha-border)";
+              e.currentTarget.style.boxShadow = "0 2px 8px rgba(0,0,0,0.2)";
+            }}
+            data-testid="open-file-button"
+            title={isCollapsed ? "Open Log File" : undefined}
+          >
+            <FolderOpen className="w-4 h-4 shrink-0" />
+            {!isCollapsed && <span>Open Log File</span>}
+          </button>
+          {!isCollapsed && (
+            <button
+              onClick={() => setShowSourceDialog(true)}
+              className="rounded-xl flex items-center justify-center px-3 transition-all duration-200 hover:scale-[1.02] active:scale-[0.98]"
+              style={{
+                background:
+                  "linear-gradient(135deg, var(--mocha-surface-raised) 0%, var(--mocha-surface-hover) 100%)",
+                border: "1px solid var(--mocha-border)",
+                color: "var(--mocha-text)",
+                boxShadow: "0 2px 8px rgba(0,0,0,0.2)",
+              }}
+              onMouseEnter={(e) => {
+                e.currentTarget.style.borderColor = "var(--mocha-accent)";
+              }}
+              onMouseLeave={(e) => {
+                e.currentTarget.style.borderColor = "var(--mocha-border)";
+              }}
+              data-testid="open-source-button"
+              title="Open folder or glob"
+            >
+              <FolderPlus className="w-4 h-4" />
+            </button>
+          )}
+        </div>
       </div>
 
       {/* Scrollable content area with both sections */}
@@ -974,6 +1230,30 @@ export const Sidebar = memo(function Sidebar({
           )}
         </div>
 
+        {/* Sources section - open directories and globs */}
+        {!isCollapsed && sources.length > 0 && (
+          <div className="shrink-0">
+            <div className="px-5 py-3">
+              <span
+                className="text-[11px] font-semibold uppercase tracking-widest"
+                style={{ color: "var(--mocha-text-muted)" }}
+              >
+                Folders
+              </span>
+            </div>
+            <div className="px-3 pb-3 space-y-1">
+              {sources.map((spec) => (
+                <SourceItem
+                  key={spec}
+                  spec={spec}
+                  fileCount={sourceFileCounts.get(spec) ?? 0}
+                  onClose={() => onCloseSource(spec)}
+                />
+              ))}
+            </div>
+          </div>
+        )}
+
         {/* Divider */}
         {!isCollapsed &&
           (sortedStories.length > 0 || sortedRecentFiles.length > 0) && (
@@ -1209,6 +1489,13 @@ export const Sidebar = memo(function Sidebar({
           }}
         />
       )}
+
+      {showSourceDialog && (
+        <OpenSourceDialog
+          onClose={() => setShowSourceDialog(false)}
+          onOpen={onOpenSource}
+        />
+      )}
     </aside>
   );
 });
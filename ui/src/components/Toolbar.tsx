@@ -1,6 +1,7 @@
 import { memo, useState, useRef, useEffect } from 'react'
-import { X, FileText, Files, AlertTriangle, Search, Hash, MinusCircle, ChevronUp, ChevronDown, Command, CircleAlert, TriangleAlert } from 'lucide-react'
+import { X, FileText, Files, AlertTriangle, Search, Hash, MinusCircle, ChevronUp, ChevronDown, Command, CircleAlert, TriangleAlert, Clock } from 'lucide-react'
 import type { ToolbarProps, ParsedFilter } from '../types'
+import type { ServiceLevelCounts } from '../logColumns'
 
 /**
  * Filter chip with refined styling
@@ -72,6 +73,100 @@ const FilterChip = memo(function FilterChip({
   )
 })
 
+/**
+ * Time-range jump - a clock button that opens from/to inputs
+ * ("14:32" or "2026-01-09 14:32:00"; an empty end loads from the start on)
+ */
+const TimeRangeJump = memo(function TimeRangeJump({
+  onJump,
+}: {
+  onJump: (from: string, to: string) => void
+}) {
+  const [isOpen, setIsOpen] = useState(false)
+  const [from, setFrom] = useState('')
+  const [to, setTo] = useState('')
+  const fromRef = useRef<HTMLInputElement>(null)
+
+  useEffect(() => {
+    if (isOpen) fromRef.current?.focus()
+  }, [isOpen])
+
+  const submit = () => {
+    if (from.trim()) onJump(from.trim(), to.trim())
+  }
+
+  const handleKeyDown = (e: React.KeyboardEvent) => {
+    if (e.key === 'Enter') submit()
+    if (e.key === 'Escape') setIsOpen(false)
+  }
+
+  const inputStyle = {
+    background: 'var(--mocha-surface-hover)',
+    border: '1px solid var(--mocha-border)',
+    color: 'var(--mocha-text)',
+  }
+
+  return (
+    <div className="flex items-center gap-1.5">
+      <button
+        onClick={() => setIsOpen(!isOpen)}
+        className="p-2.5 rounded-xl transition-all duration-200 hover:bg-[var(--mocha-surface-hover)]"
+        style={{
+          background: isOpen ? 'var(--mocha-surface-raised)' : 'transparent',
+          border: `1px solid ${isOpen ? 'var(--mocha-accent)' : 'var(--mocha-border)'}`,
+          color: isOpen ? 'var(--mocha-accent)' : 'var(--mocha-text-muted)',
+        }}
+        title="Jump to a time range in the whole file(s)"
+        data-testid="time-range-toggle"
+      >
+        <Clock className="w-4 h-4" />
+      </button>
+
+      {isOpen && (
+        <div className="flex items-center gap-1.5 animate-scale-in" data-testid="time-range">
+          <input
+            ref={fromRef}
+            type="text"
+            value={from}
+            onChange={(e) => setFrom(e.target.value)}
+            onKeyDown={handleKeyDown}
+            placeholder="14:32"
+            className="w-24 px-2.5 py-2 text-xs rounded-lg font-mono"
+            style={inputStyle}
+            title="Start: HH:MM[:SS] (day of the loaded logs) or YYYY-MM-DD HH:MM[:SS]"
+            data-testid="time-range-from"
+          />
+          <span className="text-xs" style={{ color: 'var(--mocha-text-muted)' }}>–</span>
+          <input
+            type="text"
+            value={to}
+            onChange={(e) => setTo(e.target.value)}
+            onKeyDown={handleKeyDown}
+            placeholder="14:35"
+            className="w-24 px-2.5 py-2 text-xs rounded-lg font-mono"
+            style={inputStyle}
+            title="End (optional): HH:MM[:SS] or YYYY-MM-DD HH:MM[:SS]"
+            data-testid="time-range-to"
+          />
+          <button
+            onClick={submit}
+            className="px-3 py-2 rounded-lg text-xs font-medium transition-all duration-150 hover:bg-[var(--mocha-surface-hover)]"
+            style={{
+              background: 'var(--mocha-surface-raised)',
+              border: '1px solid var(--mocha-border)',
+              color: from.trim() ? 'var(--mocha-text-secondary)' : 'var(--mocha-text-muted)',
+            }}
+            disabled={!from.trim()}
+            data-testid="time-range-go"
+          >
+            Go
+          </button>
+        </div>
+      )}
+    </div>
+  )
+})
+
 /**
  * Extended Toolbar props
  */
@@ -85,11 +180,18 @@ interface ExtendedToolbarProps extends ToolbarProps {
   onSearchRegexToggle?: () => void
   onSearchNext?: () => void
   onSearchPrev?: () => void
+  // Whole-file search (matches outside the loaded logs)
+  searchFileMatchCount?: number
+  searchFileScanning?: boolean
+  onSearchInFiles?: () => void
+  // Time-range jump over the whole file(s)
+  onJumpToTime?: (from: string, to: string) => void
   // Error/warning navigation
   errorCount?: number
   warningCount?: number
   currentErrorIndex?: number
   currentWarningIndex?: number
+  levelCountsByService?: ServiceLevelCounts[]
   onJumpToNextError?: () => void
   onJumpToPrevError?: () => void
   onJumpToNextWarning?: () => void
@@ -112,10 +214,15 @@ export const Toolbar = memo(function Toolbar({
   onSearchRegexToggle,
   onSearchNext,
   onSearchPrev,
+  searchFileMatchCount = 0,
+  searchFileScanning = false,
+  onSearchInFiles,
+  onJumpToTime,
   errorCount = 0,
   warningCount = 0,
   currentErrorIndex = -1,
   currentWarningIndex = -1,
+  levelCountsByService = [],
   onJumpToNextError,
   onJumpToPrevError,
   onJumpToNextWarning,
@@ -124,6 +231,14 @@ export const Toolbar = memo(function Toolbar({
   const [isFocused, setIsFocused] = useState(false)
   const inputRef = useRef<HTMLInputElement>(null)
 
+  // Badge tooltips: where the errors/warnings come from
+  const levelBreakdown = (kind: 'errors' | 'warnings') =>
+    levelCountsByService
+      .filter((counts) => counts[kind] > 0)
+      .sort((a, b) => b[kind] - a[kind])
+      .map((counts) => `${counts.service}: ${counts[kind].toLocaleString()}`)
+      .join('\n')
+
   // Keyboard shortcut: Cmd/Ctrl+F to focus search
   useEffect(() => {
     const handleKeyDown = (e: KeyboardEvent) => {
@@ -222,6 +337,9 @@ export const Toolbar = memo(function Toolbar({
       {/* Spacer */}
       <div className="flex-1" />
 
+      {/* Time-range jump */}
+      {onJumpToTime && activeFileCount > 0 && <TimeRangeJump onJump={onJumpToTime} />}
+
       {/* Search section */}
       <div className="flex items-center gap-2">
         {/* Search input */}
@@ -349,6 +467,24 @@ export const Toolbar = memo(function Toolbar({
             </button>
           </div>
         )}
+
+        {/* Whole-file matches */}
+        {searchQuery && (searchFileScanning || searchFileMatchCount > 0) && (
+          <button
+            onClick={onSearchInFiles}
+            className="px-2.5 py-1.5 rounded-xl text-xs tabular-nums font-mono font-medium transition-all duration-150 hover:bg-[var(--mocha-surface-hover)] animate-scale-in"
+            style={{
+              background: 'var(--mocha-surface-raised)',
+              border: '1px solid var(--mocha-border)',
+              color: searchFileMatchCount > 0 ? 'var(--mocha-text-secondary)' : 'var(--mocha-text-muted)',
+            }}
+            title="Matches in the whole file(s). Click to load the next one"
+            disabled={searchFileMatchCount === 0}
+            data-testid="search-file-matches"
+          >
+            {searchFileMatchCount.toLocaleString()} in files{searchFileScanning ? '...' : ''}
+          </button>
+        )}
       </div>
 
       {/* Error/Warning Navigation */}
@@ -369,6 +505,7 @@ export const Toolbar = memo(function Toolbar({
                   borderRadius: '12px',
                   padding: '4px 8px',
                 }}
+                title={levelBreakdown('errors')}
               >
                 <CircleAlert className="w-4 h-4" style={{ color: 'var(--mocha-error)' }} />
                 <span
@@ -405,6 +542,7 @@ export const Toolbar = memo(function Toolbar({
                   borderRadius: '12px',
                   padding: '4px 8px',
                 }}
+                title={levelBreakdown('warnings')}
               >
                 <TriangleAlert className="w-4 h-4" style={{ color: 'var(--mocha-warning)' }} />
                 <span
@@ -0,0 +1,247 @@
+/**
+ * Mocha Log Viewer - Hot-Path Diagnostics
+ *
+ * Timing spans around each stage of the poll -> parse -> append -> filter
+ * -> render pipeline, and per-file ingest counters (bytes/sec, lines/sec).
+ * Always recorded - a span is a few numbers in a fixed-size ring - and shown
+ * in the diagnostics panel (Cmd/Ctrl+Shift+D). exportTrace() sends the
+ * recorded spans to the app log as Chrome trace events.
+ */
+
+export type Stage =
+  | "ipc" // Backend round trip minus backend time (or event delivery)
+  | "backend" // Reading and parsing in Rust (reported by the backend)
+  | "parse" // parseLogFile in the frontend / log worker
+  | "timestamps" // Continuing timestamps of appended logs
+  | "append" // Adding logs to the file store
+  | "filter" // filterLogs / matching appended logs
+  | "sort" // Newest-first ordering and grouping
+  | "render"; // React render + commit of the log list
+
+export const STAGES: Stage[] = [
+  "ipc",
+  "backend",
+  "parse",
+  "timestamps",
+  "append",
+  "filter",
+  "sort",
+  "render",
+];
+
+export interface Span {
+  stage: Stage;
+  start: number; // performance.now() ms
+  duration: number; // ms
+  path?: string; // File the span worked on
+  count?: number; // Entries processed
+}
+
+export interface StageStats {
+  stage: Stage;
+  count: number;
+  last: number; // ms
+  avg: number; // ms, over the recent spans
+  p95: number; // ms, over the recent spans
+  max: number; // ms, since reset
+  total: number; // ms, since reset
+}
+
+export interface FileThroughput {
+  path: string;
+  bytes: number; // Since reset
+  lines: number;
+  bytesPerSec: number; // Over the last RATE_WINDOW_MS
+  linesPerSec: number;
+}
+
+// Spans kept for export
+const MAX_SPANS = 5000;
+// Spans per stage that avg/p95 are computed over
+const RECENT_PER_STAGE = 200;
+const RATE_WINDOW_MS = 10_000;
+
+const spans: Span[] = [];
+let nextSpan = 0; // Ring write position once full
+
+interface StageTotals {
+  count: number;
+  total: number;
+  max: number;
+  last: number;
+  recent: number[]; // Ring of durations
+}
+
+const totals = new Map<Stage, StageTotals>();
+
+interface IngestSample {
+  time: number;
+  bytes: number;
+  lines: number;
+}
+
+interface FileCounters {
+  bytes: number;
+  lines: number;
+  samples: IngestSample[]; // Within RATE_WINDOW_MS, oldest first
+}
+
+const files = new Map<string, FileCounters>();
+
+/**
+ * Record a finished span
+ */
+export function recordSpan(
+  stage: Stage,
+  start: number,
+  duration: number,
+  detail?: { path?: string; count?: number },
+): void {
+  const span: Span = { stage, start, duration, path: detail?.path, count: detail?.count };
+  if (spans.length < MAX_SPANS) {
+    spans.push(span);
+  } else {
+    spans[nextSpan] = span;
+    nextSpan = (nextSpan + 1) % MAX_SPANS;
+  }
+
+  let stats = totals.get(stage);
+  if (!stats) {
+    stats = { count: 0, total: 0, max: 0, last: 0, recent: [] };
+    totals.set(stage, stats);
+  }
+  if (stats.recent.length < RECENT_PER_STAGE) stats.recent.push(duration);
+  else stats.recent[stats.count % RECENT_PER_STAGE] = duration;
+  stats.count++;
+  stats.total += duration;
+  stats.last = duration;
+  if (duration > stats.max) stats.max = duration;
+}
+
+/**
+ * Run fn as a span of `stage`
+ */
+export function measure<T>(stage: Stage, fn: () => T, detail?: { path?: string; count?: number }): T {
+  const start = performance.now();
+  try {
+    return fn();
+  } finally {
+    recordSpan(stage, start, performance.now() - start, detail);
+  }
+}
+
+/**
+ * Record a backend round trip: backendMs of it as "backend", the rest as "ipc"
+ */
+export function recordRoundTrip(
+  start: number,
+  backendMs: number | undefined,
+  detail?: { path?: string; count?: number },
+): void {
+  const total = performance.now() - start;
+  const backend = Math.min(backendMs ?? 0, total);
+  if (backendMs !== undefined) recordSpan("backend", start, backend, detail);
+  recordSpan("ipc", start + backend, total - backend, detail);
+}
+
+/**
+ * Count bytes and lines read from a file
+ */
+export function recordIngest(path: string, bytes: number, lines: number): void {
+  let counters = files.get(path);
+  if (!counters) {
+    counters = { bytes: 0, lines: 0, samples: [] };
+    files.set(path, counters);
+  }
+  const time = performance.now();
+  counters.bytes += bytes;
+  counters.lines += lines;
+  counters.samples.push({ time, bytes, lines });
+  pruneSamples(counters, time);
+}
+
+function pruneSamples(counters: FileCounters, now: number): void {
+  let expired = 0;
+  while (expired < counters.samples.length && now - counters.samples[expired].time > RATE_WINDOW_MS) {
+    expired++;
+  }
+  if (expired > 0) counters.samples.splice(0, expired);
+}
+
+function percentile(values: number[], p: number): number {
+  if (values.length === 0) return 0;
+  const sorted = values.slice().sort((a, b) => a - b);
+  return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+}
+
+/**
+ * Current per-stage timings and per-file throughput
+ */
+export function diagnosticsSnapshot(): { stages: StageStats[]; files: FileThroughput[] } {
+  const stages = STAGES.map((stage): StageStats => {
+    const stats = totals.get(stage);
+    if (!stats) return { stage, count: 0, last: 0, avg: 0, p95: 0, max: 0, total: 0 };
+    const recentTotal = stats.recent.reduce((sum, d) => sum + d, 0);
+    return {
+      stage,
+      count: stats.count,
+      last: stats.last,
+      avg: recentTotal / stats.recent.length,
+      p95: percentile(stats.recent, 0.95),
+      max: stats.max,
+      total: stats.total,
+    };
+  });
+
+  const now = performance.now();
+  const throughput: FileThroughput[] = [];
+  files.forEach((counters, path) => {
+    pruneSamples(counters, now);
+    let bytes = 0;
+    let lines = 0;
+    for (const sample of counters.samples) {
+      bytes += sample.bytes;
+      lines += sample.lines;
+    }
+    throughput.push({
+      path,
+      bytes: counters.bytes,
+      lines: counters.lines,
+      bytesPerSec: (bytes * 1000) / RATE_WINDOW_MS,
+      linesPerSec: (lines * 1000) / RATE_WINDOW_MS,
+    });
+  });
+
+  return { stages, files: throughput };
+}
+
+/**
+ * Clear recorded spans and counters
+ */
+export function resetDiagnostics(): void {
+  spans.length = 0;
+  nextSpan = 0;
+  totals.clear();
+  files.clear();
+}
+
+/**
+ * Recorded spans as Chrome trace events (oldest first; timestamps in µs
+ * since the page loaded)
+ */
+export function traceEvents(): object[] {
+  const ordered = spans.slice(nextSpan).concat(spans.slice(0, nextSpan));
+  return ordered.map((span) => ({
+    name: span.stage,
+    cat: "mocha",
+    ph: "X",
+    ts: Math.round(span.start * 1000),
+    dur: Math.round(span.duration * 1000),
+    pid: 1,
+    tid: 1,
+    args: {
+      ...(span.path !== undefined ? { path: span.path } : {}),
+      ...(span.count !== undefined ? { count: span.count } : {}),
+    },
+  }));
+}
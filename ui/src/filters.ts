@@ -0,0 +1,229 @@
+/**
+ * Mocha Log Viewer - Log Filtering
+ *
+ * Compiled filter plans and the filter pass over log entries. Kept free of
+ * store and component imports so the log worker can run it too.
+ */
+
+import type { LogEntry, ParsedFilter } from "./types";
+import { keyPool } from "./logColumns";
+
+/**
+ * Get short service name from log entry.
+ * For structured logs, extracts the last part of the logger name.
+ * For unstructured logs, returns the filename as-is to indicate parsing failed.
+ * Duplicated from LogLine.tsx so this module has no component imports.
+ */
+function getServiceName(log: LogEntry): string {
+  if (log.parsed?.logger) {
+    let logger = log.parsed.logger;
+    // Strip [File.java:123] suffix if present
+    logger = logger.replace(/\s*\[[^\]]+\.java:\d+\]$/, "");
+    const withoutLineNum = logger.split(":")[0];
+    const parts = withoutLineNum.split(".");
+    return parts[parts.length - 1] || withoutLineNum;
+  }
+
+  // For unstructured lines, use filename as-is
+  // This clearly indicates we couldn't parse the line
+  return log.name;
+}
+
+// ============================================================================
+// Helper: Apply filters to log entries
+// ============================================================================
+
+/**
+ * Per-entry values used by every filter pass, computed once per LogEntry.
+ * Kept in a WeakMap so entries stay plain (they are persisted and sent over IPC).
+ * Only small, interned values: text filters match the entry's own strings
+ * instead of a cached lowercased copy, which would double the text held.
+ */
+interface FilterFields {
+  serviceName: string;
+}
+
+const filterFieldCache = new WeakMap<LogEntry, FilterFields>();
+
+function getFilterFields(log: LogEntry): FilterFields {
+  let fields = filterFieldCache.get(log);
+  if (!fields) {
+    fields = { serviceName: keyPool.intern(getServiceName(log)) };
+    filterFieldCache.set(log, fields);
+  }
+  return fields;
+}
+
+/**
+ * Text that text/exclude filters match against: lowercased data and parsed
+ * content. NUL separator: filter values never contain it, so no match spans
+ * both parts. Built on each call (not cached), for the token index and
+ * auto-capture literals.
+ */
+export function buildSearchText(log: LogEntry): string {
+  const content = log.parsed?.content;
+  return content
+    ? `${log.data.toLowerCase()}\0${content.toLowerCase()}`
+    : log.data.toLowerCase();
+}
+
+/**
+ * Matcher for logs whose data or parsed content contains the value
+ * (case-insensitive), without lowercasing the log
+ */
+function containsText(value: string): (log: LogEntry) => boolean {
+  const regex = new RegExp(value.replace(/[.*+?^${}()|[\]\\]/g, "\\$&"), "i");
+  return (log) =>
+    regex.test(log.data) ||
+    (log.parsed?.content ? regex.test(log.parsed.content) : false);
+}
+
+type CompiledFilter = (log: LogEntry) => boolean;
+
+/**
+ * Filters compiled once per filter change: regexes (text values included)
+ * are built up front, include/exclude already partitioned.
+ */
+export interface FilterPlan {
+  include: CompiledFilter[]; // Any must match (if any)
+  exclude: CompiledFilter[]; // All must pass
+  // Values of the include filters when they are all plain text (a text
+  // index can resolve them), otherwise null
+  includeText: string[] | null;
+}
+
+/**
+ * Compile a single filter into a matcher.
+ * Exclude filters return true when the log passes (does not contain the value).
+ */
+function compileFilter(filter: ParsedFilter): CompiledFilter {
+  switch (filter.type) {
+    case "regex": {
+      let regex: RegExp;
+      try {
+        regex = new RegExp(filter.value, "i");
+      } catch {
+        return () => false;
+      }
+      return (log) =>
+        regex.test(log.data) ||
+        (log.parsed?.content ? regex.test(log.parsed.content) : false);
+    }
+    case "text":
+      return containsText(filter.value);
+    case "exclude": {
+      const contains = containsText(filter.value);
+      return (log) => !contains(log);
+    }
+    default:
+      return () => true;
+  }
+}
+
+/**
+ * Build the filter plan for a filter list (call once per filter change).
+ */
+export function compileFilters(filters: ParsedFilter[]): FilterPlan {
+  const plan: FilterPlan = { include: [], exclude: [], includeText: [] };
+  for (const filter of filters) {
+    if (filter.type === "exclude") {
+      plan.exclude.push(compileFilter(filter));
+    } else {
+      plan.include.push(compileFilter(filter));
+      if (filter.type === "text") plan.includeText?.push(filter.value);
+      else plan.includeText = null;
+    }
+  }
+  if (plan.include.length === 0) plan.includeText = null;
+  return plan;
+}
+
+/**
+ * Check a log entry against a compiled plan and service visibility.
+ */
+export function matchesFilterPlan(
+  log: LogEntry,
+  plan: FilterPlan,
+  inactiveNames: Set<string>,
+): boolean {
+  const fields = getFilterFields(log);
+
+  // Check if service is visible (using derived service name from logger)
+  if (inactiveNames.has(fields.serviceName)) return false;
+
+  // Any include filter must match (if any)
+  if (plan.include.length > 0) {
+    let matched = false;
+    for (const include of plan.include) {
+      if (include(log)) {
+        matched = true;
+        break;
+      }
+    }
+    if (!matched) return false;
+  }
+
+  // All exclude filters must pass (none should match the exclude pattern)
+  for (const exclude of plan.exclude) {
+    if (!exclude(log)) return false;
+  }
+
+  return true;
+}
+
+/**
+ * Resolves plain-text filters over a list of logs without scanning it
+ * (see tokenIndex.ts)
+ */
+export interface ListTextIndex {
+  /**
+   * Logs of the list containing any of the values (case-insensitive), in
+   * list order, or null if the index can't tell
+   */
+  containingAny(values: string[]): LogEntry[] | null;
+}
+
+const listTextIndexes = new WeakMap<LogEntry[], ListTextIndex>();
+
+/**
+ * Attach a text index to a list of logs; filterLogs on that exact array then
+ * resolves text include filters through it
+ */
+export function setListTextIndex(logs: LogEntry[], index: ListTextIndex): void {
+  listTextIndexes.set(logs, index);
+}
+
+/**
+ * Filter log entries based on active filters and service visibility.
+ *
+ * @param logs - Array of log entries to filter
+ * @param filters - Array of active filters (or a plan from compileFilters)
+ * @param inactiveNames - Set of hidden service names
+ * @returns Filtered array of log entries
+ */
+export function filterLogs(
+  logs: LogEntry[],
+  filters: ParsedFilter[] | FilterPlan,
+  inactiveNames: Set<string>,
+): LogEntry[] {
+  const plan = Array.isArray(filters) ? compileFilters(filters) : filters;
+  const hidden = inactiveNames instanceof Set ? inactiveNames : new Set<string>();
+
+  // No filters and nothing hidden: every log passes
+  if (plan.include.length === 0 && plan.exclude.length === 0 && hidden.size === 0) {
+    return logs.slice();
+  }
+
+  // Text include filters: only the logs the index finds can pass
+  const index = plan.includeText ? listTextIndexes.get(logs) : undefined;
+  const candidates = index?.containingAny(plan.includeText ?? []);
+  if (candidates) {
+    return candidates.filter((log) => matchesFilterPlan(log, plan, hidden));
+  }
+
+  const result: LogEntry[] = [];
+  for (const log of logs) {
+    if (matchesFilterPlan(log, plan, hidden)) result.push(log);
+  }
+  return result;
+}
@@ -0,0 +1,232 @@
+/**
+ * Mocha Log Viewer - Bounded Per-File Log Store
+ *
+ * A buffer of log entries with a fixed capacity. Appending costs
+ * O(appended): only the new entries get timestamps (continuing the running
+ * timestamp state), and once full, the oldest entries are evicted.
+ * Entries are kept in fixed-size chunks that are only ever appended to, so
+ * the `logs` list the UI reads after each change shares them with earlier
+ * lists instead of copying every entry (see LogList). Entries get their
+ * repeated strings interned as they come in, and (when enabled) are added
+ * to the buffer's token index for text filters.
+ */
+
+import type { LogEntry } from "./types";
+import {
+  advanceTimestamps,
+  createTimestampClock,
+  type TimestampClock,
+} from "./parser";
+import { internLogStrings } from "./logColumns";
+import { TokenIndex } from "./tokenIndex";
+import { measure } from "./diagnostics";
+
+/** Default number of log entries kept per file */
+export const DEFAULT_MAX_LOGS_PER_FILE = 50_000;
+
+// Entries per chunk (a power of two)
+const CHUNK_BITS = 10;
+const CHUNK_SIZE = 1 << CHUNK_BITS;
+const CHUNK_MASK = CHUNK_SIZE - 1;
+
+/**
+ * Immutable list of a buffer's logs as of one change, oldest first. Lists
+ * share the buffer's chunks: entries appended later land past `length` and
+ * evicted ones before the list's offset, so neither shows here. Taking a
+ * list costs O(capacity / CHUNK_SIZE).
+ */
+export class LogList implements Iterable<LogEntry> {
+  private array: LogEntry[] | null = null;
+
+  constructor(
+    private readonly chunks: readonly LogEntry[][],
+    private readonly offset: number, // Position of the first entry in chunks[0]
+    readonly length: number,
+    readonly start: number, // Entries evicted from the buffer before the first one
+    private readonly series: object, // Buffer contents the positions count in
+  ) {}
+
+  /** Entry `i` (undefined out of range) */
+  at(i: number): LogEntry | undefined {
+    if (i < 0 || i >= this.length) return undefined;
+    const j = this.offset + i;
+    return this.chunks[j >> CHUNK_BITS][j & CHUNK_MASK];
+  }
+
+  [Symbol.iterator](): Iterator<LogEntry> {
+    let i = 0;
+    return {
+      next: () =>
+        i < this.length
+          ? { value: this.at(i++) as LogEntry, done: false }
+          : { value: undefined, done: true },
+    };
+  }
+
+  /** Entries [begin, end) as an array */
+  slice(begin: number = 0, end: number = this.length): LogEntry[] {
+    begin = Math.max(0, begin);
+    end = Math.min(this.length, end);
+    const out: LogEntry[] = new Array(Math.max(0, end - begin));
+    for (let i = begin; i < end; i++) out[i - begin] = this.at(i) as LogEntry;
+    return out;
+  }
+
+  /** All entries as an array (built once per list) */
+  toArray(): LogEntry[] {
+    return (this.array ??= this.slice());
+  }
+
+  /**
+   * Whether this list is `prev` with entries evicted from its front and/or
+   * appended at its end (and nothing else changed)
+   */
+  continues(prev: LogList): boolean {
+    return (
+      this.series === prev.series &&
+      this.start >= prev.start &&
+      this.start + this.length >= prev.start + prev.length
+    );
+  }
+}
+
+export class LogBuffer {
+  private capacity: number;
+  private chunks: LogEntry[][] = [];
+  private offset = 0; // Position of the oldest entry in chunks[0]
+  private size = 0;
+  private evicted = 0; // Entries dropped from the front so far
+  private series: object = {};
+  private clock: TimestampClock = createTimestampClock();
+  private list: LogList;
+  private indexed: boolean;
+  private index: TokenIndex | null;
+
+  private constructor(capacity: number, indexed: boolean) {
+    this.capacity = capacity;
+    this.indexed = indexed;
+    this.index = indexed ? new TokenIndex() : null;
+    this.list = this.takeList();
+  }
+
+  /**
+   * Create a buffer holding `logs` (timestamps are recalculated for them)
+   *
+   * @param indexed - Keep a token index of the buffered logs
+   */
+  static from(logs: LogEntry[], capacity: number, indexed: boolean = false): LogBuffer {
+    const buffer = new LogBuffer(Math.max(1, capacity), indexed);
+    buffer.append(logs);
+    return buffer;
+  }
+
+  /** The buffered logs, oldest first */
+  get logs(): LogList {
+    return this.list;
+  }
+
+  /** Token index of the buffered logs (null if not indexed) */
+  get textIndex(): TokenIndex | null {
+    return this.index;
+  }
+
+  /**
+   * Append logs from the end of the file, evicting the oldest when full.
+   */
+  append(newLogs: LogEntry[]): void {
+    if (newLogs.length === 0) return;
+
+    internLogStrings(newLogs);
+    measure(
+      "timestamps",
+      () =>
+        advanceTimestamps(this.clock, newLogs, (timestamp, index) => {
+          // First real timestamp: backfill the buffered logs that had none
+          for (let k = 0; k < this.size; k++) {
+            const log = this.list.at(k) as LogEntry;
+            log.timestamp = timestamp;
+            log.sortIndex = this.evicted + k - index;
+          }
+        }),
+      { count: newLogs.length },
+    );
+
+    // Only the last `capacity` new logs can survive
+    const start = Math.max(0, newLogs.length - this.capacity);
+    let last = this.chunks[this.chunks.length - 1];
+    for (let i = start; i < newLogs.length; i++) {
+      if (!last || last.length === CHUNK_SIZE) {
+        last = [];
+        this.chunks.push(last);
+      }
+      last.push(newLogs[i]);
+    }
+    this.size += newLogs.length - start;
+    this.evicted += start;
+
+    const evicted = this.evictOver();
+    if (this.index) {
+      this.index.evictOldest(evicted);
+      this.index.add(start > 0 ? newLogs.slice(start) : newLogs);
+    }
+    this.list = this.takeList();
+  }
+
+  /**
+   * Prepend an older page of logs. Paging back moves the window, so when
+   * full the newest logs are dropped. Rare, so timestamps are recalculated
+   * for all buffered logs.
+   */
+  prepend(olderLogs: LogEntry[]): void {
+    const kept = olderLogs.concat(this.list.toArray()).slice(0, this.capacity);
+    this.reset();
+    this.append(kept);
+  }
+
+  /**
+   * Change the capacity, evicting the oldest logs if it shrinks.
+   */
+  setCapacity(capacity: number): void {
+    capacity = Math.max(1, capacity);
+    if (capacity === this.capacity) return;
+
+    // The logs already have timestamps: the running state carries on
+    this.capacity = capacity;
+    const evicted = this.evictOver();
+    if (evicted === 0) return;
+    this.index?.evictOldest(evicted);
+    this.list = this.takeList();
+  }
+
+  /**
+   * Drop the oldest logs beyond the capacity (and the chunks left empty).
+   * Returns how many were dropped.
+   */
+  private evictOver(): number {
+    const over = Math.max(0, this.size - this.capacity);
+    this.offset += over;
+    this.size -= over;
+    this.evicted += over;
+    const emptied = this.offset >> CHUNK_BITS;
+    if (emptied > 0) {
+      this.chunks.splice(0, emptied);
+      this.offset &= CHUNK_MASK;
+    }
+    return over;
+  }
+
+  private reset(): void {
+    this.chunks = [];
+    this.offset = 0;
+    this.size = 0;
+    this.evicted = 0;
+    this.series = {};
+    this.clock = createTimestampClock();
+    this.index = this.indexed ? new TokenIndex() : null;
+    this.list = this.takeList();
+  }
+
+  private takeList(): LogList {
+    return new LogList(this.chunks.slice(), this.offset, this.size, this.evicted, this.series);
+  }
+}
@@ -0,0 +1,294 @@
+/**
+ * Mocha Log Viewer - Columnar Log Data
+ *
+ * Compact representations for the hot loops over loaded logs:
+ * - String pools intern the strings repeated on every row (file name, path,
+ *   logger, level) so all rows share one instance and get a numeric id.
+ * - LogColumns gathers the sort keys, level and group keys of a set of logs
+ *   into typed arrays, so sorting never touches the entry objects.
+ * - LevelIndex tracks the errors and warnings of the displayed list, updated
+ *   as logs are appended.
+ */
+
+import type { LogEntry } from "./types";
+
+// ============================================================================
+// String Interning
+// ============================================================================
+
+/**
+ * Interns strings: equal strings map to one shared instance and a stable id
+ * (ids start at 1, 0 means "none").
+ */
+export class StringPool {
+  private ids = new Map<string, number>();
+  private values: string[] = [""];
+
+  /** Id of a string, assigned on first use */
+  id(value: string): number {
+    let id = this.ids.get(value);
+    if (id === undefined) {
+      id = this.values.length;
+      this.ids.set(value, id);
+      this.values.push(value);
+    }
+    return id;
+  }
+
+  /** String for an id */
+  value(id: number): string {
+    return this.values[id];
+  }
+
+  /** Shared instance of a string */
+  intern(value: string): string {
+    return this.values[this.id(value)];
+  }
+
+  get size(): number {
+    return this.values.length - 1;
+  }
+}
+
+// Pools for the per-row strings (few distinct values, repeated on every row)
+export const filePool = new StringPool();
+export const loggerPool = new StringPool();
+// Service names and thread ids used as group keys
+export const keyPool = new StringPool();
+
+/**
+ * Replace the repeated strings of freshly loaded logs with pooled instances.
+ * Logs arrive from IPC/parsing with their own copy of every string; interning
+ * them leaves one copy per distinct value. Mutates the entries in place.
+ */
+export function internLogStrings(logs: LogEntry[]): void {
+  for (const log of logs) {
+    log.name = filePool.intern(log.name);
+    if (log.filePath) log.filePath = filePool.intern(log.filePath);
+    const parsed = log.parsed;
+    if (parsed?.logger) parsed.logger = loggerPool.intern(parsed.logger);
+  }
+}
+
+// ============================================================================
+// Levels
+// ============================================================================
+
+export const LEVEL_NONE = 0;
+export const LEVEL_ERROR = 1;
+export const LEVEL_WARN = 2;
+export const LEVEL_OTHER = 3;
+
+/**
+ * Compact level code of a log (ERROR / WARN or WARNING / anything else)
+ */
+export function levelCode(log: LogEntry): number {
+  const level = log.parsed?.level?.toUpperCase();
+  if (!level) return LEVEL_NONE;
+  if (level === "ERROR") return LEVEL_ERROR;
+  if (level === "WARN" || level === "WARNING") return LEVEL_WARN;
+  return LEVEL_OTHER;
+}
+
+// ============================================================================
+// Columns
+// ============================================================================
+
+/**
+ * Values a row contributes besides its timestamp and sortIndex
+ */
+export interface RowKeys {
+  level: number; // Level code
+  service: number; // Service id (keyPool)
+  thread: number; // Thread id (keyPool), 0 if none
+}
+
+/**
+ * Typed-array columns for a list of logs (row i = logs[i])
+ */
+export class LogColumns {
+  readonly length: number;
+  readonly timestamp: Float64Array;
+  readonly sortIndex: Float64Array;
+  readonly level: Uint8Array;
+  readonly service: Uint32Array;
+  readonly thread: Uint32Array;
+
+  private constructor(length: number) {
+    this.length = length;
+    this.timestamp = new Float64Array(length);
+    this.sortIndex = new Float64Array(length);
+    this.level = new Uint8Array(length);
+    this.service = new Uint32Array(length);
+    this.thread = new Uint32Array(length);
+  }
+
+  /**
+   * Gather the columns of `logs`; `keys` supplies the (cached) per-row keys
+   */
+  static from(logs: LogEntry[], keys: (log: LogEntry) => RowKeys): LogColumns {
+    const columns = new LogColumns(logs.length);
+    for (let i = 0; i < logs.length; i++) {
+      const log = logs[i];
+      const rowKeys = keys(log);
+      columns.timestamp[i] = log.timestamp ?? 0;
+      columns.sortIndex[i] = log.sortIndex ?? 0;
+      columns.level[i] = rowKeys.level;
+      columns.service[i] = rowKeys.service;
+      columns.thread[i] = rowKeys.thread;
+    }
+    return columns;
+  }
+
+  /**
+   * Row order newest first: timestamp descending, then sortIndex descending,
+   * then row order for ties (a stable sort)
+   */
+  newestFirstOrder(): Uint32Array {
+    const { timestamp, sortIndex } = this;
+    const order = new Uint32Array(this.length);
+    for (let i = 0; i < order.length; i++) order[i] = i;
+    order.sort(
+      (a, b) => timestamp[b] - timestamp[a] || sortIndex[b] - sortIndex[a] || a - b,
+    );
+    return order;
+  }
+}
+
+// ============================================================================
+// Level Index
+// ============================================================================
+
+/**
+ * Error/warning counts of one service
+ */
+export interface ServiceLevelCounts {
+  service: string;
+  errors: number;
+  warnings: number;
+}
+
+/**
+ * Errors and warnings of a display list (rows newest first), kept up to date
+ * as new logs land on top instead of rescanning the list.
+ *
+ * Rows are stored by rank from the bottom (oldest row = 0): logs added on top
+ * leave the ranks of the rows below unchanged, so an update only touches the
+ * rows that changed at the top.
+ */
+export class LevelIndex {
+  private rows: number; // Rows in the list
+  private errors: number[]; // Ranks, ascending
+  private warnings: number[];
+  private services: Map<number, [number, number]>; // Service id -> [errors, warnings]
+
+  private constructor(
+    rows: number,
+    errors: number[],
+    warnings: number[],
+    services: Map<number, [number, number]>,
+  ) {
+    this.rows = rows;
+    this.errors = errors;
+    this.warnings = warnings;
+    this.services = services;
+  }
+
+  /**
+   * Index a display list; `keys` supplies the (cached) per-row keys
+   */
+  static from(rows: LogEntry[], keys: (log: LogEntry) => RowKeys): LevelIndex {
+    const index = new LevelIndex(0, [], [], new Map());
+    index.addTop(rows, keys);
+    return index;
+  }
+
+  /**
+   * Index of the list after its top `removed` rows were replaced by `added`
+   * (new logs regrouped with the old first group). This index is unchanged.
+   */
+  replaceTop(
+    removed: LogEntry[],
+    added: LogEntry[],
+    keys: (log: LogEntry) => RowKeys,
+  ): LevelIndex {
+    const kept = this.rows - removed.length;
+    const index = new LevelIndex(
+      kept,
+      this.errors.filter((rank) => rank < kept),
+      this.warnings.filter((rank) => rank < kept),
+      new Map(Array.from(this.services, ([id, counts]) => [id, [counts[0], counts[1]]])),
+    );
+    for (const log of removed) index.count(keys(log), -1);
+    index.addTop(added, keys);
+    return index;
+  }
+
+  get length(): number {
+    return this.rows;
+  }
+
+  get errorCount(): number {
+    return this.errors.length;
+  }
+
+  get warningCount(): number {
+    return this.warnings.length;
+  }
+
+  /** Row of the n-th error from the top */
+  errorAt(n: number): number {
+    return this.rows - 1 - this.errors[this.errors.length - 1 - n];
+  }
+
+  /** Row of the n-th warning from the top */
+  warningAt(n: number): number {
+    return this.rows - 1 - this.warnings[this.warnings.length - 1 - n];
+  }
+
+  /**
+   * Counts per service with any errors or warnings, most errors first
+   */
+  countsByService(): ServiceLevelCounts[] {
+    const counts: ServiceLevelCounts[] = [];
+    this.services.forEach(([errors, warnings], id) => {
+      if (errors > 0 || warnings > 0) {
+        counts.push({ service: keyPool.value(id), errors, warnings });
+      }
+    });
+    return counts.sort(
+      (a, b) =>
+        b.errors - a.errors ||
+        b.warnings - a.warnings ||
+        a.service.localeCompare(b.service),
+    );
+  }
+
+  /**
+   * Put rows (newest first) on top of the indexed ones
+   */
+  private addTop(rows: LogEntry[], keys: (log: LogEntry) => RowKeys): void {
+    const base = this.rows;
+    this.rows += rows.length;
+    // Bottom row first, so ranks stay ascending
+    for (let i = rows.length - 1; i >= 0; i--) {
+      const rowKeys = keys(rows[i]);
+      const rank = base + rows.length - 1 - i;
+      if (rowKeys.level === LEVEL_ERROR) this.errors.push(rank);
+      else if (rowKeys.level === LEVEL_WARN) this.warnings.push(rank);
+      this.count(rowKeys, 1);
+    }
+  }
+
+  private count(rowKeys: RowKeys, delta: number): void {
+    const slot =
+      rowKeys.level === LEVEL_ERROR ? 0 : rowKeys.level === LEVEL_WARN ? 1 : -1;
+    if (slot < 0) return;
+    let counts = this.services.get(rowKeys.service);
+    if (!counts) {
+      counts = [0, 0];
+      this.services.set(rowKeys.service, counts);
+    }
+    counts[slot] += delta;
+  }
+}
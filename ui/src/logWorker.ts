@@ -0,0 +1,198 @@
+/**
+ * Mocha Log Viewer - Log Worker
+ *
+ * Parsing, filtering and search for browser mode, off the main thread.
+ * File content arrives as a transferred buffer; the parsed logs stay here
+ * (a copy goes back for rendering), so filter and search passes only send
+ * back row indices in transferable typed arrays.
+ *
+ * Filter and search passes run in slices and yield between them, so a
+ * cancel message - or a newer pass of the same kind - stops them midway.
+ */
+
+import { parseLogFile } from "./parser";
+import { compileFilters, matchesFilterPlan } from "./filters";
+import { compareTimeline, isInTimelineOrder, mergeRuns } from "./timeline";
+import type { LogEntry, LogWorkerRequest, LogWorkerResponse } from "./types";
+
+// Rows handled between yields to the message queue
+const SLICE_ROWS = 5000;
+
+type PassKind = "filter" | "search";
+
+type FilterRequest = Extract<LogWorkerRequest, { type: "filter" }>;
+type SearchRequest = Extract<LogWorkerRequest, { type: "search" }>;
+
+class PassCancelled extends Error {}
+
+// Parsed logs per file key, in file order
+const files = new Map<string, LogEntry[]>();
+// Rows of the last completed filter pass, oldest first (searched by id)
+let lastFilter: { id: number; logs: LogEntry[] } | null = null;
+
+const running = new Set<number>();
+const cancelled = new Set<number>();
+const latest: Record<PassKind, number> = { filter: 0, search: 0 };
+
+function post(response: LogWorkerResponse, transfer: Transferable[] = []): void {
+  self.postMessage(response, { transfer });
+}
+
+/**
+ * Let queued messages (cancels, newer passes) run, then stop if this pass
+ * is no longer wanted
+ */
+async function checkpoint(id: number, kind: PassKind): Promise<void> {
+  await new Promise((resolve) => setTimeout(resolve, 0));
+  if (cancelled.has(id) || latest[kind] !== id) throw new PassCancelled();
+}
+
+async function run(id: number, pass: () => Promise<void>): Promise<void> {
+  running.add(id);
+  try {
+    await pass();
+  } catch (err) {
+    if (err instanceof PassCancelled) {
+      post({ type: "cancelled", id });
+    } else {
+      post({ type: "error", id, error: err instanceof Error ? err.message : String(err) });
+    }
+  } finally {
+    running.delete(id);
+    cancelled.delete(id);
+  }
+}
+
+function parse(request: Extract<LogWorkerRequest, { type: "parse" }>): void {
+  try {
+    const content = new TextDecoder().decode(request.buffer);
+    const result = parseLogFile(content, request.name, request.fileKey);
+    files.set(request.fileKey, result.logs);
+    post({ type: "parsed", id: request.id, result, size: content.length });
+  } catch (err) {
+    post({
+      type: "error",
+      id: request.id,
+      error: err instanceof Error ? err.message : "Failed to parse file",
+    });
+  }
+}
+
+/**
+ * Stably sort a file's filtered rows into timeline order
+ */
+function sortRun(run: { logs: LogEntry[]; rows: number[] }): void {
+  const order = run.logs.map((_, i) => i);
+  order.sort((a, b) => compareTimeline(run.logs[a], run.logs[b]) || a - b);
+  run.logs = order.map((i) => run.logs[i]);
+  run.rows = order.map((i) => run.rows[i]);
+}
+
+/**
+ * Filter the requested files and merge the rows oldest first, in the same
+ * timeline order as the main thread's merged view (see timeline.ts)
+ */
+async function filter(request: FilterRequest): Promise<void> {
+  const plan = compileFilters(request.filters);
+  const hidden = new Set(request.inactiveNames);
+
+  const runs: { logs: LogEntry[]; rows: number[] }[] = [];
+  const totals: number[] = [];
+  let missing = false;
+  let sinceYield = 0;
+
+  for (let f = 0; f < request.fileKeys.length; f++) {
+    const run: { logs: LogEntry[]; rows: number[] } = { logs: [], rows: [] };
+    runs.push(run);
+    const fileLogs = files.get(request.fileKeys[f]);
+    if (!fileLogs) {
+      missing = true;
+      totals.push(0);
+      continue;
+    }
+    totals.push(fileLogs.length);
+    for (let row = 0; row < fileLogs.length; row++) {
+      const log = fileLogs[row];
+      if (matchesFilterPlan(log, plan, hidden)) {
+        run.logs.push(log);
+        run.rows.push(row);
+      }
+      if (++sinceYield === SLICE_ROWS) {
+        sinceYield = 0;
+        await checkpoint(request.id, "filter");
+      }
+    }
+    if (!isInTimelineOrder(run.logs)) sortRun(run);
+  }
+
+  // Each file's filtered rows are a run of the timeline - merge them
+  const { logs: sorted, runOf } = mergeRuns(runs.map((run) => run.logs));
+  const fileIndices = new Uint32Array(sorted.length);
+  const rowIndices = new Uint32Array(sorted.length);
+  const cursor = new Array<number>(runs.length).fill(0);
+  for (let i = 0; i < sorted.length; i++) {
+    const run = runOf[i];
+    fileIndices[i] = run;
+    rowIndices[i] = runs[run].rows[cursor[run]++];
+  }
+
+  lastFilter = { id: request.id, logs: sorted };
+  post(
+    { type: "filtered", id: request.id, files: fileIndices, rows: rowIndices, totals, missing },
+    [fileIndices.buffer, rowIndices.buffer],
+  );
+}
+
+/**
+ * Positions of the rows of a filter pass whose data matches the query
+ */
+async function search(request: SearchRequest): Promise<void> {
+  if (!lastFilter || lastFilter.id !== request.filterId) {
+    throw new Error("Filter results are no longer available");
+  }
+  const logs = lastFilter.logs;
+
+  let regex: RegExp;
+  try {
+    regex = request.isRegex
+      ? new RegExp(request.query, "i")
+      : new RegExp(request.query.replace(/[.*+?^${}()|[\]\\]/g, "\\$&"), "i");
+  } catch {
+    // Invalid regex - no matches
+    post({ type: "searched", id: request.id, matches: new Uint32Array(0) });
+    return;
+  }
+
+  const positions: number[] = [];
+  for (let i = 0; i < logs.length; i++) {
+    if (regex.test(logs[i].data)) positions.push(i);
+    if ((i + 1) % SLICE_ROWS === 0) await checkpoint(request.id, "search");
+  }
+
+  const matches = Uint32Array.from(positions);
+  post({ type: "searched", id: request.id, matches }, [matches.buffer]);
+}
+
+self.onmessage = (event: MessageEvent<LogWorkerRequest>) => {
+  const request = event.data;
+  switch (request.type) {
+    case "parse":
+      parse(request);
+      break;
+    case "filter":
+      latest.filter = request.id;
+      run(request.id, () => filter(request));
+      break;
+    case "search":
+      latest.search = request.id;
+      run(request.id, () => search(request));
+      break;
+    case "cancel":
+      if (running.has(request.id)) cancelled.add(request.id);
+      break;
+    case "drop":
+      files.delete(request.fileKey);
+      lastFilter = null;
+      break;
+  }
+};
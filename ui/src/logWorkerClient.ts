@@ -0,0 +1,192 @@
+/**
+ * Mocha Log Viewer - Log Worker Client
+ *
+ * Main-thread side of the log worker (browser mode). Each pass is a promise;
+ * aborting its signal cancels the pass in the worker and rejects with an
+ * AbortError, so a superseded filter or search never lands.
+ */
+
+import type {
+  LogWorkerRequest,
+  LogWorkerResponse,
+  ParsedFilter,
+  ParsedLogFileResult,
+} from "./types";
+
+type Pending = {
+  resolve: (response: LogWorkerResponse) => void;
+  reject: (err: Error) => void;
+};
+
+let worker: Worker | null = null;
+let nextId = 1;
+const pending = new Map<number, Pending>();
+
+/**
+ * Check if the log worker can run here
+ */
+export function isLogWorkerSupported(): boolean {
+  return typeof Worker !== "undefined";
+}
+
+/**
+ * Check if an error is a cancelled pass
+ */
+export function isAbortError(err: unknown): boolean {
+  return err instanceof DOMException && err.name === "AbortError";
+}
+
+function getWorker(): Worker {
+  if (!worker) {
+    worker = new Worker(new URL("./logWorker.ts", import.meta.url), {
+      type: "module",
+    });
+    worker.onmessage = (event: MessageEvent<LogWorkerResponse>) => {
+      const response = event.data;
+      const request = pending.get(response.id);
+      if (!request) return; // Aborted on this side already
+      pending.delete(response.id);
+      if (response.type === "error") {
+        request.reject(new Error(response.error));
+      } else if (response.type === "cancelled") {
+        request.reject(new DOMException("Pass cancelled", "AbortError"));
+      } else {
+        request.resolve(response);
+      }
+    };
+    worker.onerror = (event) => {
+      // Worker crashed - fail everything in flight and start fresh next time
+      const err = new Error(event.message || "Log worker failed");
+      pending.forEach((request) => request.reject(err));
+      pending.clear();
+      worker?.terminate();
+      worker = null;
+    };
+  }
+  return worker;
+}
+
+function send(request: LogWorkerRequest, transfer: Transferable[] = []): void {
+  getWorker().postMessage(request, transfer);
+}
+
+/**
+ * Send a pass and wait for its response
+ */
+function runPass(
+  request: Extract<LogWorkerRequest, { id: number }>,
+  transfer: Transferable[] = [],
+  signal?: AbortSignal,
+): Promise<LogWorkerResponse> {
+  return new Promise((resolve, reject) => {
+    if (signal?.aborted) {
+      reject(new DOMException("Pass cancelled", "AbortError"));
+      return;
+    }
+    const id = request.id;
+    pending.set(id, { resolve, reject });
+    signal?.addEventListener(
+      "abort",
+      () => {
+        if (!pending.delete(id)) return;
+        send({ type: "cancel", id });
+        reject(new DOMException("Pass cancelled", "AbortError"));
+      },
+      { once: true },
+    );
+    send(request, transfer);
+  });
+}
+
+/**
+ * Parse a file in the worker. The file's bytes are transferred, not copied;
+ * the worker keeps the parsed logs for later filter and search passes.
+ *
+ * @param file - File picked in the browser
+ * @param fileKey - Key the file is opened under (its path in the file store)
+ * @returns Parse result and the content length in characters
+ */
+export async function parseFileInWorker(
+  file: File,
+  fileKey: string,
+): Promise<{ result: ParsedLogFileResult; size: number }> {
+  const buffer = await file.arrayBuffer();
+  const response = await runPass(
+    { type: "parse", id: nextId++, fileKey, name: file.name, buffer },
+    [buffer],
+  );
+  if (response.type !== "parsed") throw new Error("Unexpected log worker response");
+  return { result: response.result, size: response.size };
+}
+
+/**
+ * Result of a worker filter pass: filtered rows oldest first
+ */
+export interface WorkerFilterResult {
+  filterId: number; // Pass id, used to search these rows
+  files: Uint32Array; // Index into fileKeys per row
+  rows: Uint32Array; // Row in that file's parsed logs
+  totals: number[]; // Rows the worker holds per file
+  missing: boolean; // Some file was not parsed by the worker
+}
+
+/**
+ * Filter the worker's copy of the given files
+ *
+ * @param fileKeys - Files to include, in merge order
+ * @param filters - Active filters
+ * @param inactiveNames - Hidden service names
+ * @param signal - Aborting cancels the pass
+ */
+export async function filterInWorker(
+  fileKeys: string[],
+  filters: ParsedFilter[],
+  inactiveNames: Set<string>,
+  signal?: AbortSignal,
+): Promise<WorkerFilterResult> {
+  const id = nextId++;
+  const response = await runPass(
+    { type: "filter", id, fileKeys, filters, inactiveNames: Array.from(inactiveNames) },
+    [],
+    signal,
+  );
+  if (response.type !== "filtered") throw new Error("Unexpected log worker response");
+  return {
+    filterId: id,
+    files: response.files,
+    rows: response.rows,
+    totals: response.totals,
+    missing: response.missing,
+  };
+}
+
+/**
+ * Search the rows of a filter pass
+ *
+ * @param filterId - Pass whose rows to search (the latest one)
+ * @param query - Search text or pattern
+ * @param isRegex - Treat the query as a regular expression
+ * @param signal - Aborting cancels the pass
+ * @returns Positions of matching rows, oldest first
+ */
+export async function searchInWorker(
+  filterId: number,
+  query: string,
+  isRegex: boolean,
+  signal?: AbortSignal,
+): Promise<Uint32Array> {
+  const response = await runPass(
+    { type: "search", id: nextId++, filterId, query, isRegex },
+    [],
+    signal,
+  );
+  if (response.type !== "searched") throw new Error("Unexpected log worker response");
+  return response.matches;
+}
+
+/**
+ * Release the worker's copy of a closed file
+ */
+export function dropWorkerFile(fileKey: string): void {
+  if (worker) send({ type: "drop", fileKey });
+}
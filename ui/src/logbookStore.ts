@@ -0,0 +1,256 @@
+/**
+ * Mocha Log Viewer - Logbook Persistence
+ *
+ * In Tauri, logbooks are stored by the backend under ~/.mocha/logbooks
+ * instead of localStorage. Story store changes are diffed against what was
+ * last written and sent as per-entry operations (add, remove, reorder),
+ * debounced, so a toggle writes one entry rather than every logbook.
+ *
+ * At startup only each logbook's metadata and entry hashes are loaded; a
+ * logbook's entries are read when it becomes active. Until then its
+ * `storedHashes` stand in for the entries on disk (dedup, counts) and
+ * `entries` holds only what was captured since.
+ *
+ * Logbooks found in localStorage (older versions) are moved to disk on
+ * the first run.
+ */
+
+import { isTauri, loadLogbookEntries, loadLogbooks, writeLogbooks } from "./api";
+import { useFileStore, useStoryStore } from "./store";
+import type { LogbookMeta, LogbookOp, LogbookSummary, LogEntry, Story } from "./types";
+
+// Quiet time before changes are written
+const FLUSH_DELAY_MS = 500;
+
+// Each story as last written, by id
+let persisted = new Map<string, Story>();
+// Stories whose last write failed - written whole (or deleted) next time
+const unsaved = new Set<string>();
+let started = false;
+let flushTimer: ReturnType<typeof setTimeout> | null = null;
+let writing: Promise<void> = Promise.resolve();
+const loading = new Map<string, Promise<void>>();
+
+function metaOf(story: Story): LogbookMeta {
+  return {
+    id: story.id,
+    name: story.name,
+    createdAt: story.createdAt,
+    patterns: story.patterns || [],
+    manuallyAddedHashes: story.manuallyAddedHashes || [],
+    minimizedHashes: story.minimizedHashes || [],
+  };
+}
+
+function sameMeta(a: Story, b: Story): boolean {
+  return (
+    a.name === b.name &&
+    a.createdAt === b.createdAt &&
+    a.patterns === b.patterns &&
+    a.manuallyAddedHashes === b.manuallyAddedHashes &&
+    a.minimizedHashes === b.minimizedHashes
+  );
+}
+
+function storyFromSummary(summary: LogbookSummary): Story {
+  return {
+    id: summary.id,
+    name: summary.name,
+    createdAt: summary.createdAt,
+    patterns: summary.patterns || [],
+    manuallyAddedHashes: summary.manuallyAddedHashes || [],
+    minimizedHashes: summary.minimizedHashes || [],
+    entries: [],
+    storedHashes: summary.hashes,
+  };
+}
+
+function hashesOf(entries: LogEntry[]): string[] {
+  return entries.map((e) => e.hash).filter((h): h is string => !!h);
+}
+
+/**
+ * Operations turning a story's written entries into its current ones.
+ * Story actions append, remove or reorder; anything else is rewritten in
+ * full (loaded stories only - an unloaded one has more entries on disk).
+ */
+function entryOps(id: string, prev: LogEntry[], next: LogEntry[], loaded: boolean): LogbookOp[] {
+  if (prev === next) return [];
+
+  // Appended (auto-capture, add to logbook)
+  if (next.length >= prev.length && prev.every((entry, i) => next[i] === entry)) {
+    return next.length > prev.length
+      ? [{ op: "add", id, entries: next.slice(prev.length) }]
+      : [];
+  }
+
+  if (next.length === 0 && loaded) return [{ op: "replace", id, entries: [] }];
+
+  // Removed and/or reordered
+  const nextHashes = new Set(hashesOf(next));
+  const prevHashes = new Set(hashesOf(prev));
+  if (next.every((entry) => entry.hash && prevHashes.has(entry.hash))) {
+    const ops: LogbookOp[] = [];
+    const removed = hashesOf(prev).filter((h) => !nextHashes.has(h));
+    if (removed.length > 0) ops.push({ op: "remove", id, hashes: removed });
+    const kept = prev.filter((entry) => entry.hash && nextHashes.has(entry.hash));
+    if (loaded && kept.some((entry, i) => entry !== next[i])) {
+      ops.push({ op: "order", id, hashes: hashesOf(next) });
+    }
+    return ops;
+  }
+
+  if (loaded) return [{ op: "replace", id, entries: next }];
+  const added = next.filter((entry) => entry.hash && !prevHashes.has(entry.hash));
+  return added.length > 0 ? [{ op: "add", id, entries: added }] : [];
+}
+
+/**
+ * Operations for everything that changed since the last write
+ */
+function takeChanges(stories: Story[]): LogbookOp[] {
+  const ops: LogbookOp[] = [];
+  const ids = new Set(stories.map((s) => s.id));
+  persisted.forEach((_, id) => {
+    if (!ids.has(id)) unsaved.add(id);
+  });
+  unsaved.forEach((id) => {
+    if (!ids.has(id)) ops.push({ op: "delete", id });
+  });
+
+  for (const story of stories) {
+    const prev = unsaved.has(story.id) ? undefined : persisted.get(story.id);
+    if (prev === story) continue;
+    const loaded = story.storedHashes === undefined;
+    if (!prev || !sameMeta(prev, story)) ops.push({ op: "putMeta", meta: metaOf(story) });
+    if (!prev && loaded) {
+      // New (or not reliably written) - write it whole
+      ops.push({ op: "replace", id: story.id, entries: story.entries });
+    } else {
+      ops.push(...entryOps(story.id, prev?.entries ?? [], story.entries, loaded));
+    }
+  }
+
+  persisted = new Map(stories.map((s) => [s.id, s]));
+  unsaved.clear();
+  return ops;
+}
+
+function scheduleFlush(): void {
+  if (flushTimer === null) flushTimer = setTimeout(() => void flushLogbooks(), FLUSH_DELAY_MS);
+}
+
+/**
+ * Write pending logbook changes now. Writes are queued, so they reach the
+ * backend in order; resolves once this one is done.
+ */
+export function flushLogbooks(): Promise<void> {
+  if (flushTimer !== null) {
+    clearTimeout(flushTimer);
+    flushTimer = null;
+  }
+  if (!started) return writing;
+
+  const ops = takeChanges(useStoryStore.getState().stories);
+  if (ops.length === 0) return writing;
+
+  writing = writing.then(async () => {
+    if (await writeLogbooks(ops)) return;
+    // Unknown what these stories look like on disk now - the next write
+    // sends them whole
+    for (const op of ops) unsaved.add(op.op === "putMeta" ? op.meta.id : op.id);
+    scheduleFlush();
+  });
+  return writing;
+}
+
+/**
+ * Load a stored logbook's entries (no-op once loaded). Entries captured
+ * while it was unloaded are kept after the stored ones.
+ */
+export function loadStoryEntries(id: string): Promise<void> {
+  const story = useStoryStore.getState().stories.find((s) => s.id === id);
+  if (!story || story.storedHashes === undefined) return Promise.resolve();
+
+  let promise = loading.get(id);
+  if (!promise) {
+    promise = (async () => {
+      // Write captured entries first, so the stored list is complete
+      await flushLogbooks();
+      const entries = await loadLogbookEntries(id);
+      loading.delete(id);
+      if (!entries) return;
+
+      const { stories } = useStoryStore.getState();
+      const current = stories.find((s) => s.id === id);
+      if (!current || current.storedHashes === undefined) return;
+      const stored = new Set(hashesOf(entries));
+      const loadedStory: Story = {
+        ...current,
+        entries: [...entries, ...current.entries.filter((e) => !e.hash || !stored.has(e.hash))],
+        storedHashes: undefined,
+      };
+      // On disk: the stored entries (anything after them is written next)
+      persisted.set(id, { ...loadedStory, entries });
+      useStoryStore.setState({
+        stories: stories.map((s) => (s.id === id ? loadedStory : s)),
+      });
+    })();
+    loading.set(id, promise);
+  }
+  return promise;
+}
+
+/**
+ * Load stored logbooks and keep them written as they change (Tauri only;
+ * browser mode keeps them in localStorage)
+ */
+export async function initLogbookStore(): Promise<void> {
+  if (!isTauri() || started) return;
+
+  const result = await loadLogbooks();
+  if (!result.success) {
+    // Leave localStorage in charge rather than overwrite what's on disk
+    console.error("Cannot load logbooks:", result.error);
+    return;
+  }
+
+  const state = useStoryStore.getState();
+  if (result.initialized) {
+    const stored = (result.logbooks ?? []).map(storyFromSummary);
+    persisted = new Map(stored.map((s) => [s.id, s]));
+    // Stories created before the store was loaded are new - keep them
+    const storedIds = new Set(stored.map((s) => s.id));
+    const stories = [...stored, ...state.stories.filter((s) => !storedIds.has(s.id))];
+    const activeStoryId = stories.some((s) => s.id === state.activeStoryId)
+      ? state.activeStoryId
+      : stories[0]?.id || null;
+    useStoryStore.setState({ stories, activeStoryId });
+  } else {
+    // First run: the logbooks in memory came from localStorage
+    persisted = new Map();
+  }
+
+  started = true;
+  await flushLogbooks();
+
+  // Logbooks are on disk now - localStorage keeps just the active one
+  useStoryStore.persist.setOptions({
+    partialize: (s) => ({ activeStoryId: s.activeStoryId }),
+  });
+
+  useStoryStore.subscribe((next, prev) => {
+    if (next.stories !== prev.stories) scheduleFlush();
+    if (next.activeStoryId && next.activeStoryId !== prev.activeStoryId) {
+      void loadStoryEntries(next.activeStoryId);
+    }
+  });
+  window.addEventListener("beforeunload", () => void flushLogbooks());
+
+  const { activeStoryId } = useStoryStore.getState();
+  if (activeStoryId) void loadStoryEntries(activeStoryId);
+
+  // Files restored before the logbooks loaded weren't captured yet
+  const { addLogsToMatchingStories } = useStoryStore.getState();
+  useFileStore.getState().openedFiles.forEach((file) => addLogsToMatchingStories(file.logs));
+}
@@ -1,5 +1,17 @@
 import { createRoot } from 'react-dom/client'
 import './index.css'
 import App from './App.tsx'
+import { getTextIndexStats } from './store'
+import { initLogbookStore } from './logbookStore'
+
+// Dev tools: check token index memory from the console
+if (import.meta.env.DEV) {
+  Object.assign(window, {
+    mochaTextIndexStats: getTextIndexStats,
+  })
+}
+
+// Logbooks live on disk in Tauri - load them alongside the first render
+void initLogbookStore()
 
 createRoot(document.getElementById('root')!).render(<App />)
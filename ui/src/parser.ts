@@ -12,6 +12,7 @@ import type {
   LogLevel,
   ApiCallInfo,
   ParsedLogFileResult,
+  PatternStats,
   LogToken,
   TokenType,
   TokenizeResult,
@@ -24,6 +25,12 @@ import type {
 interface LogPattern {
   name: string;
   parse: (line: string) => ParsedLogLine | null;
+  /**
+   * Indices of earlier patterns that can also match lines of this format.
+   * When this pattern is tried first (format affinity) these must miss before
+   * its result is used, so affinity never changes which pattern wins.
+   */
+  shadowedBy?: number[];
 }
 
 // ============================================================================
@@ -228,6 +235,8 @@ const patterns: LogPattern[] = [
   // 5. Maven Format (multiple patterns)
   {
     name: "maven",
+    // Shadowed by iwf-spring: "[INFO] ERROR x [A.java:1] [] - ..."
+    shadowedBy: [2],
     parse: (line: string): ParsedLogLine | null => {
       // [INFO] --- mn:3.5.4:run (default-cli) @ salesboxai-platform ---
       let match = line.match(
@@ -288,6 +297,8 @@ const patterns: LogPattern[] = [
   // 2025-12-18 05:32:18.541 [INFO] message
   {
     name: "bracketed",
+    // Shadowed by logback-with-source: thread named like a level, "... [INFO] WARN x [A.java:1] [] - ..."
+    shadowedBy: [3],
     parse: (line: string): ParsedLogLine | null => {
       const match = line.match(
         /^(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}(?:[,.]\d+)?)\s*\[(ERROR|WARN|WARNING|INFO|DEBUG|TRACE)\]\s*(.*)$/i,
@@ -326,6 +337,8 @@ const patterns: LogPattern[] = [
   // Note: spacing after level can vary (single or multiple spaces)
   {
     name: "logback-with-thread",
+    // Shadowed by bracketed: thread named like a level, "... [INFO] WARN x - ..."
+    shadowedBy: [7],
     parse: (line: string): ParsedLogLine | null => {
       // Handle multi-line content: only match the first line for the pattern
       // The rest will be part of the content
@@ -363,6 +376,8 @@ const patterns: LogPattern[] = [
   // NOTE: This is a catch-all format and should remain near the end
   {
     name: "simple",
+    // Shadowed by any "date time ..." format above
+    shadowedBy: [1, 3, 6, 7, 8, 9],
     parse: (line: string): ParsedLogLine | null => {
       // With level: 2025-12-18 05:32:18.541 INFO message
       let match = line.match(
@@ -413,6 +428,8 @@ const patterns: LogPattern[] = [
   // 12. Level Only (multiple patterns)
   {
     name: "level-only",
+    // Shadowed by iwf-spring and maven both start with a bracketed level/context
+    shadowedBy: [2, 5],
     parse: (line: string): ParsedLogLine | null => {
       // [INFO] message
       let match = line.match(
@@ -507,6 +524,8 @@ const patterns: LogPattern[] = [
   // 2025-12-19T09:53:52.155Z at okio.SocketAsyncTimeout.newTimeoutException(JvmOkio.kt:147)
   {
     name: "iso-timestamp",
+    // Shadowed by salesbox-core also starts with an ISO timestamp
+    shadowedBy: [0],
     parse: (line: string): ParsedLogLine | null => {
       const match = line.match(
         /^(\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}[.,]\d+Z?)\s+(.+)$/,
@@ -694,24 +713,107 @@ export function parseApiCall(content: string): ApiCallInfo | undefined {
   return undefined;
 }
 
+// ============================================================================
+// Pattern Statistics & Format Affinity
+// ============================================================================
+
+// Lines used to detect a file's dominant format
+const AFFINITY_SAMPLE_LINES = 100;
+
+// How often each pattern was tried and matched/missed (since startup)
+const patternHits = new Array<number>(patterns.length).fill(0);
+const patternMisses = new Array<number>(patterns.length).fill(0);
+
+// Dominant pattern index per file (keyed like hashes: file path or name)
+const formatCache = new Map<string, number>();
+
+/**
+ * Snapshot of the per-pattern hit/miss counters (misses are the cost of a format)
+ */
+export function getPatternStats(): PatternStats[] {
+  return patterns.map((pattern, i) => ({
+    name: pattern.name,
+    hits: patternHits[i],
+    misses: patternMisses[i],
+  }));
+}
+
+/**
+ * Run a single pattern and record the outcome
+ */
+function tryPattern(index: number, line: string): ParsedLogLine | null {
+  const result = patterns[index].parse(line);
+  if (result) {
+    patternHits[index]++;
+  } else {
+    patternMisses[index]++;
+  }
+  return result;
+}
+
+/**
+ * Find the first matching pattern, trying the affinity pattern first
+ */
+function matchPatterns(
+  line: string,
+  affinity?: number,
+): { index: number; result: ParsedLogLine } | null {
+  if (affinity !== undefined) {
+    const result = tryPattern(affinity, line);
+    if (
+      result &&
+      (patterns[affinity].shadowedBy ?? []).every(
+        (j) => tryPattern(j, line) === null,
+      )
+    ) {
+      return { index: affinity, result };
+    }
+  }
+
+  // Full scan in pattern order (the affinity pattern already missed or was shadowed)
+  for (let i = 0; i < patterns.length; i++) {
+    if (i === affinity) continue;
+    const result = tryPattern(i, line);
+    if (result) return { index: i, result };
+  }
+  return null;
+}
+
+/**
+ * Pick the pattern that matched most sample lines, if it matched at least half
+ */
+function dominantPattern(wins: number[], sampled: number): number | undefined {
+  let best = 0;
+  for (let i = 1; i < wins.length; i++) {
+    if (wins[i] > wins[best]) best = i;
+  }
+  return wins[best] > 0 && wins[best] * 2 >= sampled ? best : undefined;
+}
+
 // ============================================================================
 // Main Parsing Functions
 // ============================================================================
 
 /**
  * Parse a single log line using all patterns
+ * @param affinity - Index of the file's dominant pattern, tried first
+ * @param onMatch - Receives the index of the pattern that matched
  */
-export function parseLogLine(data: string): ParsedLogLine {
+export function parseLogLine(
+  data: string,
+  affinity?: number,
+  onMatch?: (index: number) => void,
+): ParsedLogLine {
   // Strip trailing whitespace including \r (Windows line endings)
   const cleanData = data.replace(/\s+$/, "");
 
-  for (const pattern of patterns) {
-    const result = pattern.parse(cleanData);
-    if (result) {
-      // Try to detect API call info
-      result.apiCall = parseApiCall(result.content);
-      return result;
-    }
+  const match = matchPatterns(cleanData, affinity);
+  if (match) {
+    onMatch?.(match.index);
+    const result = match.result;
+    // Try to detect API call info
+    result.apiCall = parseApiCall(result.content);
+    return result;
   }
   // Fallback: return raw content
   // Debug unparsed lines
@@ -740,16 +842,27 @@ export function parseLogLine(data: string): ParsedLogLine {
  */
 export function normalize(logs: LogEntry[]): LogEntry[] {
   const result: LogEntry[] = [];
+  // Lines of the last entry, joined once it is complete (appending to
+  // prev.data line by line copies long stack traces over and over)
+  let parts: string[] = [];
+
+  const flush = () => {
+    if (parts.length > 1) {
+      result[result.length - 1].data = parts.join("\n");
+    }
+  };
 
   for (const log of logs) {
     if (isContinuationLine(log.data) && result.length > 0) {
       // Merge with previous log
-      const prev = result[result.length - 1];
-      prev.data = prev.data + "\n" + log.data;
+      parts.push(log.data);
     } else {
+      flush();
       result.push({ ...log });
+      parts = [log.data];
     }
   }
+  flush();
 
   return result;
 }
@@ -966,15 +1079,32 @@ export function parseTimestampToEpoch(timestamp: string): number | null {
 }
 
 /**
- * Recalculate timestamp and sortIndex for an array of log entries.
- * Handles backfilling when first real timestamp is found.
- * Mutates the input array in place.
+ * Running state of the timestamp pass, so logs appended later continue
+ * exactly where the previous batch stopped
  */
-export function recalculateTimestamps(logs: LogEntry[]): void {
-  let lastTimestamp = 0;
-  let lastSortIndex = 0;
-  let firstRealTimestamp: number | null = null;
+export interface TimestampClock {
+  lastTimestamp: number;
+  lastSortIndex: number;
+  firstRealTimestamp: number | null;
+  count: number; // Logs processed so far
+}
 
+export function createTimestampClock(): TimestampClock {
+  return { lastTimestamp: 0, lastSortIndex: 0, firstRealTimestamp: null, count: 0 };
+}
+
+/**
+ * Assign timestamp and sortIndex to the next batch of logs, continuing from clock.
+ * When the first real timestamp appears, earlier logs of the batch are backfilled;
+ * logs of earlier batches are left to `onFirstReal` (called with the timestamp and
+ * the overall index of the log that carries it).
+ * Mutates the input array and clock in place.
+ */
+export function advanceTimestamps(
+  clock: TimestampClock,
+  logs: LogEntry[],
+  onFirstReal?: (timestamp: number, index: number) => void,
+): void {
   for (let i = 0; i < logs.length; i++) {
     const log = logs[i];
     const parsed = log.parsed;
@@ -990,27 +1120,38 @@ export function recalculateTimestamps(logs: LogEntry[]): void {
     if (hasRealTimestamp) {
       log.timestamp = parsedEpoch;
       log.sortIndex = 0;
-      lastSortIndex = 0;
+      clock.lastSortIndex = 0;
 
-      if (firstRealTimestamp === null) {
-        firstRealTimestamp = parsedEpoch;
+      if (clock.firstRealTimestamp === null) {
+        clock.firstRealTimestamp = parsedEpoch;
         for (let j = 0; j < i; j++) {
-          logs[j].timestamp = firstRealTimestamp;
+          logs[j].timestamp = parsedEpoch;
           logs[j].sortIndex = j - i;
         }
+        onFirstReal?.(parsedEpoch, clock.count + i);
       }
     } else {
-      lastSortIndex++;
-      log.sortIndex = lastSortIndex;
+      clock.lastSortIndex++;
+      log.sortIndex = clock.lastSortIndex;
 
-      if (firstRealTimestamp !== null) {
-        log.timestamp = lastTimestamp;
+      if (clock.firstRealTimestamp !== null) {
+        log.timestamp = clock.lastTimestamp;
       } else {
         log.timestamp = 0;
       }
     }
-    lastTimestamp = log.timestamp || lastTimestamp;
+    clock.lastTimestamp = log.timestamp || clock.lastTimestamp;
   }
+  clock.count += logs.length;
+}
+
+/**
+ * Recalculate timestamp and sortIndex for an array of log entries.
+ * Handles backfilling when first real timestamp is found.
+ * Mutates the input array in place.
+ */
+export function recalculateTimestamps(logs: LogEntry[]): void {
+  advanceTimestamps(createTimestampClock(), logs);
 }
 
 /**
@@ -1033,11 +1174,41 @@ export function parseLogFile(
   } = parseFileLines(content, fileName, hashKey, filePath);
   const normalized = normalize(rawLogs);
 
+  // Format affinity: reuse the dominant pattern detected for this file,
+  // or detect it from the first lines
+  const cached = formatCache.get(hashKey);
+  let affinity = cached;
+  const wins = new Array<number>(patterns.length).fill(0);
+  let sampled = 0;
+  let affinityHits = 0;
+  let affinityMisses = 0;
+
   // Parse each log line to extract structured data
-  const logs: LogEntry[] = normalized.map((log) => ({
-    ...log,
-    parsed: parseLogLine(log.data),
-  }));
+  const logs: LogEntry[] = normalized.map((log) => {
+    let matched: number | undefined;
+    const parsed = parseLogLine(log.data, affinity, (i) => (matched = i));
+
+    if (affinity !== undefined) {
+      if (matched === affinity) affinityHits++;
+      else affinityMisses++;
+    } else {
+      if (matched !== undefined) wins[matched]++;
+      sampled++;
+      if (sampled === AFFINITY_SAMPLE_LINES) {
+        affinity = dominantPattern(wins, sampled);
+      }
+    }
+
+    return { ...log, parsed };
+  });
+
+  // Remember the detected format; forget it if the file stopped matching
+  // (e.g. it was replaced by a different log)
+  if (affinityMisses > affinityHits) {
+    formatCache.delete(hashKey);
+  } else if (affinity !== undefined && cached !== affinity) {
+    formatCache.set(hashKey, affinity);
+  }
 
   // Calculate timestamp and sortIndex for all logs
   recalculateTimestamps(logs);
@@ -1226,3 +1397,30 @@ export function tokenizeContent(content: string): TokenizeResult {
 
   return { tokens };
 }
+
+// Tokenized content is cached so rows scrolled back into view (and the same
+// entry shown in the log stream and the logbook) aren't tokenized again.
+// Bounded LRU: a Map iterates in insertion order, so the first key is the
+// least recently used.
+const TOKEN_CACHE_SIZE = 5000;
+const tokenCache = new Map<string, TokenizeResult>();
+
+/**
+ * Cached tokenizeContent. The result is shared - don't mutate it.
+ */
+export function getContentTokens(content: string): TokenizeResult {
+  const cached = tokenCache.get(content);
+  if (cached) {
+    // Refresh: move to the most recently used end
+    tokenCache.delete(content);
+    tokenCache.set(content, cached);
+    return cached;
+  }
+
+  const result = tokenizeContent(content);
+  tokenCache.set(content, result);
+  if (tokenCache.size > TOKEN_CACHE_SIZE) {
+    tokenCache.delete(tokenCache.keys().next().value as string);
+  }
+  return result;
+}
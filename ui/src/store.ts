@@ -10,37 +10,29 @@ import { persist, createJSONStorage } from "zustand/middleware";
 import type {
   LogViewerState,
   StoryState,
+  FileChange,
   FileState,
   ParsedFilter,
   RecentFile,
   LogEntry,
   OpenedFileWithLogs,
+  NewOpenedFile,
   Story,
   SettingsState,
   ThemeName,
 } from "./types";
-import { recalculateTimestamps } from "./parser";
-
-/**
- * Get short service name from log entry.
- * For structured logs, extracts the last part of the logger name.
- * For unstructured logs, returns the filename as-is to indicate parsing failed.
- * Duplicated from LogLine.tsx to avoid circular imports.
- */
-function getServiceName(log: LogEntry): string {
-  if (log.parsed?.logger) {
-    let logger = log.parsed.logger;
-    // Strip [File.java:123] suffix if present
-    logger = logger.replace(/\s*\[[^\]]+\.java:\d+\]$/, "");
-    const withoutLineNum = logger.split(":")[0];
-    const parts = withoutLineNum.split(".");
-    return parts[parts.length - 1] || withoutLineNum;
-  }
-
-  // For unstructured lines, use filename as-is
-  // This clearly indicates we couldn't parse the line
-  return log.name;
-}
+import { LogBuffer, DEFAULT_MAX_LOGS_PER_FILE, type LogList } from "./logBuffer";
+import type { TokenIndex, TokenIndexStats } from "./tokenIndex";
+import { CaptureMatcher, captureMatcherFor } from "./autoCapture";
+
+// Filtering lives in filters.ts (also used by the log worker)
+export {
+  compileFilters,
+  matchesFilterPlan,
+  filterLogs,
+  setListTextIndex,
+  type FilterPlan,
+} from "./filters";
 
 // ============================================================================
 // Custom Storage for Set serialization
@@ -200,17 +192,46 @@ function generateStoryId(): string {
 }
 
 /**
- * Get all currently loaded logs from the file store.
- * Used to scan existing logs when patterns change.
+ * Capture already-loaded logs into one story that matches the given
+ * patterns. Walks each file's logs in place (no combined copy).
  * Lazily accesses useFileStore to avoid circular init issues.
  */
-function getAllLoadedLogs(): LogEntry[] {
-  const fileState = useFileStore.getState();
-  const allLogs: LogEntry[] = [];
-  fileState.openedFiles.forEach((file) => {
-    allLogs.push(...file.logs);
+function captureLoadedLogs(storyId: string, patterns: ParsedFilter[]): void {
+  const matcher = new CaptureMatcher([patterns]);
+  if (matcher.isEmpty) return;
+  const matches: LogEntry[] = [];
+  useFileStore.getState().openedFiles.forEach((file) => {
+    for (const log of file.logs) {
+      if (log.hash && matcher.matchingStories(log).length > 0) matches.push(log);
+    }
   });
-  return allLogs;
+  useStoryStore.getState().addLogsToStory(matches, storyId);
+}
+
+/**
+ * Hashes of a story's entries, including ones still on disk
+ * (see logbookStore.ts)
+ */
+export function storyHashes(story: Story): Set<string | undefined> {
+  const hashes = new Set<string | undefined>(story.storedHashes);
+  for (const entry of story.entries) {
+    if (entry.hash) hashes.add(entry.hash);
+  }
+  return hashes;
+}
+
+/**
+ * Number of entries in a story, including ones still on disk
+ */
+export function storyEntryCount(story: Story): number {
+  return story.entries.length + (story.storedHashes?.length ?? 0);
+}
+
+/**
+ * Check if two patterns are the same filter
+ */
+function samePattern(a: ParsedFilter, b: ParsedFilter): boolean {
+  return a.type === b.type && a.value === b.value;
 }
 
 /**
@@ -222,7 +243,8 @@ function getAllLoadedLogs(): LogEntry[] {
  * - Log management within active story
  * - Drag-to-reorder support
  *
- * All state is persisted to localStorage.
+ * Persisted to localStorage in the browser; in Tauri, to ~/.mocha/logbooks
+ * (see logbookStore.ts).
  */
 export const useStoryStore = create<StoryState>()(
   persist(
@@ -264,12 +286,7 @@ export const useStoryStore = create<StoryState>()(
 
         // If patterns were provided, scan already-loaded logs for matches
         if (patterns && patterns.length > 0) {
-          setTimeout(() => {
-            const allLogs = getAllLoadedLogs();
-            if (allLogs.length > 0) {
-              get().addLogsToMatchingStories(allLogs);
-            }
-          }, 0);
+          setTimeout(() => captureLoadedLogs(id, patterns), 0);
         }
 
         return id;
@@ -299,20 +316,18 @@ export const useStoryStore = create<StoryState>()(
       // Pattern management
       setStoryPatterns: (id: string, patterns: ParsedFilter[]) => {
         const { stories } = get();
+        const previous = stories.find((s) => s.id === id)?.patterns || [];
         set({
           stories: stories.map((s) =>
             s.id === id ? { ...s, patterns } : s,
           ),
         });
 
-        // Scan already-loaded logs for matches against updated patterns
-        if (patterns.length > 0) {
-          setTimeout(() => {
-            const allLogs = getAllLoadedLogs();
-            if (allLogs.length > 0) {
-              get().addLogsToMatchingStories(allLogs);
-            }
-          }, 0);
+        // Scan already-loaded logs for matches against the added patterns
+        // (logs matching the kept ones were captured already)
+        const added = patterns.filter((p) => !previous.some((old) => samePattern(old, p)));
+        if (added.length > 0) {
+          setTimeout(() => captureLoadedLogs(id, added), 0);
         }
       },
 
@@ -335,7 +350,7 @@ export const useStoryStore = create<StoryState>()(
           stories: currentStories.map((s) => {
             if (s.id !== targetId) return s;
             // Check if already in story by hash
-            if (s.entries.some((e) => e.hash === log.hash)) return s;
+            if (storyHashes(s).has(log.hash)) return s;
             return {
               ...s,
               entries: [...s.entries, log],
@@ -345,39 +360,40 @@ export const useStoryStore = create<StoryState>()(
         });
       },
 
-      // Auto-capture: check new logs against all stories' patterns
-      addLogsToMatchingStories: (logs: LogEntry[]) => {
-        if (logs.length === 0) return;
+      // Auto-capture: match each new log once against all stories' patterns
+      addLogsToMatchingStories: (logs: Iterable<LogEntry>) => {
         const { stories } = get();
+        const matcher = captureMatcherFor(stories);
+        if (matcher.isEmpty) return;
+
+        const captured = new Map<number, LogEntry[]>();
+        for (const log of logs) {
+          if (!log.hash) continue;
+          for (const index of matcher.matchingStories(log)) {
+            const matches = captured.get(index);
+            if (matches) matches.push(log);
+            else captured.set(index, [log]);
+          }
+        }
+        if (captured.size === 0) return;
 
         let anyUpdated = false;
-        const updatedStories = stories.map((story) => {
-          // Skip if no patterns
-          if (!story.patterns || story.patterns.length === 0) return story;
-
-          const existingHashes = new Set(
-            story.entries.map((e) => e.hash).filter(Boolean),
-          );
-
-          // Only include text and regex patterns (no exclude)
-          const includePatterns = story.patterns.filter(
-            (p) => p.type === "text" || p.type === "regex",
-          );
-          if (includePatterns.length === 0) return story;
-
-          const matchingLogs = logs.filter((log) => {
-            if (!log.hash || existingHashes.has(log.hash)) return false;
-            return includePatterns.some((pattern) =>
-              matchesFilter(log, pattern),
-            );
+        const updatedStories = stories.map((story, index) => {
+          const matches = captured.get(index);
+          if (!matches) return story;
+
+          const existingHashes = storyHashes(story);
+          const newLogs = matches.filter((log) => {
+            if (existingHashes.has(log.hash)) return false;
+            existingHashes.add(log.hash);
+            return true;
           });
-
-          if (matchingLogs.length === 0) return story;
+          if (newLogs.length === 0) return story;
 
           anyUpdated = true;
           return {
             ...story,
-            entries: [...story.entries, ...matchingLogs],
+            entries: [...story.entries, ...newLogs],
           };
         });
 
@@ -395,9 +411,7 @@ export const useStoryStore = create<StoryState>()(
         const targetStory = stories.find((s) => s.id === storyId);
         if (!targetStory) return;
 
-        const existingHashes = new Set(
-          targetStory.entries.map((e) => e.hash).filter(Boolean),
-        );
+        const existingHashes = storyHashes(targetStory);
 
         // Filter out logs that are already in the story or don't have hashes
         const newLogs = logs.filter(
@@ -482,7 +496,7 @@ export const useStoryStore = create<StoryState>()(
 
         // Check if already exists in target
         const targetStory = stories.find((s) => s.id === toStoryId);
-        if (targetStory?.entries.some((e) => e.hash === hash)) return;
+        if (targetStory && storyHashes(targetStory).has(hash)) return;
 
         set({
           stories: stories.map((s) => {
@@ -529,7 +543,7 @@ export const useStoryStore = create<StoryState>()(
         const activeStory = stories.find((s) => s.id === activeStoryId);
         if (!activeStory) return;
 
-        if (activeStory.entries.some((e) => e.hash === log.hash)) {
+        if (storyHashes(activeStory).has(log.hash)) {
           removeFromStory(log.hash);
         } else {
           addToStory(log);
@@ -574,16 +588,18 @@ export const useStoryStore = create<StoryState>()(
         const activeStory = stories.find((s) => s.id === activeStoryId);
         if (!activeStory) return [];
         const minimized = new Set(activeStory.minimizedHashes || []);
-        return activeStory.entries
-          .map((e) => e.hash)
-          .filter((h): h is string => !!h && !minimized.has(h));
+        return Array.from(storyHashes(activeStory)).filter(
+          (h): h is string => !!h && !minimized.has(h),
+        );
       },
     }),
     {
       name: "mocha-stories",
       storage: createJSONStorage(() => localStorage),
       // Don't persist mainViewMode - always start with 'logs'
-      partialize: (state) => ({
+      // In Tauri, stories move to ~/.mocha/logbooks once that store is
+      // loaded (logbookStore.ts narrows this to activeStoryId)
+      partialize: (state): Partial<StoryState> => ({
         stories: state.stories,
         activeStoryId: state.activeStoryId,
       }),
@@ -605,6 +621,7 @@ export const useStoryStore = create<StoryState>()(
  *
  * Features:
  * - openedFiles: Map of path -> OpenedFileWithLogs for loaded files
+ * - sources: Open directory/glob sources (their files are opened with `source` set)
  * - recentFiles: Array of recently opened files
  * - isLoading: Loading indicator
  * - error: Error message from file operations
@@ -627,6 +644,7 @@ const mergeFileState = (
   const persisted = persistedState as Partial<{
     recentFiles: RecentFile[];
     openedFilePaths?: string[];
+    sources?: string[];
   }>;
 
   const merged: FileState = { ...currentState };
@@ -642,6 +660,11 @@ const mergeFileState = (
     merged.recentFiles = deduplicated;
   }
 
+  // Sources are reopened (and their files listed again) in App.tsx on mount
+  if (persisted?.sources && Array.isArray(persisted.sources)) {
+    merged.sources = persisted.sources;
+  }
+
   // Store opened file paths for restoration (openedFiles Map starts empty)
   // The actual files will be loaded in App.tsx on mount
   if (persisted?.openedFilePaths && Array.isArray(persisted.openedFilePaths)) {
@@ -653,11 +676,64 @@ const mergeFileState = (
   return merged;
 };
 
+/**
+ * Buffers behind each file's logs, keyed by the log list they produced.
+ * A file whose logs were replaced (open/reload) gets a new buffer.
+ */
+const logBuffers = new WeakMap<LogList, LogBuffer>();
+
+/**
+ * Logs of a file as stored: new arrays are moved into a new buffer
+ */
+function bufferedLogs(logs: LogEntry[]): LogList {
+  const { maxLogsPerFile, indexLogText } = useSettingsStore.getState();
+  const buffer = LogBuffer.from(logs, maxLogsPerFile, indexLogText);
+  logBuffers.set(buffer.logs, buffer);
+  return buffer.logs;
+}
+
+function getLogBuffer(file: OpenedFileWithLogs): LogBuffer {
+  const { maxLogsPerFile, indexLogText } = useSettingsStore.getState();
+  let buffer = logBuffers.get(file.logs);
+  if (buffer) {
+    buffer.setCapacity(maxLogsPerFile);
+  } else {
+    buffer = LogBuffer.from(file.logs.slice(), maxLogsPerFile, indexLogText);
+  }
+  return buffer;
+}
+
+/**
+ * Token index of a file's stored logs (null if the file isn't indexed)
+ */
+export function getTextIndex(logs: LogList): TokenIndex | null {
+  return logBuffers.get(logs)?.textIndex ?? null;
+}
+
+/**
+ * Memory used by the token indexes of the open files
+ */
+export function getTextIndexStats(): TokenIndexStats & { files: number } {
+  const total = { files: 0, rows: 0, tokens: 0, postings: 0, bytes: 0, overBudget: false };
+  useFileStore.getState().openedFiles.forEach((file) => {
+    const stats = getTextIndex(file.logs)?.stats();
+    if (!stats) return;
+    total.files++;
+    total.rows += stats.rows;
+    total.tokens += stats.tokens;
+    total.postings += stats.postings;
+    total.bytes += stats.bytes;
+    total.overBudget ||= stats.overBudget;
+  });
+  return total;
+}
+
 export const useFileStore = create<FileState>()(
   persist(
     (set, get) => ({
       // State
       openedFiles: new Map<string, OpenedFileWithLogs>(),
+      sources: [],
       recentFiles: [],
       isLoading: false,
       error: null,
@@ -668,10 +744,10 @@ export const useFileStore = create<FileState>()(
        * Open a file (add to map or update if exists).
        * All opened files are shown in the merged view.
        */
-      openFile: (file: OpenedFileWithLogs) => {
+      openFile: (file: NewOpenedFile) => {
         const { openedFiles } = get();
         const newMap = new Map(openedFiles);
-        newMap.set(file.path, file);
+        newMap.set(file.path, { ...file, logs: bufferedLogs(file.logs) });
         set({ openedFiles: newMap, error: null });
       },
 
@@ -691,53 +767,72 @@ export const useFileStore = create<FileState>()(
        * Replace all logs for a file (used for reload).
        */
       updateFileLogs: (path: string, logs: LogEntry[]) => {
-        const { openedFiles } = get();
-        const file = openedFiles.get(path);
-        if (!file) return;
-
-        const newMap = new Map(openedFiles);
-        newMap.set(path, { ...file, logs });
-        set({ openedFiles: newMap });
+        get().applyFileChanges([{ path, logs, replace: true }]);
       },
 
       /**
        * Append new logs to a file (used for polling/watching).
-       * Recalculates timestamps after merging to ensure correct ordering.
-       * Caps total logs to prevent memory exhaustion during long sessions.
+       * Only the new logs get timestamps (continuing from the previous ones);
+       * the file's buffer drops the oldest logs beyond the per-file cap.
        * @param newSize - The actual new file size in bytes (for next poll offset)
        */
       appendFileLogs: (path: string, newLogs: LogEntry[], newSize?: number) => {
+        get().applyFileChanges([{ path, logs: newLogs, lastModified: newSize }]);
+      },
+
+      /**
+       * Apply the changes of several files (appends and reloads) as one
+       * store update, so subscribers re-render once per batch instead of
+       * once per file. Changes are applied in order.
+       */
+      applyFileChanges: (changes: FileChange[]) => {
         const { openedFiles } = get();
-        const file = openedFiles.get(path);
-        if (!file) return;
+        let newMap: Map<string, OpenedFileWithLogs> | null = null;
 
-        // Merge existing logs with new logs
-        let mergedLogs = [...file.logs, ...newLogs];
-
-        // Recalculate timestamps for the entire merged array
-        // This ensures backfill works correctly if first timestamp appears in polled content
-        recalculateTimestamps(mergedLogs);
-
-        // Cap logs to prevent memory exhaustion
-        // Trim when exceeding 50k, down to 30k (20k headroom avoids trimming every poll)
-        const MAX_LOGS = 30_000;
-        const TRIM_THRESHOLD = 50_000;
-        if (mergedLogs.length > TRIM_THRESHOLD) {
-          // Sort by timestamp desc (newest first), then trim to MAX_LOGS
-          mergedLogs.sort((a, b) => {
-            const timestampDiff = (b.timestamp ?? 0) - (a.timestamp ?? 0);
-            if (timestampDiff !== 0) return timestampDiff;
-            return (b.sortIndex ?? 0) - (a.sortIndex ?? 0);
+        for (const change of changes) {
+          const file = (newMap ?? openedFiles).get(change.path);
+          if (!file) continue;
+
+          let logs: LogList;
+          if (change.replace) {
+            logs = bufferedLogs(change.logs);
+          } else {
+            const buffer = getLogBuffer(file);
+            buffer.append(change.logs);
+            logBuffers.set(buffer.logs, buffer);
+            logs = buffer.logs;
+          }
+
+          if (!newMap) newMap = new Map(openedFiles);
+          newMap.set(change.path, {
+            ...file,
+            logs,
+            lastModified: change.lastModified ?? file.lastModified, // Use actual file size for next poll
+            mtime: change.mtime ?? file.mtime,
+            firstLine: change.resetFirstLine ? undefined : file.firstLine,
           });
-          mergedLogs = mergedLogs.slice(0, MAX_LOGS);
         }
 
+        if (newMap) set({ openedFiles: newMap });
+      },
+
+      /**
+       * Prepend an older page of logs to a file (used when paging back through large files).
+       * Older pages push the window back; once it exceeds the cap the newest entries
+       * are dropped, so memory follows what the user is reading.
+       * @param firstLine - File line number of the first line of the page
+       */
+      prependFileLogs: (path: string, olderLogs: LogEntry[], firstLine: number) => {
+        const { openedFiles } = get();
+        const file = openedFiles.get(path);
+        if (!file) return;
+
+        const buffer = getLogBuffer(file);
+        buffer.prepend(olderLogs);
+        logBuffers.set(buffer.logs, buffer);
+
         const newMap = new Map(openedFiles);
-        newMap.set(path, {
-          ...file,
-          logs: mergedLogs,
-          lastModified: newSize ?? file.lastModified, // Use actual file size for next poll
-        });
+        newMap.set(path, { ...file, logs: buffer.logs, firstLine });
         set({ openedFiles: newMap });
       },
 
@@ -759,9 +854,30 @@ export const useFileStore = create<FileState>()(
         set({ recentFiles: [file, ...filtered].slice(0, 20) });
       },
 
-      // Clear all opened files (used when clearing recent files)
+      // Clear all opened files and sources (used when clearing recent files)
       clearOpenedFiles: () => {
-        set({ openedFiles: new Map<string, OpenedFileWithLogs>() });
+        set({ openedFiles: new Map<string, OpenedFileWithLogs>(), sources: [] });
+      },
+
+      /**
+       * Add a directory/glob source (its files are opened separately).
+       */
+      addSource: (spec: string) => {
+        const { sources } = get();
+        if (sources.includes(spec)) return;
+        set({ sources: [...sources, spec] });
+      },
+
+      /**
+       * Remove a source and close the files opened from it.
+       */
+      removeSource: (spec: string) => {
+        const { sources, openedFiles } = get();
+        const newMap = new Map<string, OpenedFileWithLogs>();
+        openedFiles.forEach((file, key) => {
+          if (file.source !== spec) newMap.set(key, file);
+        });
+        set({ sources: sources.filter((s) => s !== spec), openedFiles: newMap });
       },
 
       // Remove a single recent file by path (also removes from opened files)
@@ -804,8 +920,12 @@ export const useFileStore = create<FileState>()(
       storage: createJSONStorage(() => localStorage),
       partialize: (state) => ({
         recentFiles: state.recentFiles,
-        // Persist opened file paths (not the full log data)
-        openedFilePaths: Array.from(state.openedFiles.keys()),
+        // Persist opened file paths (not the full log data); files of a
+        // source are listed again when it is reopened
+        openedFilePaths: Array.from(state.openedFiles.values())
+          .filter((file) => !file.source)
+          .map((file) => file.path),
+        sources: state.sources,
       }),
       merge: mergeFileState,
     },
@@ -821,6 +941,9 @@ export const useFileStore = create<FileState>()(
  *
  * Features:
  * - theme: Current theme name ('observatory', 'morning-brew', 'system')
+ * - maxLogsPerFile: Cap of each file's log buffer
+ * - indexLogText: Token index per file so text filters skip the full scan
+ * - loadThreads: Backend threads for opening large files (0 = one per core)
  *
  * All state is persisted to localStorage.
  */
@@ -829,8 +952,16 @@ export const useSettingsStore = create<SettingsState>()(
     (set) => ({
       // Default to system theme (follows OS preference)
       theme: "system" as ThemeName,
+      maxLogsPerFile: DEFAULT_MAX_LOGS_PER_FILE,
+      indexLogText: true,
+      loadThreads: 0,
 
       setTheme: (theme: ThemeName) => set({ theme }),
+      setMaxLogsPerFile: (maxLogsPerFile: number) =>
+        set({ maxLogsPerFile: Math.max(1000, Math.floor(maxLogsPerFile)) }),
+      setIndexLogText: (indexLogText: boolean) => set({ indexLogText }),
+      setLoadThreads: (loadThreads: number) =>
+        set({ loadThreads: Math.max(0, Math.floor(loadThreads)) }),
     }),
     {
       name: "mocha-settings",
@@ -892,85 +1023,3 @@ export function parseFilterInput(input: string): ParsedFilter | null {
     text: trimmed,
   };
 }
-
-// ============================================================================
-// Helper: Apply filters to log entries
-// ============================================================================
-
-/**
- * Check if a log entry matches a single filter.
- */
-function matchesFilter(log: LogEntry, filter: ParsedFilter): boolean {
-  const searchText = log.data.toLowerCase();
-  const content = log.parsed?.content?.toLowerCase() || "";
-
-  switch (filter.type) {
-    case "regex": {
-      try {
-        const regex = new RegExp(filter.value, "i");
-        return (
-          regex.test(log.data) ||
-          (log.parsed?.content ? regex.test(log.parsed.content) : false)
-        );
-      } catch {
-        return false;
-      }
-    }
-    case "text": {
-      const searchValue = filter.value.toLowerCase();
-      return searchText.includes(searchValue) || content.includes(searchValue);
-    }
-    case "exclude": {
-      const searchValue = filter.value.toLowerCase();
-      return !(
-        searchText.includes(searchValue) || content.includes(searchValue)
-      );
-    }
-    default:
-      return true;
-  }
-}
-
-/**
- * Filter log entries based on active filters and service visibility.
- *
- * @param logs - Array of log entries to filter
- * @param filters - Array of active filters
- * @param inactiveNames - Set of hidden service names
- * @returns Filtered array of log entries
- */
-export function filterLogs(
-  logs: LogEntry[],
-  filters: ParsedFilter[],
-  inactiveNames: Set<string>,
-): LogEntry[] {
-  return logs.filter((log) => {
-    // Check if service is visible (using derived service name from logger)
-    const serviceName = getServiceName(log);
-    if (inactiveNames instanceof Set && inactiveNames.has(serviceName)) {
-      return false;
-    }
-
-    // Apply all filters (AND logic for include, all excludes must pass)
-    const includeFilters = filters.filter((f) => f.type !== "exclude");
-    const excludeFilters = filters.filter((f) => f.type === "exclude");
-
-    // All include filters must match (if any)
-    if (includeFilters.length > 0) {
-      const matchesAnyInclude = includeFilters.some((f) =>
-        matchesFilter(log, f),
-      );
-      if (!matchesAnyInclude) return false;
-    }
-
-    // All exclude filters must pass (none should match the exclude pattern)
-    if (excludeFilters.length > 0) {
-      const passesAllExcludes = excludeFilters.every((f) =>
-        matchesFilter(log, f),
-      );
-      if (!passesAllExcludes) return false;
-    }
-
-    return true;
-  });
-}
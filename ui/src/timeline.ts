@@ -0,0 +1,248 @@
+/**
+ * Mocha Log Viewer - Merged Multi-File Timeline
+ *
+ * The logs of all open files as one timeline, oldest first. Each file's logs
+ * are already (nearly) in timestamp order, so instead of sorting everything
+ * the files are merged as sorted runs: a k-way merge is O(n log k) for k
+ * files, and appended logs are merged into the previous timeline (usually
+ * just added at its newest end).
+ *
+ * Timeline order: timestamp, then sortIndex, then file (open order), then
+ * line order within the file - the order a stable sort of all files' logs,
+ * concatenated in open order, would give.
+ */
+
+import type { LogEntry } from "./types";
+import type { LogList } from "./logBuffer";
+
+/**
+ * Compare two logs by timestamp, then sortIndex
+ */
+export function compareTimeline(a: LogEntry, b: LogEntry): number {
+  return (
+    (a.timestamp ?? 0) - (b.timestamp ?? 0) ||
+    (a.sortIndex ?? 0) - (b.sortIndex ?? 0)
+  );
+}
+
+/**
+ * Check if logs are already in timeline order
+ */
+export function isInTimelineOrder(logs: LogEntry[]): boolean {
+  for (let i = 1; i < logs.length; i++) {
+    if (compareTimeline(logs[i - 1], logs[i]) > 0) return false;
+  }
+  return true;
+}
+
+// Sorted copies of out-of-order files, per logs array
+const sortedRuns = new WeakMap<LogEntry[], LogEntry[]>();
+
+/**
+ * A file's logs in timeline order: the array itself when already ordered,
+ * otherwise a (cached) stably sorted copy
+ */
+export function timelineRun(logs: LogEntry[]): LogEntry[] {
+  if (isInTimelineOrder(logs)) return logs;
+  let sorted = sortedRuns.get(logs);
+  if (!sorted) {
+    sorted = logs.slice().sort(compareTimeline);
+    sortedRuns.set(logs, sorted);
+  }
+  return sorted;
+}
+
+/**
+ * Merge sorted runs into one timeline.
+ *
+ * @param runs - Runs in timeline order, one per file (ties go to the earlier run)
+ * @returns Merged logs and the run each came from
+ */
+export function mergeRuns(runs: LogEntry[][]): { logs: LogEntry[]; runOf: Uint32Array } {
+  let total = 0;
+  for (const run of runs) total += run.length;
+  const logs: LogEntry[] = new Array(total);
+  const runOf = new Uint32Array(total);
+
+  // Min-heap of run indices, keyed by each run's next log
+  const cursor = new Array<number>(runs.length).fill(0);
+  const heap: number[] = [];
+  const less = (a: number, b: number) => {
+    const order = compareTimeline(runs[a][cursor[a]], runs[b][cursor[b]]);
+    return order < 0 || (order === 0 && a < b);
+  };
+  const siftDown = (i: number) => {
+    for (;;) {
+      const left = 2 * i + 1;
+      const right = left + 1;
+      let least = i;
+      if (left < heap.length && less(heap[left], heap[least])) least = left;
+      if (right < heap.length && less(heap[right], heap[least])) least = right;
+      if (least === i) return;
+      [heap[i], heap[least]] = [heap[least], heap[i]];
+      i = least;
+    }
+  };
+
+  for (let r = 0; r < runs.length; r++) {
+    if (runs[r].length > 0) heap.push(r);
+  }
+  for (let i = (heap.length >> 1) - 1; i >= 0; i--) siftDown(i);
+
+  for (let out = 0; out < total; out++) {
+    const r = heap[0];
+    logs[out] = runs[r][cursor[r]++];
+    runOf[out] = r;
+    if (cursor[r] === runs[r].length) {
+      heap[0] = heap[heap.length - 1];
+      heap.pop();
+    }
+    if (heap.length > 0) siftDown(0);
+  }
+
+  return { logs, runOf };
+}
+
+/**
+ * Entries evicted from the front and appended at the end between two
+ * lists of a file's logs, or null if it changed some other way
+ */
+function appendedSince(
+  prev: LogList,
+  next: LogList,
+): { evicted: LogEntry[]; added: LogEntry[] } | null {
+  if (!next.continues(prev)) return null;
+  return {
+    evicted: prev.slice(0, next.start - prev.start),
+    added: next.slice(prev.start + prev.length - next.start),
+  };
+}
+
+/**
+ * Incrementally maintained timeline of a list of files
+ */
+export class Timeline {
+  private files: LogList[] = [];
+  // Timestamp of each file's last log at the previous update
+  private lastTimestamps: (number | undefined)[] = [];
+  private merged: LogEntry[] = [];
+  private fileOf: Uint32Array = new Uint32Array(0);
+
+  /**
+   * Timeline for the files' logs (in open order). Returns the previous array
+   * if nothing changed; appends are merged in, anything else rebuilds.
+   */
+  update(files: LogList[]): LogEntry[] {
+    if (files.length !== this.files.length) return this.rebuild(files);
+
+    const evicted = new Set<LogEntry>();
+    const addedRuns: LogEntry[][] = [];
+    let changed = false;
+    for (let f = 0; f < files.length; f++) {
+      const prev = this.files[f];
+      if (files[f] === prev) {
+        addedRuns.push([]);
+        continue;
+      }
+      // Timestamps of buffered logs are backfilled when the first real one
+      // arrives - their order changed, so the timeline can't be reused
+      if (prev.length > 0 && prev.at(prev.length - 1)?.timestamp !== this.lastTimestamps[f]) {
+        return this.rebuild(files);
+      }
+      const change = appendedSince(prev, files[f]);
+      if (!change) return this.rebuild(files);
+      for (const log of change.evicted) evicted.add(log);
+      addedRuns.push(timelineRun(change.added));
+      changed = true;
+    }
+    this.remember(files);
+    if (!changed) return this.merged;
+
+    let merged = this.merged;
+    let fileOf = this.fileOf;
+    if (evicted.size > 0) {
+      const keptLogs: LogEntry[] = [];
+      const keptFiles = new Uint32Array(merged.length - evicted.size);
+      for (let i = 0; i < merged.length; i++) {
+        if (evicted.has(merged[i])) continue;
+        keptFiles[keptLogs.length] = fileOf[i];
+        keptLogs.push(merged[i]);
+      }
+      merged = keptLogs;
+      fileOf = keptFiles;
+    }
+
+    const added = mergeRuns(addedRuns);
+    const last = merged.length - 1;
+    const atEnd =
+      last < 0 ||
+      added.logs.length === 0 ||
+      compareOrdered(merged[last], fileOf[last], added.logs[0], added.runOf[0]) <= 0;
+
+    if (atEnd) {
+      // Common case (tailing): everything new is newer than the timeline
+      this.merged = merged.concat(added.logs);
+      this.fileOf = concatIndices(fileOf, added.runOf);
+    } else {
+      this.mergeIn(merged, fileOf, added.logs, added.runOf);
+    }
+    return this.merged;
+  }
+
+  private rebuild(files: LogList[]): LogEntry[] {
+    const { logs, runOf } = mergeRuns(files.map((list) => timelineRun(list.toArray())));
+    this.remember(files);
+    this.merged = logs;
+    this.fileOf = runOf;
+    return logs;
+  }
+
+  private remember(files: LogList[]): void {
+    this.files = files.slice();
+    this.lastTimestamps = files.map((logs) => logs.at(logs.length - 1)?.timestamp);
+  }
+
+  /**
+   * Two-way merge of the timeline with new logs (earlier entries win ties,
+   * as they come first in their file)
+   */
+  private mergeIn(
+    logs: LogEntry[],
+    files: Uint32Array,
+    added: LogEntry[],
+    addedFiles: Uint32Array,
+  ): void {
+    const merged: LogEntry[] = new Array(logs.length + added.length);
+    const fileOf = new Uint32Array(merged.length);
+    let i = 0;
+    let j = 0;
+    for (let out = 0; out < merged.length; out++) {
+      const takeOld =
+        j >= added.length ||
+        (i < logs.length && compareOrdered(logs[i], files[i], added[j], addedFiles[j]) <= 0);
+      if (takeOld) {
+        merged[out] = logs[i];
+        fileOf[out] = files[i++];
+      } else {
+        merged[out] = added[j];
+        fileOf[out] = addedFiles[j++];
+      }
+    }
+    this.merged = merged;
+    this.fileOf = fileOf;
+  }
+}
+
+/**
+ * Timeline order including the file tie-break
+ */
+function compareOrdered(a: LogEntry, aFile: number, b: LogEntry, bFile: number): number {
+  return compareTimeline(a, b) || aFile - bFile;
+}
+
+function concatIndices(a: Uint32Array, b: Uint32Array): Uint32Array {
+  const out = new Uint32Array(a.length + b.length);
+  out.set(a);
+  out.set(b, a.length);
+  return out;
+}
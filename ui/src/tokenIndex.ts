@@ -0,0 +1,242 @@
+/**
+ * Mocha Log Viewer - Inverted Token Index
+ *
+ * Maps each word of a file's logs (lowercased data + parsed content, as
+ * text filters see them) to the ascending ids of the rows containing it.
+ * Plain-text filters then resolve through posting-list intersection and a
+ * substring check of the few candidates, instead of scanning every row.
+ *
+ * A filter value's inner words must be whole words of a matching row; its
+ * first and last words may be parts of longer words, so they match against
+ * the vocabulary (ends with / starts with / contains). Values without
+ * words, and regex filters, are left to the normal scan.
+ *
+ * Each index has a postings budget; past it the index drops its data and
+ * answers nothing (filters scan as before). stats() reports the usage.
+ */
+
+import type { LogEntry } from "./types";
+import { buildSearchText, type ListTextIndex } from "./filters";
+import { mergeRuns, timelineRun } from "./timeline";
+
+/** Postings (row/word pairs) an index may hold before it gives up */
+export const MAX_INDEX_POSTINGS = 4_000_000;
+
+const WORD = /[\p{L}\p{N}_]+/gu;
+
+/**
+ * Memory use of a token index (bytes are an estimate)
+ */
+export interface TokenIndexStats {
+  rows: number; // Indexed rows still in the buffer
+  tokens: number; // Distinct words
+  postings: number; // Row/word pairs
+  bytes: number;
+  overBudget: boolean; // Index dropped, filters scan
+}
+
+interface QueryWord {
+  word: string;
+  partialStart: boolean; // May be the end of a longer word
+  partialEnd: boolean; // May be the start of a longer word
+}
+
+function queryWords(needle: string): QueryWord[] {
+  const words: QueryWord[] = [];
+  for (const match of needle.matchAll(WORD)) {
+    const start = match.index ?? 0;
+    words.push({
+      word: match[0],
+      partialStart: start === 0,
+      partialEnd: start + match[0].length === needle.length,
+    });
+  }
+  return words;
+}
+
+/**
+ * Ids in both ascending lists
+ */
+function intersect(a: number[], b: number[]): number[] {
+  const out: number[] = [];
+  let i = 0;
+  let j = 0;
+  while (i < a.length && j < b.length) {
+    if (a[i] < b[j]) i++;
+    else if (a[i] > b[j]) j++;
+    else {
+      out.push(a[i]);
+      i++;
+      j++;
+    }
+  }
+  return out;
+}
+
+/**
+ * Ascending, deduplicated union of lists of ids
+ */
+function union(lists: number[][]): number[] {
+  if (lists.length === 1) return lists[0];
+  const ids = lists.flat().sort((a, b) => a - b);
+  return ids.filter((id, i) => i === 0 || id !== ids[i - 1]);
+}
+
+/**
+ * Token index of one file's buffered logs. Rows are added in file order
+ * and evicted from the front, like the buffer holding them.
+ */
+export class TokenIndex {
+  private postings = new Map<string, number[]>();
+  private rows: (LogEntry | undefined)[] = []; // By id; evicted rows are cleared
+  private firstLive = 0; // Ids below this were evicted
+  private postingCount = 0;
+  private overBudget = false;
+  private maxPostings: number;
+
+  constructor(maxPostings: number = MAX_INDEX_POSTINGS) {
+    this.maxPostings = maxPostings;
+  }
+
+  /**
+   * Index logs appended after the current rows
+   */
+  add(logs: LogEntry[]): void {
+    if (this.overBudget) return;
+    for (const log of logs) {
+      const id = this.rows.length;
+      this.rows.push(log);
+      const words = new Set(buildSearchText(log).match(WORD));
+      for (const word of words) {
+        let list = this.postings.get(word);
+        if (!list) {
+          list = [];
+          this.postings.set(word, list);
+        }
+        list.push(id);
+      }
+      this.postingCount += words.size;
+    }
+
+    if (this.postingCount > this.maxPostings) {
+      console.warn(
+        `Token index over budget (${this.postingCount.toLocaleString()} postings) - filtering this file by scanning`,
+      );
+      this.overBudget = true;
+      this.postings = new Map();
+      this.rows = [];
+      this.firstLive = 0;
+      this.postingCount = 0;
+    }
+  }
+
+  /**
+   * Forget the oldest rows (evicted from the buffer). Postings of evicted
+   * rows are dropped once they make up half of the index.
+   */
+  evictOldest(count: number): void {
+    if (this.overBudget || count <= 0) return;
+    const end = Math.min(this.rows.length, this.firstLive + count);
+    for (let id = this.firstLive; id < end; id++) this.rows[id] = undefined;
+    this.firstLive = end;
+    if (this.firstLive > 1024 && this.firstLive * 2 > this.rows.length) {
+      const live = this.rows.slice(this.firstLive) as LogEntry[];
+      this.postings = new Map();
+      this.rows = [];
+      this.firstLive = 0;
+      this.postingCount = 0;
+      this.add(live);
+    }
+  }
+
+  /**
+   * Rows containing any of the values (case-insensitive), in file order, or
+   * null if the index can't resolve some value
+   */
+  rowsContainingAny(values: string[]): LogEntry[] | null {
+    if (this.overBudget) return null;
+    const lists: number[][] = [];
+    for (const value of values) {
+      const ids = this.idsContaining(value.toLowerCase());
+      if (!ids) return null;
+      lists.push(ids);
+    }
+
+    const rows: LogEntry[] = [];
+    for (const id of union(lists)) {
+      const log = this.rows[id];
+      if (log) rows.push(log);
+    }
+    return rows;
+  }
+
+  stats(): TokenIndexStats {
+    let tokenBytes = 0;
+    for (const word of this.postings.keys()) tokenBytes += 64 + word.length * 2;
+    return {
+      rows: this.rows.length - this.firstLive,
+      tokens: this.postings.size,
+      postings: this.postingCount,
+      bytes: tokenBytes + this.postingCount * 4 + this.rows.length * 4,
+      overBudget: this.overBudget,
+    };
+  }
+
+  /**
+   * Ids of the rows whose search text contains the (lowercased) needle
+   */
+  private idsContaining(needle: string): number[] | null {
+    const words = queryWords(needle);
+    if (words.length === 0) return null;
+
+    // Whole words narrow the most; partial ones need a vocabulary pass
+    const whole = words.filter((w) => !w.partialStart && !w.partialEnd);
+    const terms = whole.length > 0 ? whole : words;
+    let ids: number[] | null = null;
+    for (const term of terms) {
+      const list = this.postingsFor(term);
+      ids = ids ? intersect(ids, list) : list;
+      if (ids.length === 0) return ids;
+    }
+
+    // Candidates contain the words - check the actual substring
+    return (ids ?? []).filter((id) => {
+      const log = this.rows[id];
+      return log !== undefined && buildSearchText(log).includes(needle);
+    });
+  }
+
+  private postingsFor({ word, partialStart, partialEnd }: QueryWord): number[] {
+    if (!partialStart && !partialEnd) return this.postings.get(word) ?? [];
+
+    const lists: number[][] = [];
+    this.postings.forEach((list, token) => {
+      const matches =
+        partialStart && partialEnd
+          ? token.includes(word)
+          : partialStart
+            ? token.endsWith(word)
+            : token.startsWith(word);
+      if (matches) lists.push(list);
+    });
+    return lists.length > 0 ? union(lists) : [];
+  }
+}
+
+/**
+ * Text index of a timeline merged from files, one token index per file (in
+ * the timeline's file order). Matches come back in timeline order.
+ */
+export function timelineTextIndex(indexes: TokenIndex[]): ListTextIndex {
+  return {
+    containingAny(values: string[]): LogEntry[] | null {
+      const runs: LogEntry[][] = [];
+      for (const index of indexes) {
+        const rows = index.rowsContainingAny(values);
+        if (!rows) return null;
+        runs.push(timelineRun(rows));
+      }
+      return mergeRuns(runs).logs;
+    },
+  };
+}
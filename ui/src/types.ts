@@ -5,6 +5,8 @@
  * file handling, and UI state management.
  */
 
+import type { LogList } from "./logBuffer";
+
 // ============================================================================
 // Log Entry Types
 // ============================================================================
@@ -106,6 +108,15 @@ export interface ParsedLogFileResult {
   truncated: boolean;
 }
 
+/**
+ * Hit/miss counters for one log format pattern
+ */
+export interface PatternStats {
+  name: string; // Pattern name (e.g. "logback-with-thread")
+  hits: number; // Lines the pattern matched
+  misses: number; // Lines the pattern was tried on and failed
+}
+
 // ============================================================================
 // File Types
 // ============================================================================
@@ -125,9 +136,19 @@ export interface OpenedFile {
  * All opened files are shown in the merged view (no inactive state).
  */
 export interface OpenedFileWithLogs extends OpenedFile {
-  logs: LogEntry[]; // Parsed log entries from this file
+  logs: LogList; // Parsed log entries from this file (see logBuffer.ts)
   lastModified: number; // For polling - last known file size
   mtime?: number; // File modification time (Unix millis)
+  firstLine?: number; // File line of the oldest loaded line (0 = loaded from the start, undefined = unknown)
+  source?: string; // Directory/glob source the file was opened from
+  inMemory?: boolean; // Read from a browser file input, not through the backend (no path on disk)
+}
+
+/**
+ * A file to open, with its freshly parsed logs
+ */
+export interface NewOpenedFile extends Omit<OpenedFileWithLogs, "logs"> {
+  logs: LogEntry[];
 }
 
 /**
@@ -157,6 +178,95 @@ export interface FileResult {
   error?: string; // Error message if failed
 }
 
+/**
+ * New content of one file in a "files-appended" event
+ */
+export interface FileAppendedEvent {
+  path: string; // Full file path (as passed to watchFiles, or as found in a source)
+  source?: string; // With created: the source (as passed to watchSource) the file is new to
+  logs: LogEntry[]; // Entries parsed from the new content since the previous offset
+  size: number; // Current file size in bytes (next offset)
+  prevSize: number; // Offset the content was read from
+  mtime?: number; // File modification time (Unix millis)
+  truncated: boolean; // True if file was truncated/replaced (logs cover the whole file)
+  rotated: boolean; // Logs continue from a rotated/rewritten file (append them; size is the new file's)
+  created: boolean; // File started matching a source - logs are its initial read
+  backendMs: number; // Time the backend spent reading and parsing
+}
+
+/**
+ * Payload of the "files-appended" event pushed by the backend file watcher
+ * (one per flush, covering every file that changed)
+ */
+export interface FilesAppendedEvent {
+  files: FileAppendedEvent[];
+  emittedAt: number; // When the backend sent the event (Unix millis)
+}
+
+/**
+ * Result from watchSource Tauri command
+ */
+export interface SourceResult {
+  success: boolean;
+  files?: string[]; // Files matching now, sorted
+  error?: string;
+}
+
+/**
+ * Result from parseFile Tauri command (readFile + parsing done in the backend)
+ */
+export interface ParseFileResult {
+  success: boolean;
+  logs?: LogEntry[]; // Parsed entries (last 2000 lines)
+  totalLines?: number; // Total lines in the content that was read
+  startLine?: number; // File line number of the first parsed line (initial reads only)
+  fileLines?: number; // Total lines in the file (initial reads only)
+  path?: string; // Full file path
+  name?: string; // Filename only
+  size?: number; // Current file size in bytes
+  prevSize?: number; // Offset that was passed in
+  mtime?: number; // File modification time (Unix millis)
+  truncated?: boolean; // True if file was truncated/replaced (or only the tail was read)
+  rotated?: boolean; // Differential reads: logs continue from a rotated/rewritten file
+  backendMs?: number; // Time the backend spent reading and parsing
+  error?: string; // Error message if failed
+}
+
+/**
+ * Result from exportTrace Tauri command (diagnostics spans written to the app log)
+ */
+export interface ExportTraceResult {
+  success: boolean;
+  events?: number; // Trace events written
+  logDir?: string; // Directory of the app log file
+  error?: string; // Error message if failed
+}
+
+/**
+ * Result from parseLines Tauri command (a page of parsed lines)
+ */
+export interface ParseLinesResult {
+  success: boolean;
+  logs?: LogEntry[]; // Parsed entries of the page
+  startLine?: number; // First line of the page (clamped to the file)
+  lineCount?: number; // Number of lines in the page
+  totalLines?: number; // Total lines in the file
+  error?: string;
+}
+
+/**
+ * Result from readTimeRange Tauri command (the lines of a time range)
+ */
+export interface TimeRangeResult {
+  success: boolean;
+  logs?: LogEntry[]; // Parsed entries of the range (empty if nothing was logged in it)
+  startLine?: number; // First line of the range
+  lineCount?: number; // Number of lines read
+  totalLines?: number; // Total lines in the file
+  truncated?: boolean; // The range has more than 2000 lines (the first ones are returned)
+  error?: string;
+}
+
 /**
  * Result from searchFileForLine Tauri command
  * Used for "jump to source" when log is outside truncated view
@@ -165,10 +275,48 @@ export interface SearchLineResult {
   success: boolean;
   content?: string; // Context lines around the found line
   lineNumber?: number; // 1-indexed line number where match was found
+  startLine?: number; // 0-indexed line number of the first context line
   totalLines?: number; // Total lines in the file
   error?: string; // Error message if failed
 }
 
+/**
+ * A matching line found by searchFile
+ */
+export interface SearchMatch {
+  lineNumber: number; // 1-indexed line number
+  offset: number; // Byte offset of the match
+  snippet: string; // The matching line (cut around the match if long)
+}
+
+/**
+ * Batch of searchFile matches (search-matches event, in file order)
+ */
+export interface SearchMatchesEvent {
+  searchId: string;
+  path: string;
+  matches: SearchMatch[];
+}
+
+/**
+ * Result from searchFile Tauri command (once the whole file is scanned)
+ */
+export interface SearchFileResult {
+  success: boolean;
+  matchCount?: number; // Matching lines (all were sent as events)
+  truncated?: boolean; // Stopped at the match limit
+  error?: string;
+}
+
+/**
+ * Progress of a long-running file search (search-progress event)
+ */
+export interface SearchProgressEvent {
+  searchId: string;
+  scanned: number; // Bytes scanned so far
+  total: number; // File size in bytes
+}
+
 // ============================================================================
 // Filter Types
 // ============================================================================
@@ -187,6 +335,98 @@ export interface ParsedFilter {
   text: string; // Display text for the filter chip
 }
 
+// ============================================================================
+// Logbook Store Types (~/.mocha/logbooks)
+// ============================================================================
+
+/**
+ * Logbook metadata as stored on disk (everything but the entries)
+ */
+export interface LogbookMeta {
+  id: string;
+  name: string;
+  createdAt: number;
+  patterns: ParsedFilter[];
+  manuallyAddedHashes: string[];
+  minimizedHashes: string[];
+}
+
+/**
+ * Stored logbook listed at startup - entries are loaded on demand
+ */
+export interface LogbookSummary extends LogbookMeta {
+  hashes: string[]; // Hashes of the stored entries, in order
+}
+
+/**
+ * Result from loadLogbooks Tauri command
+ */
+export interface LoadLogbooksResult {
+  success: boolean;
+  logbooks?: LogbookSummary[];
+  initialized: boolean; // False until logbooks were first written to disk
+  error?: string;
+}
+
+/**
+ * Result from loadLogbookEntries Tauri command
+ */
+export interface LogbookEntriesResult {
+  success: boolean;
+  entries?: LogEntry[];
+  error?: string;
+}
+
+/**
+ * One write to the logbook store (a batch is applied in order)
+ */
+export type LogbookOp =
+  | { op: "putMeta"; meta: LogbookMeta }
+  | { op: "delete"; id: string }
+  | { op: "add"; id: string; entries: LogEntry[] }
+  | { op: "remove"; id: string; hashes: string[] }
+  | { op: "order"; id: string; hashes: string[] } // Hashes in their new order
+  | { op: "replace"; id: string; entries: LogEntry[] };
+
+// ============================================================================
+// Log Worker Messages (browser mode)
+// ============================================================================
+
+/**
+ * Messages to the log worker. Passes (parse/filter/search) carry an id that
+ * the response echoes; "cancel" stops an in-flight pass.
+ */
+export type LogWorkerRequest =
+  | { type: "parse"; id: number; fileKey: string; name: string; buffer: ArrayBuffer }
+  | {
+      type: "filter";
+      id: number;
+      fileKeys: string[];
+      filters: ParsedFilter[];
+      inactiveNames: string[];
+    }
+  | { type: "search"; id: number; filterId: number; query: string; isRegex: boolean }
+  | { type: "cancel"; id: number }
+  | { type: "drop"; fileKey: string };
+
+/**
+ * Messages from the log worker
+ */
+export type LogWorkerResponse =
+  | { type: "parsed"; id: number; result: ParsedLogFileResult; size: number }
+  | {
+      type: "filtered";
+      id: number;
+      // Filtered rows oldest first: file (index into fileKeys) and row in that file
+      files: Uint32Array;
+      rows: Uint32Array;
+      totals: number[]; // Rows held per file
+      missing: boolean; // Some file was not parsed by the worker
+    }
+  | { type: "searched"; id: number; matches: Uint32Array } // Positions in the filtered rows
+  | { type: "cancelled"; id: number }
+  | { type: "error"; id: number; error: string };
+
 // ============================================================================
 // Theme Types
 // ============================================================================
@@ -214,7 +454,13 @@ export interface ThemeInfo {
  */
 export interface SettingsState {
   theme: ThemeName;
+  maxLogsPerFile: number; // Cap of each file's log buffer (oldest logs are dropped)
+  indexLogText: boolean; // Keep a token index per file for text filters (files opened later)
+  loadThreads: number; // Threads the backend indexes and parses large files with (0 = one per core)
   setTheme: (theme: ThemeName) => void;
+  setMaxLogsPerFile: (maxLogsPerFile: number) => void;
+  setIndexLogText: (indexLogText: boolean) => void;
+  setLoadThreads: (loadThreads: number) => void;
 }
 
 // ============================================================================
@@ -251,6 +497,9 @@ export interface Story {
   manuallyAddedHashes: string[]; // Hashes of logs added manually (not via auto-capture)
   patterns: ParsedFilter[]; // Auto-capture patterns (text + regex)
   minimizedHashes: string[]; // Hashes hidden by user (stay in entries to prevent re-capture, but hidden from view)
+  // Hashes of entries still on disk (not loaded yet); entries then only holds
+  // ones captured since. Undefined once loaded (see logbookStore.ts)
+  storedHashes?: string[];
 }
 
 /**
@@ -279,7 +528,7 @@ export interface StoryState {
   // Log management (operates on active story) - now takes full LogEntry
   addToStory: (log: LogEntry) => void;
   addLogsToStory: (logs: LogEntry[], storyId: string) => void; // Batch add
-  addLogsToMatchingStories: (logs: LogEntry[]) => void; // Auto-capture to all matching stories
+  addLogsToMatchingStories: (logs: Iterable<LogEntry>) => void; // Auto-capture to all matching stories
   removeFromStory: (hash: string) => void;
   minimizeInStory: (hash: string) => void; // Hide entry but keep in entries to prevent re-capture
   restoreInStory: (hash: string) => void; // Un-minimize an entry
@@ -295,25 +544,42 @@ export interface StoryState {
   getActiveStoryHashes: () => string[];
 }
 
+/**
+ * One file's change in a batched store update (applyFileChanges)
+ */
+export interface FileChange {
+  path: string;
+  logs: LogEntry[]; // Logs to append (or the file's new logs if replace)
+  replace?: boolean; // Replace the file's logs (truncated/replaced file)
+  lastModified?: number; // Size read up to (offset of the next read)
+  mtime?: number;
+  resetFirstLine?: boolean; // Loaded logs are no longer file lines - stop paging
+}
+
 /**
  * File store state for opened files and recent files.
  * Supports multi-file viewing with interleaved logs.
  */
 export interface FileState {
   openedFiles: Map<string, OpenedFileWithLogs>; // path -> file data with logs
+  sources: string[]; // Open directory/glob sources (their files are in openedFiles)
   recentFiles: RecentFile[];
   isLoading: boolean;
   error: string | null;
 
   // Actions
-  openFile: (file: OpenedFileWithLogs) => void;
+  openFile: (file: NewOpenedFile) => void;
   closeFile: (path: string) => void;
   updateFileLogs: (path: string, logs: LogEntry[]) => void;
   appendFileLogs: (path: string, newLogs: LogEntry[], newSize?: number) => void;
+  applyFileChanges: (changes: FileChange[]) => void;
+  prependFileLogs: (path: string, olderLogs: LogEntry[], firstLine: number) => void;
   setRecentFiles: (files: RecentFile[]) => void;
   addRecentFile: (file: RecentFile) => void;
   removeRecentFile: (path: string) => void;
   clearOpenedFiles: () => void;
+  addSource: (spec: string) => void;
+  removeSource: (spec: string) => void;
   setLoading: (loading: boolean) => void;
   setError: (error: string | null) => void;
   getOpenedFilePaths: () => string[];
@@ -337,6 +603,11 @@ export interface SidebarProps {
   onRemoveFile: (path: string) => void;
   onClearRecent: () => void;
 
+  // Directory/glob sources
+  sources: string[];
+  onOpenSource: (spec?: string) => void; // No spec: pick a directory
+  onCloseSource: (spec: string) => void;
+
   // Logbook management
   stories: Story[];
   activeStoryId: string | null;